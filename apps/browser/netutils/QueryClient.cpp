@@ -13,15 +13,18 @@ QueryClient::QueryClient()
 {
     peer = RakPeerInterface::GetInstance();
     pmq = new PacketMasterQuery(peer);
+    pmqd = new PacketMasterQueryDelta(peer);
     pmu = new PacketMasterUpdate(peer);
     RakNet::SocketDescriptor sd;
     peer->Startup(8, &sd, 1);
     status = -1;
+    knownRevision = 0;
 }
 
 QueryClient::~QueryClient()
 {
     delete pmq;
+    delete pmqd;
     delete pmu;
     RakPeerInterface::DestroyInstance(peer);
 }
@@ -44,6 +47,16 @@ map<SystemAddress, QueryData> QueryClient::Query()
     bs.Write((unsigned char) (ID_MASTER_QUERY));
     qDebug() << "Locking mutex in QueryClient::Query()";
     mxServers.lock();
+
+    if (RequestDelta())
+    {
+        query = knownServers;
+        status = ID_MASTER_QUERY;
+        qDebug() << "Unlocking mutex in QueryClient::Query()";
+        mxServers.unlock();
+        return query;
+    }
+
     status = -1;
     int attempts = 3;
     do
@@ -71,6 +84,11 @@ map<SystemAddress, QueryData> QueryClient::Query()
     while(status != ID_MASTER_QUERY && attempts-- > 0);
     if(status != ID_MASTER_QUERY)
         qDebug() << "Getting query was failed";
+    else
+    {
+        knownServers = query;
+        knownRevision = 0;
+    }
     qDebug() << "Unlocking mutex in QueryClient::Query()";
     peer->CloseConnection(masterAddr, true);
     mxServers.unlock();
@@ -79,6 +97,47 @@ map<SystemAddress, QueryData> QueryClient::Query()
     return query;
 }
 
+bool QueryClient::RequestDelta()
+{
+    BitStream bs;
+    bs.Write((unsigned char) (ID_MASTER_QUERY_DELTA));
+    bs.Write(knownRevision);
+
+    status = -1;
+    if (Connect() == IS_NOT_CONNECTED)
+        return false;
+
+    if (peer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_MASTER, masterAddr, false) == 0)
+        return false;
+
+    QueryDelta delta;
+    pmqd->SetDelta(&delta);
+    status = GetAnswer(ID_MASTER_QUERY_DELTA);
+    peer->CloseConnection(masterAddr, true);
+
+    // Master servers without delta support drop the connection, the caller falls back to a full query
+    if (status != ID_MASTER_QUERY_DELTA)
+    {
+        qDebug() << "Getting query delta was failed";
+        return false;
+    }
+
+    if (delta.reset)
+        knownServers.clear();
+
+    for (const auto &removed : delta.removed)
+        knownServers.erase(removed);
+
+    for (auto &&changed : delta.changed)
+        knownServers[changed.first] = move(changed.second);
+
+    qDebug() << "Got" << delta.changed.size() << "changed and" << delta.removed.size() << "removed servers,"
+             << (delta.reset ? "full list" : "delta");
+
+    knownRevision = delta.revision;
+    return true;
+}
+
 pair<SystemAddress, QueryData> QueryClient::Update(const RakNet::SystemAddress &addr)
 {
     qDebug() << "Locking mutex in QueryClient::Update(RakNet::SystemAddress addr)";
@@ -126,6 +185,7 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
         {
             BitStream data(packet->data, packet->length, false);
             pmq->SetReadStream(&data);
+            pmqd->SetReadStream(&data);
             pmu->SetReadStream(&data);
             data.Read(pid);
             switch(pid)
@@ -145,6 +205,15 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
                     update = false;
                     id = pid;
                     break;
+                case ID_MASTER_QUERY_DELTA:
+                    qDebug() << "ID_MASTER_QUERY_DELTA";
+                    if (waitingPacket == ID_MASTER_QUERY_DELTA)
+                        pmqd->Read();
+                    else
+                        qDebug() << "Got wrong packet";
+                    update = false;
+                    id = pid;
+                    break;
                 case ID_MASTER_UPDATE:
                     qDebug() << "ID_MASTER_UPDATE";
                     if (waitingPacket == ID_MASTER_UPDATE)
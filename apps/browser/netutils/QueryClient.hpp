@@ -4,6 +4,7 @@
 #include <string>
 #include <RakPeerInterface.h>
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
+#include <components/openmw-mp/Master/PacketMasterQueryDelta.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
 #include <apps/browser/ServerModel.hpp>
 #include <mutex>
@@ -24,6 +25,7 @@ public:
 private:
     RakNet::ConnectionState Connect();
     MASTER_PACKETS GetAnswer(MASTER_PACKETS packet);
+    bool RequestDelta();
 protected:
     QueryClient();
     ~QueryClient();
@@ -32,7 +34,10 @@ private:
     RakNet::RakPeerInterface *peer;
     RakNet::SystemAddress masterAddr;
     mwmp::PacketMasterQuery *pmq;
+    mwmp::PacketMasterQueryDelta *pmqd;
     mwmp::PacketMasterUpdate *pmu;
+    std::map<RakNet::SystemAddress, QueryData> knownServers;
+    uint32_t knownRevision;
     std::pair<RakNet::SystemAddress, ServerData> server;
     std::mutex mxServers;
 
@@ -1,3 +1,5 @@
+#include <chrono>
+#include <functional>
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -7,6 +9,8 @@
 #include <boost/filesystem/fstream.hpp>
 
 #include <components/bsa/bsa_file.hpp>
+#include <components/vfs/bsaarchive.hpp>
+#include <components/vfs/manager.hpp>
 
 #define BSATOOL_VERSION 1.1
 
@@ -23,6 +27,8 @@ struct Arguments
 
     bool longformat;
     bool fullpath;
+
+    unsigned int passes;
 };
 
 void replaceAll(std::string& str, const std::string& needle, const std::string& substitute)
@@ -45,6 +51,9 @@ bool parseOptions (int argc, char** argv, Arguments &info)
             "      Extract a file from the input archive.\n\n"
             "  bsatool extractall archivefile [output_directory]\n"
             "      Extract all files from the input archive.\n\n"
+            "  bsatool bench archivefile [passes]\n"
+            "      Time opening and reading every file in the archive, through file streams, the memory mapped\n"
+            "      archive and the VFS.\n\n"
             "Allowed options");
 
     desc.add_options()
@@ -104,7 +113,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
     }
 
     info.mode = variables["mode"].as<std::string>();
-    if (!(info.mode == "list" || info.mode == "extract" || info.mode == "extractall"))
+    if (!(info.mode == "list" || info.mode == "extract" || info.mode == "extractall" || info.mode == "bench"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"\n\n"
             << desc << std::endl;
@@ -121,8 +130,14 @@ bool parseOptions (int argc, char** argv, Arguments &info)
 
     // Default output to the working directory
     info.outdir = ".";
+    info.passes = 10;
 
-    if (info.mode == "extract")
+    if (info.mode == "bench")
+    {
+        if (variables["input-file"].as< std::vector<std::string> >().size() > 1)
+            info.passes = std::stoul(variables["input-file"].as< std::vector<std::string> >()[1]);
+    }
+    else if (info.mode == "extract")
     {
         if (variables["input-file"].as< std::vector<std::string> >().size() < 2)
         {
@@ -147,6 +162,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
 int list(Bsa::BSAFile& bsa, Arguments& info);
 int extract(Bsa::BSAFile& bsa, Arguments& info);
 int extractAll(Bsa::BSAFile& bsa, Arguments& info);
+int bench(Bsa::BSAFile& bsa, Arguments& info);
 
 int main(int argc, char** argv)
 {
@@ -166,6 +182,8 @@ int main(int argc, char** argv)
             return extract(bsa, info);
         else if (info.mode == "extractall")
             return extractAll(bsa, info);
+        else if (info.mode == "bench")
+            return bench(bsa, info);
         else
         {
             std::cout << "Unsupported mode. That is not supposed to happen." << std::endl;
@@ -289,3 +307,58 @@ int extractAll(Bsa::BSAFile& bsa, Arguments& info)
 
     return 0;
 }
+
+int bench(Bsa::BSAFile& bsa, Arguments& info)
+{
+    const Bsa::BSAFile::FileList &files = bsa.getList();
+
+    VFS::Manager vfs(false);
+    vfs.addArchive(new VFS::BsaArchive(info.filename));
+    vfs.buildIndex();
+
+    std::vector<char> buffer(64 * 1024);
+    size_t bytes = 0;
+
+    auto readAll = [&] (std::istream& stream)
+    {
+        while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0)
+            bytes += stream.gcount();
+    };
+
+    auto time = [&] (const char* name, const std::function<void (const Bsa::BSAFile::FileStruct&)>& openAndRead)
+    {
+        bytes = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int pass = 0; pass < info.passes; ++pass)
+        {
+            for (const Bsa::BSAFile::FileStruct& file : files)
+                openAndRead(file);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t opened = files.size() * info.passes;
+        std::cout << std::setw(16) << std::left << name << opened << " files in " << seconds << " s: "
+                  << opened / seconds << " files/s, " << bytes / seconds / (1024 * 1024) << " MB/s" << std::endl;
+    };
+
+    std::cout << "Reading " << files.size() << " files " << info.passes << " times"
+              << (bsa.isMapped() ? "" : " (the archive could not be memory mapped)") << std::endl;
+
+    time("File streams", [&] (const Bsa::BSAFile::FileStruct& file)
+    {
+        readAll(*Files::openConstrainedFileStream(info.filename.c_str(), file.offset, file.fileSize));
+    });
+
+    time("Archive", [&] (const Bsa::BSAFile::FileStruct& file)
+    {
+        readAll(*bsa.getFile(&file));
+    });
+
+    time("VFS", [&] (const Bsa::BSAFile::FileStruct& file)
+    {
+        readAll(*vfs.get(file.name));
+    });
+
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <iostream>
 #include <vector>
 #include <deque>
@@ -12,6 +13,7 @@
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/records.hpp>
+#include <components/files/constrainedfilestream.hpp>
 
 #include "record.hpp"
 
@@ -55,11 +57,13 @@ struct Arguments
     bool quiet_given;
     bool loadcells_given;
     bool plain_given;
+    bool stream_given;
 
     std::string mode;
     std::string encoding;
     std::string filename;
     std::string outname;
+    std::vector<std::string> filenames;
 
     std::vector<std::string> types;
     std::string name;
@@ -71,7 +75,7 @@ struct Arguments
 
 bool parseOptions (int argc, char** argv, Arguments &info)
 {
-    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n\nAllowed options");
+    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n  bench\t Times loading all records and references of the given files, streamed and memory mapped.\n\nAllowed options");
 
     desc.add_options()
         ("help,h", "print help message.")
@@ -89,6 +93,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
          "Only affects dump mode.")
         ("quiet,q", "Supress all record information. Useful for speed tests.")
         ("loadcells,C", "Browse through contents of all cells.")
+        ("stream,s", "Read files as streams instead of memory mapping them.")
 
         ( "encoding,e", bpo::value<std::string>(&(info.encoding))->
           default_value("win1252"),
@@ -109,7 +114,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         ;
 
     bpo::positional_options_description p;
-    p.add("mode", 1).add("input-file", 2);
+    p.add("mode", 1).add("input-file", -1);
 
     // there might be a better way to do this
     bpo::options_description all;
@@ -154,7 +159,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         info.name = variables["name"].as<std::string>();
 
     info.mode = variables["mode"].as<std::string>();
-    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp"))
+    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp" || info.mode == "bench"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"" << std::endl << std::endl
                   << desc << finalText << std::endl;
@@ -176,7 +181,8 @@ bool parseOptions (int argc, char** argv, Arguments &info)
       return false;
       }*/
 
-    info.filename = variables["input-file"].as< std::vector<std::string> >()[0];
+    info.filenames = variables["input-file"].as< std::vector<std::string> >();
+    info.filename = info.filenames[0];
     if (variables["input-file"].as< std::vector<std::string> >().size() > 1)
         info.outname = variables["input-file"].as< std::vector<std::string> >()[1];
 
@@ -184,6 +190,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
     info.quiet_given = variables.count ("quiet") != 0;
     info.loadcells_given = variables.count ("loadcells") != 0;
     info.plain_given = variables.count("plain") != 0;
+    info.stream_given = variables.count("stream") != 0;
 
     // Font encoding settings
     info.encoding = variables["encoding"].as<std::string>();
@@ -203,6 +210,7 @@ void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info);
 int load(Arguments& info);
 int clone(Arguments& info);
 int comp(Arguments& info);
+int bench(Arguments& info);
 
 int main(int argc, char**argv)
 {
@@ -218,6 +226,8 @@ int main(int argc, char**argv)
             return clone(info);
         else if (info.mode == "comp")
             return comp(info);
+        else if (info.mode == "bench")
+            return bench(info);
         else
         {
             std::cout << "Invalid or no mode specified, dying horribly. Have a nice day." << std::endl;
@@ -322,7 +332,10 @@ int load(Arguments& info)
         bool loadCells = (info.loadcells_given || info.mode == "clone");
         bool save = (info.mode == "clone");
 
-        esm.open(filename);
+        if (info.stream_given)
+            esm.open(Files::openConstrainedFileStream(filename.c_str()), filename);
+        else
+            esm.open(filename);
 
         info.data.author = esm.getAuthor();
         info.data.description = esm.getDesc();
@@ -551,3 +564,32 @@ int comp(Arguments& info)
 
     return 0;
 }
+
+int bench(Arguments& info)
+{
+    // Load every file the way a load order would be, including all cell references
+    info.quiet_given = true;
+    info.loadcells_given = true;
+
+    for (bool stream : {true, false})
+    {
+        info.stream_given = stream;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (const std::string& filename : info.filenames)
+        {
+            info.filename = filename;
+            if (load(info) != 0)
+            {
+                std::cout << "Failed to load " << filename << ", aborting benchmark." << std::endl;
+                return 1;
+            }
+        }
+
+        std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+        std::cout << (stream ? "Streamed" : "Memory mapped") << ": " << duration.count() << " ms" << std::endl;
+    }
+
+    return 0;
+}
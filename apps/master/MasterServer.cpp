@@ -5,6 +5,7 @@
 #include "MasterServer.hpp"
 
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
+#include <components/openmw-mp/Master/PacketMasterQueryDelta.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
 #include <components/openmw-mp/Master/PacketMasterAnnounce.hpp>
 #include <components/openmw-mp/Version.hpp>
@@ -23,6 +24,11 @@ MasterServer::MasterServer(unsigned short maxConnections, unsigned short port)
     peer->SetMaximumIncomingConnections(maxConnections);
     peer->SetIncomingPassword(TES3MP_MASTERSERVER_PASSW, (int) strlen(TES3MP_MASTERSERVER_PASSW));
     run = false;
+
+    // Start counting from the current time, so revisions known to clients from a previous run of the
+    // master server are always treated as outdated
+    revision = oldestRevision = static_cast<uint32_t>(chrono::duration_cast<chrono::seconds>(
+            chrono::system_clock::now().time_since_epoch()).count());
 }
 
 MasterServer::~MasterServer()
@@ -32,6 +38,26 @@ MasterServer::~MasterServer()
 
 using namespace chrono;
 
+void MasterServer::RemoveServer(ServerIter it)
+{
+    removedServers[it->first] = {++revision, steady_clock::now()};
+    servers.erase(it);
+}
+
+void MasterServer::PruneRemovedServers(steady_clock::time_point now)
+{
+    for (auto it = removedServers.begin(); it != removedServers.end();)
+    {
+        if (now - it->second.time >= 10min)
+        {
+            oldestRevision = max(oldestRevision, it->second.revision);
+            it = removedServers.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
 void MasterServer::Thread()
 {
     unsigned char packetId = 0;
@@ -42,6 +68,9 @@ void MasterServer::Thread()
     PacketMasterQuery pmq(peer);
     pmq.SetSendStream(&send);
 
+    PacketMasterQueryDelta pmqd(peer);
+    pmqd.SetSendStream(&send);
+
     PacketMasterUpdate pmu(peer);
     pmu.SetSendStream(&send);
 
@@ -60,9 +89,10 @@ void MasterServer::Thread()
             {
 
                 if (it->second.lastUpdate + 60s <= now)
-                    servers.erase(it++);
+                    RemoveServer(it++);
                 else ++it;
             }
+            PruneRemovedServers(now);
             for(auto id = pendingACKs.begin(); id != pendingACKs.end();)
             {
                 if(now - id->second >= 30s)
@@ -104,6 +134,40 @@ void MasterServer::Thread()
                              << packet->systemAddress.ToString() << endl;
                         break;
                     }
+                    case ID_MASTER_QUERY_DELTA:
+                    {
+                        uint32_t knownRevision = 0;
+                        data.Read(knownRevision);
+
+                        QueryDelta delta;
+                        delta.revision = revision;
+                        delta.reset = knownRevision < oldestRevision || knownRevision > revision;
+
+                        for (const auto &server : servers)
+                        {
+                            // Servers added through the REST API have no revision, so always send them
+                            if (delta.reset || server.second.revision == 0 || server.second.revision > knownRevision)
+                                delta.changed.emplace_back(server.first, static_cast<const QueryData &>(server.second));
+                        }
+
+                        if (!delta.reset)
+                        {
+                            for (const auto &removed : removedServers)
+                            {
+                                if (removed.second.revision > knownRevision)
+                                    delta.removed.push_back(removed.first);
+                            }
+                        }
+
+                        pmqd.SetDelta(&delta);
+                        pmqd.Send(packet->systemAddress);
+                        pendingACKs[packet->guid] = steady_clock::now();
+
+                        cout << "Sent " << (delta.reset ? "full" : "delta") << " info about " << delta.changed.size()
+                             << " changed and " << delta.removed.size() << " removed servers to "
+                             << packet->systemAddress.ToString() << endl;
+                        break;
+                    }
                     case ID_MASTER_UPDATE:
                     {
                         SystemAddress addr;
@@ -141,7 +205,7 @@ void MasterServer::Thread()
                         {
                             if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_DELETE)
                             {
-                                servers.erase(iter);
+                                RemoveServer(iter);
                                 cout << "Deleted";
                                 pma.Send(packet->systemAddress);
                                 pendingACKs[packet->guid] = steady_clock::now();
@@ -149,7 +213,11 @@ void MasterServer::Thread()
                             else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_ANNOUNCE)
                             {
                                 cout << "Updated";
-                                iter->second = server;
+                                if (static_cast<const QueryData &>(iter->second) != server)
+                                {
+                                    iter->second = server;
+                                    iter->second.revision = ++revision;
+                                }
                                 keepAliveFunc();
                             }
                             else
@@ -161,7 +229,9 @@ void MasterServer::Thread()
                         else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_ANNOUNCE)
                         {
                             cout << "Added";
+                            server.revision = ++revision;
                             iter = servers.insert({packet->systemAddress, server}).first;
+                            removedServers.erase(packet->systemAddress);
                             keepAliveFunc();
                         }
                         else
@@ -20,6 +20,12 @@ public:
     struct SServer : QueryData
     {
         std::chrono::steady_clock::time_point lastUpdate;
+        uint32_t revision = 0; // revision of the server list at which this server was added or last changed
+    };
+    struct RemovedServer
+    {
+        uint32_t revision;
+        std::chrono::steady_clock::time_point time;
     };
     typedef std::map<RakNet::SystemAddress, SServer> ServerMap;
     //typedef ServerMap::const_iterator ServerCIter;
@@ -37,12 +43,18 @@ public:
 
 private:
     void Thread();
+    void RemoveServer(ServerIter it);
+    void PruneRemovedServers(std::chrono::steady_clock::time_point now);
 
 private:
     std::thread tMasterThread;
     RakNet::RakPeerInterface* peer;
     RakNet::SocketDescriptor sockdescr;
     ServerMap servers;
+    // Servers removed from the list are remembered for a while, so delta queries can report them
+    std::map<RakNet::SystemAddress, RemovedServer> removedServers;
+    uint32_t revision;
+    uint32_t oldestRevision; // delta queries for revisions older than this get the whole list
     bool run;
     std::map<RakNet::RakNetGUID, std::chrono::steady_clock::time_point> pendingACKs;
 };
@@ -0,0 +1,114 @@
+#include "generatetiles.hpp"
+#include "worldspacedata.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/detournavigator/debug.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/navmeshdiskcache.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace NavMeshTool
+{
+    GenerationStats& GenerationStats::operator+=(const GenerationStats& other)
+    {
+        mTiles += other.mTiles;
+        mGenerated += other.mGenerated;
+        mStored += other.mStored;
+        mEmpty += other.mEmpty;
+        mFailed += other.mFailed;
+        mDataSize += other.mDataSize;
+        mSeconds += other.mSeconds;
+        return *this;
+    }
+
+    GenerationStats generateTiles(WorldspaceData& data, const osg::Vec3f& agentHalfExtents,
+        const DetourNavigator::Settings& settings, DetourNavigator::NavMeshDiskCache& navMeshDiskCache,
+        std::size_t threadsCount)
+    {
+        using DetourNavigator::TilePosition;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<TilePosition> tiles;
+        data.mRecastMeshManager->forEachTilePosition([&] (const TilePosition& tile) { tiles.push_back(tile); });
+
+        // Off mesh connections are only added for doors, which are left to the game, see WorldspaceLoader
+        const std::vector<DetourNavigator::OffMeshConnection> offMeshConnections;
+
+        std::atomic<std::size_t> nextTile(0);
+        std::atomic<std::size_t> generated(0);
+        std::atomic<std::size_t> stored(0);
+        std::atomic<std::size_t> empty(0);
+        std::atomic<std::size_t> failed(0);
+        std::atomic<std::uint64_t> dataSize(0);
+
+        const auto generate = [&] ()
+        {
+            for (std::size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+            {
+                const TilePosition& tile = tiles[i];
+                try
+                {
+                    const auto recastMesh = data.mRecastMeshManager->getMesh(tile);
+                    if (!recastMesh)
+                    {
+                        ++empty;
+                        continue;
+                    }
+
+                    if (const auto navMeshData = navMeshDiskCache.read(agentHalfExtents, tile, *recastMesh,
+                                                                       offMeshConnections))
+                    {
+                        ++stored;
+                        dataSize += static_cast<std::uint64_t>(navMeshData->mSize);
+                        continue;
+                    }
+
+                    const auto navMeshData = DetourNavigator::makeNavMeshTile(agentHalfExtents, *recastMesh, tile,
+                        offMeshConnections, settings);
+
+                    // The game doesn't look for tiles without any input, so they are not written
+                    if (!navMeshData)
+                    {
+                        ++empty;
+                        continue;
+                    }
+
+                    navMeshDiskCache.write(agentHalfExtents, tile, *recastMesh, offMeshConnections,
+                                           navMeshData->mValue.get(), navMeshData->mSize);
+
+                    ++generated;
+                    dataSize += static_cast<std::uint64_t>(navMeshData->mSize);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to generate tile (" << tile << ") of " << data.mName << ": " << e.what();
+                    ++failed;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < std::min(threadsCount, tiles.size()); ++i)
+            threads.emplace_back(generate);
+        generate();
+        for (auto& thread : threads)
+            thread.join();
+
+        GenerationStats result;
+        result.mTiles = tiles.size();
+        result.mGenerated = generated;
+        result.mStored = stored;
+        result.mEmpty = empty;
+        result.mFailed = failed;
+        result.mDataSize = dataSize;
+        result.mSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef OPENMW_NAVMESHTOOL_GENERATETILES_H
+#define OPENMW_NAVMESHTOOL_GENERATETILES_H
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourNavigator
+{
+    class NavMeshDiskCache;
+    struct Settings;
+}
+
+namespace NavMeshTool
+{
+    struct WorldspaceData;
+
+    struct GenerationStats
+    {
+        std::size_t mTiles = 0;
+        std::size_t mGenerated = 0;
+        std::size_t mStored = 0;
+        std::size_t mEmpty = 0;
+        std::size_t mFailed = 0;
+        std::uint64_t mDataSize = 0;
+        double mSeconds = 0;
+
+        GenerationStats& operator+=(const GenerationStats& other);
+    };
+
+    /// Generates all tiles of the worldspace on \a threadsCount threads and writes them to the disk cache.
+    /// Tiles that are already stored for the same input are not generated again.
+    GenerationStats generateTiles(WorldspaceData& data, const osg::Vec3f& agentHalfExtents,
+        const DetourNavigator::Settings& settings, DetourNavigator::NavMeshDiskCache& navMeshDiskCache,
+        std::size_t threadsCount);
+}
+
+#endif
@@ -0,0 +1,273 @@
+///Program to generate the navmesh tiles of all cells ahead of time, so that the game can read them from its
+///navmesh disk cache instead of generating them while it runs.
+
+#include "generatetiles.hpp"
+#include "worldspacedata.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/detournavigator/navmeshdiskcache.hpp>
+#include <components/detournavigator/recastglobalallocator.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/configurationmanager.hpp>
+#include <components/files/escape.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/misc/constants.hpp>
+#include <components/misc/resourcehelpers.hpp>
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapemanager.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/settings/settings.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/registerarchives.hpp>
+
+#include "../openmw/mwphysics/constants.hpp"
+#include "../openmw/mwworld/esmloader.hpp"
+#include "../openmw/mwworld/esmstore.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace bpo = boost::program_options;
+namespace bfs = boost::filesystem;
+
+namespace
+{
+    using StringsVector = std::vector<std::string>;
+
+    void loadSettings(Settings::Manager& settings, const Files::ConfigurationManager& cfgMgr)
+    {
+        const std::string localDefault = (cfgMgr.getLocalPath() / "settings-default.cfg").string();
+        const std::string globalDefault = (cfgMgr.getGlobalPath() / "settings-default.cfg").string();
+
+        if (bfs::exists(localDefault))
+            settings.loadDefault(localDefault);
+        else if (bfs::exists(globalDefault))
+            settings.loadDefault(globalDefault);
+        else
+            throw std::runtime_error("No default settings file found! Make sure the file \"settings-default.cfg\" was properly installed.");
+
+        const std::string settingsPath = (cfgMgr.getUserConfigPath() / "settings.cfg").string();
+        if (bfs::exists(settingsPath))
+            settings.loadUser(settingsPath);
+    }
+
+    void loadContent(const Files::Collections& fileCollections, const StringsVector& content,
+        ToUTF8::Utf8Encoder* encoder, MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers)
+    {
+        Loading::Listener listener;
+        MWWorld::EsmLoader esmLoader(store, readers, encoder, listener, false);
+
+        readers.resize(content.size());
+
+        int index = 0;
+        for (const std::string& file : content)
+        {
+            const Files::MultiDirCollection& collection = fileCollections.getCollection(bfs::path(file).extension().string());
+            if (!collection.doesExist(file))
+                throw std::runtime_error("Failed loading " + file + ": the content file does not exist");
+            esmLoader.load(collection.getPath(file), index);
+            ++index;
+        }
+
+        esmLoader.loadRecords();
+        store.setUp(true);
+    }
+
+    void reportStats(const std::string& name, const NavMeshTool::GenerationStats& stats)
+    {
+        Log(Debug::Info) << std::fixed << std::setprecision(2) << name << ": "
+            << stats.mTiles << " tiles, "
+            << stats.mGenerated << " generated, "
+            << stats.mStored << " already stored, "
+            << stats.mEmpty << " empty, "
+            << stats.mFailed << " failed, "
+            << (stats.mSeconds > 0 ? stats.mGenerated / stats.mSeconds : 0) << " tiles/s, "
+            << stats.mDataSize / 1024.0 / 1024.0 << " MiB";
+    }
+
+    int runNavMeshTool(int argc, char** argv)
+    {
+        bpo::options_description desc("Syntax: openmw-navmeshtool <options>\nAllowed options");
+
+        desc.add_options()
+            ("help", "print help message")
+
+            ("data", bpo::value<Files::EscapePathContainer>()->default_value(Files::EscapePathContainer(), "data")
+                ->multitoken()->composing(), "set data directories (later directories have higher priority)")
+
+            ("data-local", bpo::value<Files::EscapeHashString>()->default_value(""),
+                "set local data directory (highest priority)")
+
+            ("fallback-archive", bpo::value<Files::EscapeStringVector>()->default_value(Files::EscapeStringVector(), "fallback-archive")
+                ->multitoken(), "set fallback BSA archives (later archives have higher priority)")
+
+            ("resources", bpo::value<Files::EscapeHashString>()->default_value("resources"),
+                "set resources directory")
+
+            ("content", bpo::value<Files::EscapeStringVector>()->default_value(Files::EscapeStringVector(), "")
+                ->multitoken(), "content file(s): esm/esp, or omwgame/omwaddon")
+
+            ("fs-strict", bpo::value<bool>()->implicit_value(true)
+                ->default_value(false), "strict file system handling (no case folding)")
+
+            ("encoding", bpo::value<Files::EscapeHashString>()->default_value("win1252"),
+                "character encoding of the content files: win1250, win1251 or win1252")
+
+            ("output", bpo::value<std::string>()->default_value(""),
+                "directory to write the tiles to (default: the navmesh directory in the user cache directory)")
+
+            ("threads", bpo::value<std::size_t>()->default_value(std::max(1u, std::thread::hardware_concurrency())),
+                "number of threads to generate tiles on")
+
+            ("process-interior-cells", bpo::value<bool>()->implicit_value(true)
+                ->default_value(false), "generate tiles for interior cells too, for actors with the unscaled "
+                "half extents of the player (the game uses the scaled half extents of each actor in interior cells)")
+        ;
+
+        bpo::variables_map variables;
+        bpo::store(bpo::command_line_parser(argc, argv).options(desc).allow_unregistered().run(), variables);
+        bpo::notify(variables);
+
+        if (variables.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+
+        Files::ConfigurationManager cfgMgr;
+        cfgMgr.readConfiguration(variables, desc);
+
+        Files::PathContainer dataDirs(Files::EscapePath::toPathContainer(variables["data"].as<Files::EscapePathContainer>()));
+
+        std::string local(variables["data-local"].as<Files::EscapeHashString>().toStdString());
+        if (!local.empty())
+        {
+            if (local.front() == '\"')
+                local = local.substr(1, local.length() - 2);
+
+            dataDirs.push_back(Files::PathContainer::value_type(local));
+        }
+
+        cfgMgr.processPaths(dataDirs);
+
+        const bfs::path resDir(variables["resources"].as<Files::EscapeHashString>().toStdString());
+        dataDirs.insert(dataDirs.begin(), resDir / "vfs");
+
+        const bool fsStrict = variables["fs-strict"].as<bool>();
+        const Files::Collections fileCollections(dataDirs, !fsStrict);
+        const StringsVector archives = variables["fallback-archive"].as<Files::EscapeStringVector>().toStdStringVector();
+
+        const StringsVector content = variables["content"].as<Files::EscapeStringVector>().toStdStringVector();
+        if (content.empty())
+        {
+            Log(Debug::Error) << "No content file given (esm/esp, nor omwgame/omwaddon). Aborting...";
+            return 1;
+        }
+
+        Settings::Manager settingsManager;
+        loadSettings(settingsManager, cfgMgr);
+
+        const std::string encoding(variables["encoding"].as<Files::EscapeHashString>().toStdString());
+        ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding));
+
+        VFS::Manager vfs(fsStrict);
+        VFS::registerArchives(&vfs, fileCollections, archives, true);
+
+        Resource::ResourceSystem resourceSystem(&vfs);
+        Resource::BulletShapeManager bulletShapeManager(&vfs, resourceSystem.getSceneManager(),
+            resourceSystem.getNifFileManager());
+
+        MWWorld::ESMStore store;
+        std::vector<ESM::ESMReader> readers;
+        loadContent(fileCollections, content, &encoder, store, readers);
+
+        // The same settings the game uses, see MWWorld::World
+        auto navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager();
+        if (!navigatorSettings)
+        {
+            Log(Debug::Error) << "Navigator is disabled in settings. Aborting...";
+            return 1;
+        }
+
+        navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
+        navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
+        navigatorSettings->mSwimHeightScale = store.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
+
+        std::string output = variables["output"].as<std::string>();
+        if (output.empty())
+            output = (cfgMgr.getCachePath() / "navmesh").string();
+
+        // Actors in exterior cells use the half extents of the player for pathfinding, see MWWorld::World
+        const std::string playerModel = Misc::ResourceHelpers::correctActorModelPath(Constants::BaseAnimModel, &vfs);
+        const auto playerShape = bulletShapeManager.getShape(playerModel);
+        if (!playerShape || playerShape->mCollisionBoxHalfExtents.length2() == 0)
+        {
+            Log(Debug::Error) << "Failed to get actor half extents from " << playerModel << ". Aborting...";
+            return 1;
+        }
+        const osg::Vec3f agentHalfExtents = playerShape->mCollisionBoxHalfExtents;
+
+        const std::size_t threadsCount = std::max<std::size_t>(1, variables["threads"].as<std::size_t>());
+
+        DetourNavigator::RecastGlobalAllocator::init();
+        DetourNavigator::NavMeshDiskCache navMeshDiskCache(output, *navigatorSettings);
+        NavMeshTool::WorldspaceLoader loader(store, readers, bulletShapeManager, *navigatorSettings);
+        NavMeshTool::GenerationStats total;
+
+        Log(Debug::Info) << "Writing navmesh tiles to " << output << " on " << threadsCount << " threads";
+
+        {
+            NavMeshTool::WorldspaceData exterior = loader.loadExterior();
+            Log(Debug::Info) << "Loaded " << exterior.mCellsCount << " exterior cells with "
+                << exterior.mObjectsCount << " objects";
+            const auto stats = NavMeshTool::generateTiles(exterior, agentHalfExtents, *navigatorSettings,
+                navMeshDiskCache, threadsCount);
+            reportStats(exterior.mName, stats);
+            total += stats;
+        }
+
+        if (variables["process-interior-cells"].as<bool>())
+        {
+            NavMeshTool::GenerationStats interiors;
+            const auto& cells = store.get<ESM::Cell>();
+            for (auto it = cells.intBegin(); it != cells.intEnd(); ++it)
+            {
+                NavMeshTool::WorldspaceData interior = loader.loadInterior(*it);
+                const auto stats = NavMeshTool::generateTiles(interior, agentHalfExtents, *navigatorSettings,
+                    navMeshDiskCache, threadsCount);
+                Log(Debug::Verbose) << std::fixed << std::setprecision(2) << interior.mName << ": "
+                    << stats.mTiles << " tiles in " << stats.mSeconds << " s";
+                interiors += stats;
+            }
+            reportStats(std::to_string(cells.getIntSize()) + " interior cells", interiors);
+            total += interiors;
+        }
+
+        navMeshDiskCache.wait();
+
+        reportStats("Total", total);
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        return runNavMeshTool(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
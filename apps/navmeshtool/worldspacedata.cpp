@@ -0,0 +1,318 @@
+#include "worldspacedata.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/loadcell.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/stringops.hpp>
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapemanager.hpp>
+
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+#include <osg/Quat>
+
+#include "../openmw/mwphysics/heightfield.hpp"
+#include "../openmw/mwworld/esmstore.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace
+{
+    using RefList = std::vector<std::pair<ESM::CellRef, bool>>;
+
+    /// The references of the object types that get a collision shape in the game, in the order
+    /// MWWorld::CellStore lists them.
+    struct CellRefs
+    {
+        RefList mActivators;
+        RefList mContainers;
+        RefList mDoors;
+        RefList mLights;
+        RefList mStatics;
+
+        RefList* get(int type)
+        {
+            switch (type)
+            {
+                case ESM::REC_ACTI: return &mActivators;
+                case ESM::REC_CONT: return &mContainers;
+                case ESM::REC_DOOR: return &mDoors;
+                case ESM::REC_LIGH: return &mLights;
+                case ESM::REC_STAT: return &mStatics;
+                default: return nullptr;
+            }
+        }
+    };
+
+    RefList::iterator findRef(RefList& refs, const ESM::RefNum& refNum)
+    {
+        return std::find_if(refs.begin(), refs.end(),
+            [&] (const std::pair<ESM::CellRef, bool>& v) { return v.first.mRefNum == refNum; });
+    }
+
+    /// Same as MWWorld::CellStore::loadRef, for the references of interest
+    void loadRef(const MWWorld::ESMStore& store, ESM::CellRef& ref, bool deleted,
+        std::map<ESM::RefNum, std::string>& refNumToId, CellRefs& refs)
+    {
+        Misc::StringUtils::lowerCaseInPlace(ref.mRefID);
+
+        const auto it = refNumToId.find(ref.mRefNum);
+        if (it != refNumToId.end() && it->second != ref.mRefID)
+        {
+            if (RefList* const list = refs.get(store.find(it->second)))
+            {
+                const auto found = findRef(*list, ref.mRefNum);
+                if (found != list->end())
+                    list->erase(found);
+            }
+        }
+
+        const int type = store.find(ref.mRefID);
+        if (type == 0)
+            return;
+
+        if (RefList* const list = refs.get(type))
+        {
+            const auto found = findRef(*list, ref.mRefNum);
+            if (found != list->end())
+                *found = std::make_pair(ref, deleted);
+            else
+                list->emplace_back(ref, deleted);
+        }
+
+        refNumToId[ref.mRefNum] = ref.mRefID;
+    }
+
+    std::string getModel(const std::string& model)
+    {
+        return model.empty() ? std::string() : "meshes\\" + model;
+    }
+
+    std::string getModel(const MWWorld::ESMStore& store, int type, const std::string& id)
+    {
+        // Marker objects with a hardcoded function in the game logic are hidden, see MWWorld::Scene
+        if (id == "prisonmarker" || id == "divinemarker" || id == "templemarker" || id == "northmarker")
+            return std::string();
+
+        switch (type)
+        {
+            case ESM::REC_ACTI: return getModel(store.get<ESM::Activator>().find(id)->mModel);
+            case ESM::REC_CONT: return getModel(store.get<ESM::Container>().find(id)->mModel);
+            case ESM::REC_DOOR: return getModel(store.get<ESM::Door>().find(id)->mModel);
+            case ESM::REC_LIGH:
+            {
+                // Lights that can be carried don't have collision, see MWClass::Light::insertObject
+                const ESM::Light* light = store.get<ESM::Light>().find(id);
+                if (light->mData.mFlags & ESM::Light::Carry)
+                    return std::string();
+                return getModel(light->mModel);
+            }
+            case ESM::REC_STAT: return getModel(store.get<ESM::Static>().find(id)->mModel);
+            default: return std::string();
+        }
+    }
+
+    /// Same rotation as the one MWWorld::Scene gives objects
+    osg::Quat makeObjectOsgQuat(const ESM::Position& position)
+    {
+        const float xr = position.rot[0];
+        const float yr = position.rot[1];
+        const float zr = position.rot[2];
+
+        return osg::Quat(zr, osg::Vec3(0, 0, -1))
+            * osg::Quat(yr, osg::Vec3(0, -1, 0))
+            * osg::Quat(xr, osg::Vec3(-1, 0, 0));
+    }
+}
+
+namespace NavMeshTool
+{
+    WorldspaceData::WorldspaceData(const std::string& name, const DetourNavigator::Settings& settings)
+        : mName(name)
+        , mRecastMeshManager(new DetourNavigator::TileCachedRecastMeshManager(settings))
+    {
+    }
+
+    WorldspaceData::WorldspaceData(WorldspaceData&&) = default;
+
+    WorldspaceData::~WorldspaceData() = default;
+
+    WorldspaceLoader::WorldspaceLoader(const MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
+            Resource::BulletShapeManager& bulletShapeManager, const DetourNavigator::Settings& settings)
+        : mStore(store)
+        , mReaders(readers)
+        , mBulletShapeManager(bulletShapeManager)
+        , mSettings(settings)
+        , mDefaultHeights(ESM::Land::LAND_NUM_VERTS, ESM::Land::DEFAULT_HEIGHT)
+    {
+    }
+
+    WorldspaceData WorldspaceLoader::loadExterior()
+    {
+        WorldspaceData data("exterior", mSettings);
+
+        const auto& cells = mStore.get<ESM::Cell>();
+        for (auto it = cells.extBegin(); it != cells.extEnd(); ++it)
+        {
+            // Terrain first, then references, then water, like MWWorld::Scene::loadCell
+            addHeightField(*it, data);
+            addObjects(*it, data);
+            addWater(*it, data);
+            ++data.mCellsCount;
+        }
+
+        return data;
+    }
+
+    WorldspaceData WorldspaceLoader::loadInterior(const ESM::Cell& cell)
+    {
+        WorldspaceData data(cell.mName, mSettings);
+        addObjects(cell, data);
+        addWater(cell, data);
+        ++data.mCellsCount;
+        return data;
+    }
+
+    void WorldspaceLoader::addHeightField(const ESM::Cell& cell, WorldspaceData& data)
+    {
+        const float verts = ESM::Land::LAND_SIZE;
+        const float worldsize = ESM::Land::REAL_SIZE;
+        const int cellX = cell.getGridX();
+        const int cellY = cell.getGridY();
+
+        std::unique_ptr<MWPhysics::HeightField> heightField;
+
+        if (const ESM::Land* land = mStore.get<ESM::Land>().search(cellX, cellY))
+        {
+            std::unique_ptr<ESM::Land::LandData> landData(new ESM::Land::LandData);
+            land->loadData(ESM::Land::DATA_VHGT, landData.get());
+            if (landData->mDataLoaded & ESM::Land::DATA_VHGT)
+            {
+                heightField.reset(new MWPhysics::HeightField(landData->mHeights, cellX, cellY, worldsize / (verts-1),
+                    verts, landData->mMinHeight, landData->mMaxHeight, nullptr));
+                data.mLandData.push_back(std::move(landData));
+            }
+        }
+
+        if (!heightField)
+            heightField.reset(new MWPhysics::HeightField(mDefaultHeights.data(), cellX, cellY, worldsize / (verts-1),
+                verts, ESM::Land::DEFAULT_HEIGHT, ESM::Land::DEFAULT_HEIGHT, nullptr));
+
+        data.mRecastMeshManager->addObject(DetourNavigator::ObjectId(heightField.get()), *heightField->getShape(),
+            heightField->getCollisionObject()->getWorldTransform(), DetourNavigator::AreaType_ground);
+        data.mHeightFields.push_back(std::move(heightField));
+    }
+
+    void WorldspaceLoader::addObjects(const ESM::Cell& cell, WorldspaceData& data)
+    {
+        if (cell.mContextList.empty())
+            return;
+
+        CellRefs refs;
+        std::map<ESM::RefNum, std::string> refNumToId;
+
+        for (std::size_t i = 0; i < cell.mContextList.size(); ++i)
+        {
+            try
+            {
+                const int index = cell.mContextList[i].index;
+                cell.restore(mReaders[index], static_cast<int>(i));
+
+                ESM::CellRef ref;
+                ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
+
+                bool deleted = false;
+                while (cell.getNextRef(mReaders[index], ref, deleted))
+                {
+                    if (std::find(cell.mMovedRefs.begin(), cell.mMovedRefs.end(), ref.mRefNum) != cell.mMovedRefs.end())
+                        continue;
+
+                    loadRef(mStore, ref, deleted, refNumToId, refs);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "An error occurred loading references for cell " << cell.getDescription() << ": " << e.what();
+            }
+        }
+
+        for (const auto& leased : cell.mLeasedRefs)
+        {
+            ESM::CellRef ref = leased.first;
+            loadRef(mStore, ref, leased.second, refNumToId, refs);
+        }
+
+        for (const RefList* list : {&refs.mActivators, &refs.mContainers, &refs.mDoors, &refs.mLights, &refs.mStatics})
+        {
+            for (const auto& ref : *list)
+            {
+                if (ref.second)
+                    continue;
+
+                const ESM::CellRef& cellRef = ref.first;
+                const std::string model = getModel(mStore, mStore.find(cellRef.mRefID), cellRef.mRefID);
+                if (model.empty())
+                    continue;
+
+                osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance;
+                try
+                {
+                    shapeInstance = mBulletShapeManager.getInstance(model);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Error) << "Failed to load '" << model << "' for '" << cellRef.mRefID << "': " << e.what();
+                    continue;
+                }
+
+                if (!shapeInstance || !shapeInstance->getCollisionShape())
+                    continue;
+
+                // Doors that don't teleport get off mesh connections in the game too. They are found by casting
+                // rays into the loaded scene, so the tiles with such doors are still generated by the game.
+
+                // Same transform as MWPhysics::Object has
+                shapeInstance->setLocalScaling(btVector3(cellRef.mScale, cellRef.mScale, cellRef.mScale));
+                const btTransform transform(Misc::Convert::toBullet(makeObjectOsgQuat(cellRef.mPos)),
+                    btVector3(cellRef.mPos.pos[0], cellRef.mPos.pos[1], cellRef.mPos.pos[2]));
+
+                data.mRecastMeshManager->addObject(DetourNavigator::ObjectId(shapeInstance.get()),
+                    *shapeInstance->getCollisionShape(), transform, DetourNavigator::AreaType_ground);
+
+                if (const auto avoid = shapeInstance->getAvoidCollisionShape())
+                    data.mRecastMeshManager->addObject(DetourNavigator::ObjectId(avoid), *avoid, transform,
+                        DetourNavigator::AreaType_null);
+
+                data.mShapeInstances.push_back(std::move(shapeInstance));
+                ++data.mObjectsCount;
+            }
+        }
+    }
+
+    void WorldspaceLoader::addWater(const ESM::Cell& cell, WorldspaceData& data)
+    {
+        if (!cell.hasWater())
+            return;
+
+        const osg::Vec2i cellPosition(cell.getGridX(), cell.getGridY());
+
+        if (cell.isExterior())
+        {
+            // Water level of exterior cells, see MWWorld::CellStore::getWaterLevel
+            const btScalar level = -1;
+            const btTransform& transform = data.mHeightFields.back()->getCollisionObject()->getWorldTransform();
+            data.mRecastMeshManager->addWater(cellPosition, ESM::Land::REAL_SIZE,
+                btTransform(transform.getBasis(), btVector3(transform.getOrigin().x(), transform.getOrigin().y(), level)));
+        }
+        else
+        {
+            data.mRecastMeshManager->addWater(cellPosition, std::numeric_limits<int>::max(),
+                btTransform(btMatrix3x3::getIdentity(), btVector3(0, 0, cell.mWater)));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef OPENMW_NAVMESHTOOL_WORLDSPACEDATA_H
+#define OPENMW_NAVMESHTOOL_WORLDSPACEDATA_H
+
+#include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+#include <components/esm/loadland.hpp>
+
+#include <osg/ref_ptr>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ESM
+{
+    class ESMReader;
+    struct Cell;
+}
+
+namespace MWPhysics
+{
+    class HeightField;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+}
+
+namespace Resource
+{
+    class BulletShapeInstance;
+    class BulletShapeManager;
+}
+
+namespace NavMeshTool
+{
+    /// Everything the navmesh of one worldspace is generated from, added in the same order the game adds it when
+    /// the cells are loaded. All exterior cells are one worldspace, every interior cell is another one.
+    struct WorldspaceData
+    {
+        std::string mName;
+        std::unique_ptr<DetourNavigator::TileCachedRecastMeshManager> mRecastMeshManager;
+        std::size_t mCellsCount = 0;
+        std::size_t mObjectsCount = 0;
+
+        // The recast mesh manager refers to the shapes, so they have to be kept alive
+        std::vector<std::unique_ptr<ESM::Land::LandData>> mLandData;
+        std::vector<std::unique_ptr<MWPhysics::HeightField>> mHeightFields;
+        std::vector<osg::ref_ptr<Resource::BulletShapeInstance>> mShapeInstances;
+
+        WorldspaceData(const std::string& name, const DetourNavigator::Settings& settings);
+        WorldspaceData(WorldspaceData&&);
+        ~WorldspaceData();
+    };
+
+    class WorldspaceLoader
+    {
+    public:
+        WorldspaceLoader(const MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
+            Resource::BulletShapeManager& bulletShapeManager, const DetourNavigator::Settings& settings);
+
+        WorldspaceData loadExterior();
+
+        WorldspaceData loadInterior(const ESM::Cell& cell);
+
+    private:
+        const MWWorld::ESMStore& mStore;
+        std::vector<ESM::ESMReader>& mReaders;
+        Resource::BulletShapeManager& mBulletShapeManager;
+        const DetourNavigator::Settings& mSettings;
+        std::vector<float> mDefaultHeights;
+
+        void addHeightField(const ESM::Cell& cell, WorldspaceData& data);
+
+        void addObjects(const ESM::Cell& cell, WorldspaceData& data);
+
+        void addWater(const ESM::Cell& cell, WorldspaceData& data);
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <chrono>
 
 #include <components/nif/niffile.hpp>
 #include <components/files/constrainedfilestream.hpp>
@@ -80,15 +81,63 @@ void readVFS(VFS::Archive* anArchive,std::string archivePath = "")
     }
 }
 
-bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
+/// Parse all the nif files in a given VFS::Archive the given number of times, and print how fast that was.
+/// \note Takes ownership!
+void benchmarkVFS(VFS::Archive* anArchive, const std::string& archivePath, int passes)
+{
+    VFS::Manager myManager(true);
+    myManager.addArchive(anArchive);
+    myManager.buildIndex();
+
+    // Open each file once first, so that only parsing is measured and broken files are left out
+    std::vector<std::string> names;
+    size_t totalSize = 0;
+    for (const auto& file : myManager.getIndex())
+    {
+        if (!isNIF(file.first))
+            continue;
+        try
+        {
+            Files::IStreamPtr stream = myManager.get(file.first);
+            stream->seekg(0, std::ios_base::end);
+            totalSize += static_cast<size_t>(stream->tellg());
+            stream->seekg(0);
+            Nif::NIFFile nif(stream, archivePath + file.first);
+            names.push_back(file.first);
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << "ERROR, an exception has occurred:  " << e.what() << std::endl;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        for (const std::string& name : names)
+            Nif::NIFFile nif(myManager.get(name), name);
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    const double seconds = duration.count();
+    std::cout << archivePath << ": parsed " << names.size() << " files (" << totalSize / (1024.0 * 1024.0) << " MB) "
+              << passes << " times in " << seconds << " s, "
+              << names.size() * passes / seconds << " files/s, "
+              << totalSize * passes / (1024.0 * 1024.0) / seconds << " MB/s" << std::endl;
+}
+
+bool parseOptions (int argc, char** argv, std::vector<std::string>& files, int& passes)
 {
     bpo::options_description desc("Ensure that OpenMW can use the provided NIF and BSA files\n\n"
         "Usages:\n"
         "  niftool <nif files, BSA files, or directories>\n"
-        "      Scan the file or directories for nif errors.\n\n"
+        "      Scan the file or directories for nif errors.\n"
+        "  niftool --benchmark <passes> <BSA files, or directories>\n"
+        "      Measure how fast all nif files in the BSA files or directories are parsed.\n\n"
         "Allowed options");
     desc.add_options()
         ("help,h", "print help message.")
+        ("benchmark,b", bpo::value<int>(&passes)->default_value(0), "parse all nif files this many times and print the speed.")
         ("input-file", bpo::value< std::vector<std::string> >(), "input file")
         ;
 
@@ -129,7 +178,8 @@ bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
 int main(int argc, char **argv)
 {
     std::vector<std::string> files;
-    if(!parseOptions (argc, argv, files))
+    int passes = 0;
+    if(!parseOptions (argc, argv, files, passes))
         return 1;
 
 //     std::cout << "Reading Files" << std::endl;
@@ -147,12 +197,18 @@ int main(int argc, char **argv)
              else if(isBSA(name))
              {
 //                 std::cout << "Reading BSA File: " << name << std::endl;
-                readVFS(new VFS::BsaArchive(name));
+                if (passes > 0)
+                    benchmarkVFS(new VFS::BsaArchive(name), name + "/", passes);
+                else
+                    readVFS(new VFS::BsaArchive(name));
              }
              else if(bfs::is_directory(bfs::path(name)))
              {
 //                 std::cout << "Reading All Files in: " << name << std::endl;
-                readVFS(new VFS::FileSystemArchive(name),name);
+                if (passes > 0)
+                    benchmarkVFS(new VFS::FileSystemArchive(name), name, passes);
+                else
+                    readVFS(new VFS::FileSystemArchive(name),name);
              }
              else
              {
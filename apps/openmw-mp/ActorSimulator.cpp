@@ -0,0 +1,233 @@
+#include "ActorSimulator.hpp"
+
+#include <cmath>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/TimedLog.hpp>
+
+#include "Cell.hpp"
+#include "CellController.hpp"
+#include "Networking.hpp"
+
+using namespace std;
+
+namespace
+{
+    // Fraction of its speed an actor keeps after a second without updates from an authority
+    const float speedRetainedPerSecond = 0.25f;
+
+    // Velocities above this come from teleports or cell changes rather than movement
+    const float maxSpeed = 1000.f;
+
+    const float minSpeed = 1.f;
+
+    float getSpeed(const float velocity[3])
+    {
+        return sqrt(velocity[0] * velocity[0] + velocity[1] * velocity[1] + velocity[2] * velocity[2]);
+    }
+}
+
+ActorSimulator::ActorSimulator(unsigned int threadCount, unsigned int updateRate)
+    : jobsInProgress(0)
+    , shouldStop(false)
+    , updateInterval(chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<float>(1.f / max(updateRate, 1u))))
+    , lastUpdate(chrono::steady_clock::now())
+{
+    threadCount = max(threadCount, 1u);
+
+    LOG_APPEND(TimedLog::LOG_INFO, "- Simulating unattended cells at %u updates per second on %u threads",
+        updateRate, threadCount);
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        threads.emplace_back(&ActorSimulator::threadBody, this);
+}
+
+ActorSimulator::~ActorSimulator()
+{
+    {
+        lock_guard<mutex> lock(jobMutex);
+        shouldStop = true;
+    }
+    hasJob.notify_all();
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+void ActorSimulator::update()
+{
+    publishFinishedJobs();
+
+    auto now = chrono::steady_clock::now();
+
+    if (now - lastUpdate < updateInterval)
+        return;
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+
+        // Let the previous steps finish first, so results for a cell are always applied in order
+        if (jobsInProgress > 0)
+            return;
+    }
+
+    float duration = chrono::duration<float>(now - lastUpdate).count();
+    lastUpdate = now;
+
+    queueUnattendedCells(duration);
+}
+
+void ActorSimulator::queueUnattendedCells(float duration)
+{
+    vector<Job> jobs;
+
+    for (Cell *cell : CellController::get()->getCells())
+    {
+        if (cell == nullptr || cell->hasActiveAuthority())
+            continue;
+
+        Job job;
+
+        for (const auto &actor : cell->getActorList()->baseActors)
+        {
+            if (!actor.hasPositionData)
+                continue;
+
+            Cell::ActorMotion *motion = cell->getActorMotion(actor.refNum, actor.mpNum);
+
+            if (motion == nullptr)
+                continue;
+
+            float speed = getSpeed(motion->velocity);
+
+            if (speed < minSpeed || speed > maxSpeed)
+                continue;
+
+            ActorState state;
+            state.refNum = actor.refNum;
+            state.mpNum = actor.mpNum;
+            state.position = actor.position;
+            copy(motion->velocity, motion->velocity + 3, state.velocity);
+            job.actors.push_back(state);
+        }
+
+        if (job.actors.empty())
+            continue;
+
+        job.cell = cell->cell;
+        job.duration = duration;
+        jobs.push_back(move(job));
+    }
+
+    if (jobs.empty())
+        return;
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+        jobsInProgress += jobs.size();
+
+        for (auto &job : jobs)
+            pendingJobs.push_back(move(job));
+    }
+    hasJob.notify_all();
+}
+
+void ActorSimulator::publishFinishedJobs()
+{
+    vector<Job> jobs;
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+
+        if (finishedJobs.empty())
+            return;
+
+        swap(jobs, finishedJobs);
+    }
+
+    mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_POSITION);
+
+    for (auto &job : jobs)
+    {
+        Cell *cell = CellController::get()->getCell(&job.cell);
+
+        // An authority may have taken over the cell while the step was running
+        if (cell == nullptr || cell->hasActiveAuthority())
+            continue;
+
+        mwmp::BaseActorList actorList;
+        actorList.guid = RakNet::UNASSIGNED_RAKNET_GUID;
+        actorList.cell = job.cell;
+        actorList.action = mwmp::BaseActorList::SET;
+
+        for (const auto &state : job.actors)
+        {
+            mwmp::BaseActor *cellActor = cell->getActor(state.refNum, state.mpNum);
+            Cell::ActorMotion *motion = cell->getActorMotion(state.refNum, state.mpNum);
+
+            if (cellActor == nullptr || motion == nullptr)
+                continue;
+
+            cellActor->position = state.position;
+            copy(state.velocity, state.velocity + 3, motion->velocity);
+
+            mwmp::BaseActor actor;
+            actor.refNum = state.refNum;
+            actor.mpNum = state.mpNum;
+            actor.position = state.position;
+            actor.direction = ESM::Position();
+            actorList.baseActors.push_back(actor);
+        }
+
+        if (actorList.baseActors.empty())
+            continue;
+
+        actorList.count = actorList.baseActors.size();
+        cell->sendToLoaded(actorPacket, &actorList);
+    }
+}
+
+void ActorSimulator::threadBody()
+{
+    while (true)
+    {
+        Job job;
+
+        {
+            unique_lock<mutex> lock(jobMutex);
+            hasJob.wait(lock, [this] { return shouldStop || !pendingJobs.empty(); });
+
+            if (shouldStop)
+                return;
+
+            job = move(pendingJobs.front());
+            pendingJobs.pop_front();
+        }
+
+        step(job);
+
+        {
+            lock_guard<mutex> lock(jobMutex);
+            finishedJobs.push_back(move(job));
+            --jobsInProgress;
+        }
+    }
+}
+
+void ActorSimulator::step(Job &job)
+{
+    float retained = pow(speedRetainedPerSecond, job.duration);
+
+    for (auto &actor : job.actors)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            actor.position.pos[i] += actor.velocity[i] * job.duration;
+            actor.velocity[i] *= retained;
+        }
+
+        if (getSpeed(actor.velocity) < minSpeed)
+            actor.velocity[0] = actor.velocity[1] = actor.velocity[2] = 0;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef OPENMW_ACTORSIMULATOR_HPP
+#define OPENMW_ACTORSIMULATOR_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <components/esm/defs.hpp>
+#include <components/esm/loadcell.hpp>
+
+/*
+    Keeps actors moving in cells whose authority has left them, until a new authority takes over
+
+    The server has no physics or AI of its own, so actors are advanced along the velocity observed
+    from their last ID_ACTOR_POSITION updates, slowing down until they come to rest. The stepping runs
+    on worker threads, while the results are applied and sent to the players in the cell from the
+    main loop.
+*/
+class ActorSimulator
+{
+public:
+    ActorSimulator(unsigned int threadCount, unsigned int updateRate);
+    ~ActorSimulator();
+
+    // Called every iteration of the main loop
+    void update();
+
+private:
+    struct ActorState
+    {
+        unsigned int refNum;
+        unsigned int mpNum;
+        ESM::Position position;
+        float velocity[3];
+    };
+
+    struct Job
+    {
+        ESM::Cell cell;
+        float duration;
+        std::vector<ActorState> actors;
+    };
+
+    void queueUnattendedCells(float duration);
+    void publishFinishedJobs();
+    void threadBody();
+    static void step(Job &job);
+
+    std::vector<std::thread> threads;
+    std::mutex jobMutex;
+    std::condition_variable hasJob;
+    std::deque<Job> pendingJobs;
+    std::vector<Job> finishedJobs;
+    unsigned int jobsInProgress;
+    bool shouldStop;
+
+    std::chrono::steady_clock::duration updateInterval;
+    std::chrono::steady_clock::time_point lastUpdate;
+};
+
+#endif //OPENMW_ACTORSIMULATOR_HPP
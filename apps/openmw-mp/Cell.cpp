@@ -91,6 +91,9 @@ void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newA
             {
             case ID_ACTOR_POSITION:
 
+                if (cellActor->hasPositionData)
+                    updateMotion(cellActor->refNum, cellActor->mpNum, cellActor->position, newActor.position);
+
                 cellActor->hasPositionData = true;
                 cellActor->position = newActor.position;
                 break;
@@ -150,6 +153,7 @@ void Cell::removeActors(const mwmp::BaseActorList *newActorList)
 
             if (newActor.refNum == refNum && newActor.mpNum == mpNum)
             {
+                actorMotions.erase({refNum, mpNum});
                 it = cellActorList.baseActors.erase(it);
                 foundActor = true;
                 break;
@@ -170,14 +174,66 @@ RakNet::RakNetGUID *Cell::getAuthority()
 
 void Cell::setAuthority(const RakNet::RakNetGUID& guid)
 {
+    if (authorityGuid != guid)
+        authorityTime = std::chrono::steady_clock::now();
+
     authorityGuid = guid;
 }
 
+std::chrono::steady_clock::time_point Cell::getAuthorityTime() const
+{
+    return authorityTime;
+}
+
+bool Cell::hasActiveAuthority() const
+{
+    return find_if(players.begin(), players.end(), [this](const Player *player) {
+        return player != nullptr && player->guid == authorityGuid;
+    }) != players.end();
+}
+
 mwmp::BaseActorList *Cell::getActorList()
 {
     return &cellActorList;
 }
 
+Cell::ActorMotion *Cell::getActorMotion(unsigned int refNum, unsigned int mpNum)
+{
+    auto it = actorMotions.find({refNum, mpNum});
+
+    if (it == actorMotions.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+void Cell::updateMotion(unsigned int refNum, unsigned int mpNum, const ESM::Position &oldPosition,
+    const ESM::Position &newPosition)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto it = actorMotions.find({refNum, mpNum});
+
+    if (it == actorMotions.end())
+    {
+        actorMotions[{refNum, mpNum}] = {{0, 0, 0}, now};
+        return;
+    }
+
+    ActorMotion &motion = it->second;
+    float elapsed = std::chrono::duration<float>(now - motion.lastUpdate).count();
+    motion.lastUpdate = now;
+
+    // Updates further apart than this are too coarse to tell anything about how the actor is moving
+    if (elapsed <= 0 || elapsed > 1.f)
+    {
+        motion.velocity[0] = motion.velocity[1] = motion.velocity[2] = 0;
+        return;
+    }
+
+    for (int i = 0; i < 3; ++i)
+        motion.velocity[i] = (newPosition.pos[i] - oldPosition.pos[i]) / elapsed;
+}
+
 Cell::TPlayers Cell::getPlayers() const
 {
     return players;
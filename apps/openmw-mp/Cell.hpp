@@ -1,7 +1,9 @@
 #ifndef OPENMW_SERVERCELL_HPP
 #define OPENMW_SERVERCELL_HPP
 
+#include <chrono>
 #include <deque>
+#include <map>
 #include <string>
 #include <components/esm/records.hpp>
 #include <components/openmw-mp/Base/BaseActor.hpp>
@@ -15,8 +17,16 @@ class Cell;
 class Cell
 {
     friend class CellController;
+    friend class ActorSimulator;
 public:
     Cell(ESM::Cell cell);
+
+    struct ActorMotion
+    {
+        float velocity[3];
+        std::chrono::steady_clock::time_point lastUpdate;
+    };
+
     typedef std::deque<Player*> TPlayers;
     typedef TPlayers::const_iterator Iterator;
 
@@ -33,7 +43,10 @@ public:
 
     RakNet::RakNetGUID *getAuthority();
     void setAuthority(const RakNet::RakNetGUID& guid);
+    bool hasActiveAuthority() const;
+    std::chrono::steady_clock::time_point getAuthorityTime() const;
     mwmp::BaseActorList *getActorList();
+    ActorMotion *getActorMotion(unsigned int refNum, unsigned int mpNum);
 
     TPlayers getPlayers() const;
     void sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const;
@@ -43,11 +56,16 @@ public:
 
 
 private:
+    void updateMotion(unsigned int refNum, unsigned int mpNum, const ESM::Position &oldPosition,
+        const ESM::Position &newPosition);
+
     TPlayers players;
     ESM::Cell cell;
 
     RakNet::RakNetGUID authorityGuid;
+    std::chrono::steady_clock::time_point authorityTime;
     mwmp::BaseActorList cellActorList;
+    std::map<std::pair<unsigned int, unsigned int>, ActorMotion> actorMotions;
 };
 
 
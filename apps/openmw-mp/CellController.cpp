@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include "Cell.hpp"
+#include "Networking.hpp"
 #include "Player.hpp"
 #include "Script/Script.hpp"
 
@@ -158,6 +159,79 @@ void CellController::deletePlayer(Player *player)
     }
 }
 
+namespace
+{
+    // How much better another player has to be before authority is moved to them
+    const float authorityHysteresis = 0.25f;
+
+    const std::chrono::seconds minimumAuthorityTime(30);
+
+    // Frame time in milliseconds that every actor a client is the authority for is assumed to cost it
+    const float actorCost = 0.05f;
+
+    // Lower is better: frame time in milliseconds, with every 10 ms of ping weighing as much as
+    // 1 ms of frame time, as actors lag behind by the ping of their authority, plus the cost of
+    // the actors the player is already the authority for and of the ones it would be taking over
+    float getAuthorityCost(const Player *player, size_t addedActorCount)
+    {
+        int ping = std::max(mwmp::Networking::get().getAvgPing(player->guid), 0);
+        return player->averageFrameTime * 1000 + ping / 10.f + (player->localActorCount + addedActorCount) * actorCost;
+    }
+}
+
+void CellController::balanceAuthority()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto &&cell : cells)
+    {
+        if (cell->players.size() < 2 || !cell->hasActiveAuthority())
+            continue;
+
+        if (now - cell->getAuthorityTime() < minimumAuthorityTime)
+            continue;
+
+        Player *authority = Players::getPlayer(cell->authorityGuid);
+
+        // Clients that don't report their performance can't be compared
+        if (authority == nullptr || authority->averageFrameTime <= 0)
+            continue;
+
+        Player *candidate = nullptr;
+        size_t cellActorCount = cell->cellActorList.baseActors.size();
+        float candidateCost = getAuthorityCost(authority, 0) * (1 - authorityHysteresis);
+
+        for (auto &&player : cell->players)
+        {
+            if (player == authority || player->averageFrameTime <= 0 || !player->isHandshaked())
+                continue;
+
+            float cost = getAuthorityCost(player, cellActorCount);
+
+            if (cost < candidateCost)
+            {
+                candidate = player;
+                candidateCost = cost;
+            }
+        }
+
+        if (candidate == nullptr)
+            continue;
+
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Suggesting that actor authority in %s move from %s to %s",
+            cell->getDescription().c_str(), authority->npc.mName.c_str(), candidate->npc.mName.c_str());
+
+        // Let the scripts move authority through SendActorAuthority, like any other authority change,
+        // so their own record of each cell's authority stays correct
+        Script::Call<Script::CallbackIdentity("OnCellAuthorityBalance")>(candidate->getId(), cell->getDescription().c_str());
+    }
+}
+
+const CellController::TContainer &CellController::getCells() const
+{
+    return cells;
+}
+
 void CellController::update(Player *player)
 {
     std::vector<Cell*> toDelete;
@@ -38,6 +38,17 @@ public:
 
     void update(Player *player);
 
+    /*
+        Move actor authority in cells with several players to the player best able to handle it,
+        judging by the frame times players report and their pings
+
+        Authority only moves when the other player is clearly better suited and the current
+        authority has held it for a while, so it doesn't bounce between similar clients
+    */
+    void balanceAuthority();
+
+    const TContainer &getCells() const;
+
 private:
     static CellController *sThis;
     TContainer cells;
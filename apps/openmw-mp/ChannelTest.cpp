@@ -0,0 +1,188 @@
+// Measures how long position packets take to cross a loopback connection while large inventory
+// packets are being sent at the same time, first with both packet types sharing one reliable
+// ordering channel as they used to, then with the properties players now send their movement and
+// inventories with
+//
+// Usage: ChannelTest [packet loss 0-1] [extra ping ms] [ping variance ms] [seconds per run]
+//
+// Loss and latency are simulated by RakNet's ApplyNetworkSimulator(), which only has an effect
+// when RakNet itself has been built with _DEBUG defined
+
+#include <RakPeerInterface.h>
+#include <RakSleep.h>
+#include <BitStream.h>
+#include <GetTime.h>
+#include <MessageIdentifiers.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+using namespace std;
+using namespace RakNet;
+using namespace mwmp;
+
+namespace
+{
+    const unsigned short serverPort = 25570;
+    const unsigned int positionsPerSecond = 60;
+    const unsigned int inventoriesPerSecond = 10;
+    const unsigned int inventorySize = 16 * 1024;
+
+    struct RunResult
+    {
+        vector<double> latencies;
+        unsigned int positionsSent = 0;
+    };
+
+    bool waitForConnection(RakPeerInterface *client, RakPeerInterface *server)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            for (Packet *packet = server->Receive(); packet; packet = server->Receive())
+                server->DeallocatePacket(packet);
+
+            for (Packet *packet = client->Receive(); packet; packet = client->Receive())
+            {
+                bool accepted = packet->data[0] == ID_CONNECTION_REQUEST_ACCEPTED;
+                client->DeallocatePacket(packet);
+                if (accepted)
+                    return true;
+            }
+            RakSleep(10);
+        }
+        return false;
+    }
+
+    RunResult run(const PacketProperties &positionProperties, const PacketProperties &inventoryProperties,
+                  float packetLoss, unsigned short extraPing, unsigned short pingVariance, unsigned int seconds)
+    {
+        RunResult result;
+
+        RakPeerInterface *server = RakPeerInterface::GetInstance();
+        RakPeerInterface *client = RakPeerInterface::GetInstance();
+
+        SocketDescriptor serverSocket(serverPort, "127.0.0.1");
+        SocketDescriptor clientSocket(0, "127.0.0.1");
+        server->Startup(1, &serverSocket, 1);
+        server->SetMaximumIncomingConnections(1);
+        client->Startup(1, &clientSocket, 1);
+
+        client->Connect("127.0.0.1", serverPort, nullptr, 0);
+
+        if (!waitForConnection(client, server))
+        {
+            cerr << "Could not connect to the loopback server" << endl;
+            RakPeerInterface::DestroyInstance(client);
+            RakPeerInterface::DestroyInstance(server);
+            return result;
+        }
+
+        client->ApplyNetworkSimulator(packetLoss, extraPing, pingVariance);
+
+        SystemAddress serverAddress("127.0.0.1", serverPort);
+        vector<unsigned char> inventoryData(inventorySize, 0);
+
+        const Time start = GetTime();
+        const Time end = start + seconds * 1000;
+        Time nextPosition = start;
+        Time nextInventory = start;
+
+        // Keep receiving for a while after sending stops, so that delayed packets are still counted
+        while (GetTime() < end + 2000)
+        {
+            const Time now = GetTime();
+
+            if (now < end && now >= nextPosition)
+            {
+                BitStream bs;
+                bs.Write((MessageID) ID_PLAYER_POSITION);
+                bs.Write(GetTimeUS());
+                client->Send(&bs, positionProperties.priority, positionProperties.reliability,
+                             positionProperties.orderChannel, serverAddress, false);
+                result.positionsSent++;
+                nextPosition += 1000 / positionsPerSecond;
+            }
+
+            if (now < end && now >= nextInventory)
+            {
+                BitStream bs;
+                bs.Write((MessageID) ID_PLAYER_INVENTORY);
+                bs.Write((const char *) inventoryData.data(), inventorySize);
+                client->Send(&bs, inventoryProperties.priority, inventoryProperties.reliability,
+                             inventoryProperties.orderChannel, serverAddress, false);
+                nextInventory += 1000 / inventoriesPerSecond;
+            }
+
+            for (Packet *packet = server->Receive(); packet; packet = server->Receive())
+            {
+                if (packet->data[0] == ID_PLAYER_POSITION)
+                {
+                    BitStream bs(packet->data, packet->length, false);
+                    bs.IgnoreBytes(1);
+                    TimeUS sentTime;
+                    bs.Read(sentTime);
+                    result.latencies.push_back((GetTimeUS() - sentTime) / 1000.0);
+                }
+                server->DeallocatePacket(packet);
+            }
+
+            RakSleep(1);
+        }
+
+        client->Shutdown(100);
+        server->Shutdown(100);
+        RakPeerInterface::DestroyInstance(client);
+        RakPeerInterface::DestroyInstance(server);
+
+        return result;
+    }
+
+    void printResult(const char *name, RunResult &result)
+    {
+        cout << name << ": " << result.latencies.size() << "/" << result.positionsSent << " positions received";
+
+        if (!result.latencies.empty())
+        {
+            vector<double> &latencies = result.latencies;
+            sort(latencies.begin(), latencies.end());
+
+            double sum = 0;
+            for (double latency : latencies)
+                sum += latency;
+
+            cout << ", latency in ms: mean " << sum / latencies.size()
+                 << ", median " << latencies[latencies.size() / 2]
+                 << ", 99th percentile " << latencies[latencies.size() * 99 / 100]
+                 << ", max " << latencies.back();
+        }
+
+        cout << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    float packetLoss = argc > 1 ? (float) atof(argv[1]) : 0.05f;
+    unsigned short extraPing = argc > 2 ? (unsigned short) atoi(argv[2]) : 50;
+    unsigned short pingVariance = argc > 3 ? (unsigned short) atoi(argv[3]) : 20;
+    unsigned int seconds = argc > 4 ? (unsigned int) atoi(argv[4]) : 10;
+
+    cout << "Simulating " << packetLoss * 100 << "% packet loss, " << extraPing << " ms extra ping, "
+         << pingVariance << " ms ping variance" << endl;
+
+    // The properties PacketPlayerPosition and PlayerPacket used to set for these packets
+    const PacketProperties sharedPosition = {MEDIUM_PRIORITY, RELIABLE_ORDERED, CHANNEL_PLAYER};
+    const PacketProperties sharedInventory = {HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_PLAYER};
+    RunResult sharedResult = run(sharedPosition, sharedInventory, packetLoss, extraPing, pingVariance, seconds);
+    printResult("Shared channel", sharedResult);
+
+    RunResult partitionedResult = run(getMovementPacketProperties(), getPacketProperties(ID_PLAYER_INVENTORY),
+                                      packetLoss, extraPing, pingVariance, seconds);
+    printResult("Partitioned channels", partitionedResult);
+
+    return 0;
+}
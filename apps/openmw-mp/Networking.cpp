@@ -18,6 +18,7 @@
 
 #include "Networking.hpp"
 #include "MasterClient.hpp"
+#include "ActorSimulator.hpp"
 #include "Cell.hpp"
 #include "CellController.hpp"
 #include "processors/PlayerProcessor.hpp"
@@ -37,7 +38,8 @@ static bool dataFileEnforcementState = true;
 static bool scriptErrorIgnoringState = false;
 bool killLoop = false;
 
-Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
+Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr), actorSimulator(nullptr),
+    authorityBalancing(false)
 {
     sThis = this;
     this->peer = peer;
@@ -72,6 +74,8 @@ Networking::~Networking()
 {
     Script::Call<Script::CallbackIdentity("OnServerExit")>(false);
 
+    delete actorSimulator;
+
     CellController::destroy();
 
     sThis = 0;
@@ -585,6 +589,16 @@ int Networking::mainLoop()
             }
         }
         TimerAPI::Tick();
+
+        if (actorSimulator != nullptr)
+            actorSimulator->update();
+
+        if (authorityBalancing && chrono::steady_clock::now() - lastAuthorityBalance >= authorityBalanceInterval)
+        {
+            lastAuthorityBalance = chrono::steady_clock::now();
+            CellController::get()->balanceAuthority();
+        }
+
         this_thread::sleep_for(chrono::milliseconds(1));
     }
 
@@ -643,6 +657,19 @@ void Networking::postInit()
     Script::Call<Script::CallbackIdentity("OnServerPostInit")>();
 }
 
+void Networking::enableActorSimulation(unsigned int threadCount, unsigned int updateRate)
+{
+    if (actorSimulator == nullptr)
+        actorSimulator = new ActorSimulator(threadCount, updateRate);
+}
+
+void Networking::enableAuthorityBalancing(unsigned int interval)
+{
+    authorityBalancing = true;
+    authorityBalanceInterval = chrono::seconds(interval);
+    lastAuthorityBalance = chrono::steady_clock::now();
+}
+
 PacketPreInit::PluginContainer &Networking::getSamples()
 {
     return samples;
@@ -1,6 +1,8 @@
 #ifndef OPENMW_NETWORKING_HPP
 #define OPENMW_NETWORKING_HPP
 
+#include <chrono>
+
 #include <components/openmw-mp/Controllers/SystemPacketController.hpp>
 #include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
 #include <components/openmw-mp/Controllers/ActorPacketController.hpp>
@@ -10,6 +12,7 @@
 #include "Player.hpp"
 
 class MasterClient;
+class ActorSimulator;
 namespace  mwmp
 {
     class Networking
@@ -72,6 +75,9 @@ namespace  mwmp
 
         void postInit();
 
+        void enableActorSimulation(unsigned int threadCount, unsigned int updateRate);
+        void enableAuthorityBalancing(unsigned int interval);
+
         PacketPreInit::PluginContainer &getSamples();
     private:
         bool preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn);
@@ -82,6 +88,11 @@ namespace  mwmp
         RakNet::BitStream bsOut;
         TPlayers *players;
         MasterClient *mclient;
+        ActorSimulator *actorSimulator;
+
+        bool authorityBalancing;
+        std::chrono::steady_clock::duration authorityBalanceInterval;
+        std::chrono::steady_clock::time_point lastAuthorityBalance;
 
         BaseSystem baseSystem;
         BaseActorList baseActorList;
@@ -112,6 +112,20 @@ int ServerFunctions::GetAvgPing(unsigned short pid) noexcept
     return mwmp::Networking::get().getAvgPing(player->guid);
 }
 
+double ServerFunctions::GetAvgFrameTime(unsigned short pid) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, 0);
+    return player->averageFrameTime;
+}
+
+unsigned int ServerFunctions::GetLocalActorCount(unsigned short pid) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, 0);
+    return player->localActorCount;
+}
+
 const char *ServerFunctions::GetIP(unsigned short pid) noexcept
 {
     Player *player;
@@ -22,6 +22,8 @@
     {"GetServerVersion",                ServerFunctions::GetServerVersion},\
     {"GetProtocolVersion",              ServerFunctions::GetProtocolVersion},\
     {"GetAvgPing",                      ServerFunctions::GetAvgPing},\
+    {"GetAvgFrameTime",                 ServerFunctions::GetAvgFrameTime},\
+    {"GetLocalActorCount",              ServerFunctions::GetLocalActorCount},\
     {"GetIP",                           ServerFunctions::GetIP},\
     {"GetMaxPlayers",                   ServerFunctions::GetMaxPlayers},\
     {"GetPort",                         ServerFunctions::GetPort},\
@@ -180,6 +182,22 @@ public:
     */
     static int GetAvgPing(unsigned short pid) noexcept;
 
+    /**
+    * \brief Get the average frame time last reported by a certain player's client.
+    *
+    * \param pid The player ID.
+    * \return The average frame time in seconds, or 0 if the client hasn't reported it.
+    */
+    static double GetAvgFrameTime(unsigned short pid) noexcept;
+
+    /**
+    * \brief Get the number of actors a certain player's client last reported being the authority for.
+    *
+    * \param pid The player ID.
+    * \return The number of actors.
+    */
+    static unsigned int GetLocalActorCount(unsigned short pid) noexcept;
+
     /**
     * \brief Get the IP address of a certain player.
     *
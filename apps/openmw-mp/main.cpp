@@ -300,6 +300,23 @@ int main(int argc, char *argv[])
             networking.getMasterClient()->Start();
         }
 
+        if (mgr.getBool("simulateUnattendedCells", "Actors"))
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Simulation of unattended cells enabled.");
+            int simulationThreads = mgr.getInt("simulationThreads", "Actors");
+            int simulationRate = mgr.getInt("simulationRate", "Actors");
+
+            networking.enableActorSimulation((unsigned) max(simulationThreads, 1), (unsigned) max(simulationRate, 1));
+        }
+
+        if (mgr.getBool("balanceAuthority", "Actors"))
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Actor authority balancing enabled.");
+            int balanceInterval = mgr.getInt("authorityBalanceInterval", "Actors");
+
+            networking.enableAuthorityBalancing((unsigned) max(balanceInterval, 1));
+        }
+
         networking.postInit();
 
         code = networking.mainLoop();
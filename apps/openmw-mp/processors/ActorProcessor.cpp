@@ -13,9 +13,8 @@ void ActorProcessor::Do(ActorPacket &packet, Player &player, BaseActorList &acto
 
 bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept
 {
-    // Clear our BaseActorList before loading new data in it
+    // Clear our BaseActorList before loading new data in it, its actors are reused and reset as they are read
     actorList.cell.blank();
-    actorList.baseActors.clear();
     actorList.guid = packet.guid;
 
     for (auto &processor : processors)
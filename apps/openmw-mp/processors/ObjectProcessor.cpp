@@ -13,9 +13,8 @@ void ObjectProcessor::Do(ObjectPacket &packet, Player &player, BaseObjectList &o
 
 bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
 {
-    // Clear our BaseObjectList before loading new data in it
+    // Clear our BaseObjectList before loading new data in it, its objects are reused and reset as they are read
     objectList.cell.blank();
-    objectList.baseObjects.clear();
     objectList.guid = packet.guid;
 
     for (auto &processor : processors)
@@ -0,0 +1,24 @@
+#ifndef OPENMW_PROCESSORPLAYERPERFORMANCE_HPP
+#define OPENMW_PROCESSORPLAYERPERFORMANCE_HPP
+
+#include "../PlayerProcessor.hpp"
+
+namespace mwmp
+{
+    class ProcessorPlayerPerformance : public PlayerProcessor
+    {
+    public:
+        ProcessorPlayerPerformance()
+        {
+            BPP_INIT(ID_PLAYER_PERFORMANCE)
+        }
+
+        void Do(PlayerPacket &packet, Player &player) override
+        {
+            // The reported frame time and actor count have been read into the player already,
+            // and are only used when balancing actor authority
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORPLAYERPERFORMANCE_HPP
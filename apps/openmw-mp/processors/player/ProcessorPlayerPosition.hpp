@@ -15,7 +15,16 @@ namespace mwmp
 
         void Do(PlayerPacket &packet, Player &player) override
         {
+            // Relay movement updates the same way they were sent, and the position a player stopped at reliably,
+            // then leave the packet reliable for the positions the server sends itself
+            const ESM::Position &direction = player.direction;
+            bool isMoving = direction.pos[0] != 0 || direction.pos[1] != 0 ||
+                direction.rot[0] != 0 || direction.rot[1] != 0 || direction.rot[2] != 0;
+
+            if (isMoving)
+                packet.setProperties(getMovementPacketProperties());
             player.sendToLoaded(&packet);
+            packet.setProperties(getPacketProperties(ID_PLAYER_POSITION));
         }
     };
 }
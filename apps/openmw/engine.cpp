@@ -26,6 +26,7 @@
 
 #include <components/compiler/extensions0.hpp>
 
+#include <components/sceneutil/skinningbatch.hpp>
 #include <components/sceneutil/vismask.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
@@ -292,7 +293,12 @@ bool OMW::Engine::frame(float frametime)
             stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
             stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
+            if (mSkinningBatch)
+                mSkinningBatch->reportStats(frameNumber, *stats);
+
             mEnvironment.getWorld()->getNavigator()->reportStats(frameNumber, *stats);
+
+            mEnvironment.getMechanicsManager()->reportStats(frameNumber, *stats);
         }
 
     }
@@ -370,6 +376,8 @@ OMW::Engine::~Engine()
 
     mWorkQueue = nullptr;
 
+    mSkinningBatch = nullptr;
+
     mViewer = nullptr;
 
     mResourceSystem.reset();
@@ -605,12 +613,21 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
         Settings::Manager::getString("texture mipmap", "General"),
         Settings::Manager::getInt("anisotropy", "General")
     );
+    if (Settings::Manager::getBool("model cache", "Cells"))
+        mResourceSystem->getSceneManager()->setTemplateCachePath((mCfgMgr.getCachePath() / "models").string());
 
     int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
     mWorkQueue = new SceneUtil::WorkQueue(numThreads);
 
+    const int skinningThreads = Settings::Manager::getInt("skinning threads", "General");
+    if (skinningThreads > 0)
+    {
+        mSkinningBatch = new SceneUtil::SkinningBatch(skinningThreads);
+        mViewer->getUpdateVisitor()->setUserData(mSkinningBatch);
+    }
+
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
 
@@ -687,7 +704,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     // Create the world
     mEnvironment.setWorld( new MWWorld::World (mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(),
         mFileCollections, mContentFiles, mEncoder, mActivationDistanceOverride, mCellName,
-        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string()));
+        mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string(), mCfgMgr.getCachePath().string()));
     mEnvironment.getWorld()->setupPlayer();
     input->setPlayer(&mEnvironment.getWorld()->getPlayer());
 
@@ -909,6 +926,8 @@ void OMW::Engine::go()
 
         mViewer->advance(simulationTime);
 
+        mEnvironment.getWorld()->finishAsyncPhysics();
+
         if (!frame(dt))
         {
             OpenThreads::Thread::microSleep(5000);
@@ -919,8 +938,14 @@ void OMW::Engine::go()
             mViewer->eventTraversal();
             mViewer->updateTraversal();
 
+            if (mSkinningBatch)
+                mSkinningBatch->skin();
+
             mEnvironment.getWorld()->updateWindowManager();
 
+            // Rendering doesn't use physics, so the actors can be moved meanwhile
+            mEnvironment.getWorld()->startAsyncPhysics();
+
             mViewer->renderingTraversals();
 
             bool guiActive = mEnvironment.getWindowManager()->isGuiMode();
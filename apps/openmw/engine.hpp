@@ -21,6 +21,7 @@ namespace Resource
 namespace SceneUtil
 {
     class WorkQueue;
+    class SkinningBatch;
 }
 
 namespace VFS
@@ -74,6 +75,7 @@ namespace OMW
             std::unique_ptr<VFS::Manager> mVFS;
             std::unique_ptr<Resource::ResourceSystem> mResourceSystem;
             osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            osg::ref_ptr<SceneUtil::SkinningBatch> mSkinningBatch;
             MWBase::Environment mEnvironment;
             ToUTF8::FromType mEncoding;
             ToUTF8::Utf8Encoder* mEncoder;
@@ -11,6 +11,7 @@
 
 namespace osg
 {
+    class Stats;
     class Vec3f;
 }
 
@@ -230,6 +231,8 @@ namespace MWBase
 
             virtual void clear() = 0;
 
+            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
             virtual bool isAggressive (const MWWorld::Ptr& ptr, const MWWorld::Ptr& target) = 0;
 
             /// Resurrects the player if necessary
@@ -122,6 +122,9 @@ namespace MWBase
             virtual void testExteriorCells() = 0;
             virtual void testInteriorCells() = 0;
 
+            /// Fly over the exterior along a fixed path and report frame time statistics when done.
+            virtual void testTerrainFlight() = 0;
+
             virtual void useDeathCamera() = 0;
 
             virtual void setWaterHeight(const float height) = 0;
@@ -530,6 +533,12 @@ namespace MWBase
             virtual void update (float duration, bool paused) = 0;
             virtual void updatePhysics (float duration, bool paused) = 0;
 
+            virtual void startAsyncPhysics() = 0;
+            ///< With async physics, move the actors in the background until finishAsyncPhysics is called.
+            /// Nothing else may use physics in between.
+
+            virtual void finishAsyncPhysics() = 0;
+
             virtual void updateWindowManager () = 0;
 
             virtual MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) = 0;
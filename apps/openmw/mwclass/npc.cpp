@@ -447,10 +447,10 @@ namespace MWClass
     {
         const MWWorld::LiveCellRef<ESM::NPC> *ref = ptr.get<ESM::NPC>();
 
-        std::string model = "meshes\\base_anim.nif";
+        std::string model = Constants::BaseAnimModel;
         const ESM::Race* race = MWBase::Environment::get().getWorld()->getStore().get<ESM::Race>().find(ref->mBase->mRace);
         if(race->mData.mFlags & ESM::Race::Beast)
-            model = "meshes\\base_animkna.nif";
+            model = Constants::BaseAnimKnaModel;
 
         return model;
     }
@@ -460,7 +460,7 @@ namespace MWClass
         const MWWorld::LiveCellRef<ESM::NPC> *npc = ptr.get<ESM::NPC>();
         const ESM::Race* race = MWBase::Environment::get().getWorld()->getStore().get<ESM::Race>().search(npc->mBase->mRace);
         if(race && race->mData.mFlags & ESM::Race::Beast)
-            models.push_back("meshes\\base_animkna.nif");
+            models.push_back(Constants::BaseAnimKnaModel);
 
         // keep these always loaded just in case
         models.push_back("meshes/xargonian_swimkna.nif");
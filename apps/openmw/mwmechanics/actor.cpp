@@ -18,4 +18,19 @@ namespace MWMechanics
     {
         return mCharacterController.get();
     }
+
+    bool Actor::isDistant() const
+    {
+        return mDistantTimer.isDistant();
+    }
+
+    void Actor::setDistant(bool distant, float delay)
+    {
+        mDistantTimer.setDistant(distant, delay);
+    }
+
+    float Actor::updateDistant(float duration, float interval)
+    {
+        return mDistantTimer.update(duration, interval);
+    }
 }
@@ -3,6 +3,8 @@
 
 #include <memory>
 
+#include "distantactors.hpp"
+
 namespace MWRender
 {
     class Animation;
@@ -27,8 +29,19 @@ namespace MWMechanics
 
         CharacterController* getCharacterController();
 
+        /// Is the actor far from every player, and so only updated at a low rate?
+        bool isDistant() const;
+
+        /// Start or stop updating the actor at a low rate. The first update comes after \a delay seconds.
+        void setDistant(bool distant, float delay = 0);
+
+        /// Count the time since the last low rate update
+        /// \return Time to update the actor by, or 0 if it is not updated in this frame
+        float updateDistant(float duration, float interval);
+
     private:
         std::unique_ptr<CharacterController> mCharacterController;
+        DistantActorTimer mDistantTimer;
     };
 
 }
@@ -2,6 +2,7 @@
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
+#include <components/esm/loadland.hpp>
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/vismask.hpp>
@@ -55,6 +56,8 @@
 #include "aifollow.hpp"
 #include "aipursue.hpp"
 #include "actor.hpp"
+#include "distantactors.hpp"
+#include "pathfinding.hpp"
 #include "summoning.hpp"
 #include "combat.hpp"
 #include "actorutil.hpp"
@@ -62,6 +65,9 @@
 namespace
 {
 
+/// Interval of the low rate updates of actors far from every player
+const float sDistantActorsUpdateInterval = 1.f;
+
 bool isConscious(const MWWorld::Ptr& ptr)
 {
     const MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
@@ -156,6 +162,19 @@ void getRestorationPerHourOfSleep (const MWWorld::Ptr& ptr, float& health, float
     magicka = fRestMagicMult * stats.getAttribute(ESM::Attribute::Intelligence).getModified();
 }
 
+float getMaxHeadTrackDistance (const MWWorld::Ptr& actor)
+{
+    static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fMaxHeadTrackDistance")->mValue.getFloat();
+    static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
+            .find("fInteriorHeadTrackMult")->mValue.getFloat();
+    float maxDistance = fMaxHeadTrackDistance;
+    const ESM::Cell* currentCell = actor.getCell()->getCell();
+    if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
+        maxDistance *= fInteriorHeadTrackMult;
+    return maxDistance;
+}
+
 }
 
 namespace MWMechanics
@@ -398,14 +417,7 @@ namespace MWMechanics
         if (targetActor.getClass().getCreatureStats(targetActor).isDead())
             return;
 
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->mValue.getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->mValue.getFloat();
-        float maxDistance = fMaxHeadTrackDistance;
-        const ESM::Cell* currentCell = actor.getCell()->getCell();
-        if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
-            maxDistance *= fInteriorHeadTrackMult;
+        const float maxDistance = getMaxHeadTrackDistance(actor);
 
         const osg::Vec3f actor1Pos(actor.getRefData().getPosition().asVec3());
         const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -1469,7 +1481,12 @@ namespace MWMechanics
     }
 
     Actors::Actors()
+        : mActorsGrid(ESM::Land::REAL_SIZE / 4)
+        , mAiScheduler(Settings::Manager::getFloat("ai decision budget", "Game"))
     {
+        mDistantActorsRange = getDistantActorsRange(Settings::Manager::getFloat("distant actors range", "Game"),
+                                                    Settings::Manager::getFloat("viewing distance", "Camera"));
+        mReducedAnimationRateDistance = Settings::Manager::getFloat("reduced animation rate distance", "Game");
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
         updateProcessingRange();
@@ -1682,6 +1699,8 @@ namespace MWMechanics
     {
         if(!paused)
         {
+            mAiScheduler.startFrame();
+
             static float timerUpdateAITargets = 0;
             static float timerUpdateHeadTrack = 0;
             static float timerUpdateEquippedLight = 0;
@@ -1706,7 +1725,38 @@ namespace MWMechanics
 
             std::map<const MWWorld::Ptr, const std::set<MWWorld::Ptr> > cachedAllies; // will be filled as engageCombat iterates
 
+            // Actors only check the other actors in range of them instead of all of them
+            std::vector<PtrActorMap::iterator> actorsByIndex;
+            std::vector<std::size_t> actorsInRange;
+            if (timerUpdateAITargets == 0 || timerUpdateHeadTrack == 0)
+            {
+                mActorsGrid.clear();
+                for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                {
+                    mActorsGrid.add(actorsByIndex.size(), it->first.getRefData().getPosition().asVec3());
+                    actorsByIndex.push_back(it);
+                }
+                mActorsGrid.build();
+            }
+
             bool aiActive = MWBase::Environment::get().getMechanicsManager()->isAIActive();
+
+            // Actors far from every player are only updated at a low rate
+            std::vector<osg::Vec3f> playerPositions;
+            for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                if (it->first == player || mwmp::PlayerList::isDedicatedPlayer(it->first))
+                    playerPositions.push_back(it->first.getRefData().getPosition().asVec3());
+
+            for (PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+            {
+                const bool wasDistant = it->second->isDistant();
+                const bool distant = isDistant(it->first, wasDistant, playerPositions);
+                // Spread the updates of actors that become distant at once over the interval
+                if (distant != wasDistant)
+                    it->second->setDistant(distant, Misc::Rng::rollProbability() * sDistantActorsUpdateInterval);
+            }
+            std::vector<std::pair<MWWorld::Ptr, osg::Vec3f>> distantMoves;
+
             int attackedByPlayerId = player.getClass().getCreatureStats(player).getHitAttemptActorId();
             if (attackedByPlayerId != -1)
             {
@@ -1784,6 +1834,8 @@ namespace MWMechanics
                 // For dead actors we need to remove looping spell particles
                 if (iter->first.getClass().getCreatureStats(iter->first).isDead())
                     ctrl->updateContinuousVfx();
+                else if (iter->second->isDistant())
+                    updateDistantActor(iter->first, *iter->second, duration, aiActive, distantMoves);
                 else
                 {
                     bool cellChanged = world->hasCellChanged();
@@ -1815,14 +1867,20 @@ namespace MWMechanics
                     {
                         if (timerUpdateAITargets == 0 && (isLocalActor || aiActive))
                         {
-                            if (!isPlayer)
+                            if (!isPlayer) // player is not AI-controlled
+                            {
                                 adjustCommandedActor(iter->first);
 
-                            for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
-                            {
-                                if (it->first == iter->first || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(iter->first, it->first, cachedAllies, it->first == player);
+                                // engageCombat ignores the actors out of processing range
+                                mActorsGrid.findInRange(iter->first.getRefData().getPosition().asVec3(),
+                                                        mActorsProcessingRange, actorsInRange);
+                                for (std::size_t index : actorsInRange)
+                                {
+                                    const MWWorld::Ptr& target = actorsByIndex[index]->first;
+                                    if (target == iter->first)
+                                        continue;
+                                    engageCombat(iter->first, target, cachedAllies, target == player);
+                                }
                             }
                         }
                         if (timerUpdateHeadTrack == 0)
@@ -1841,11 +1899,14 @@ namespace MWMechanics
                                 !stats.getAiSequence().hasPackage(AiPackage::TypeIdPursue) &&
                                 !firstPersonPlayer)
                             {
-                                for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
+                                mActorsGrid.findInRange(iter->first.getRefData().getPosition().asVec3(),
+                                                        getMaxHeadTrackDistance(iter->first), actorsInRange);
+                                for (std::size_t index : actorsInRange)
                                 {
-                                    if (it->first == iter->first)
+                                    const MWWorld::Ptr& target = actorsByIndex[index]->first;
+                                    if (target == iter->first)
                                         continue;
-                                    updateHeadTracking(iter->first, it->first, headTrackTarget, sqrHeadTrackDistance);
+                                    updateHeadTracking(iter->first, target, headTrackTarget, sqrHeadTrackDistance);
                                 }
                             }
 
@@ -1860,7 +1921,7 @@ namespace MWMechanics
                             CreatureStats &stats = iter->first.getClass().getCreatureStats(iter->first);
                             if (isConscious(iter->first))
                             {
-                                stats.getAiSequence().execute(iter->first, *ctrl, duration);
+                                stats.getAiSequence().execute(iter->first, *ctrl, mAiScheduler, duration);
                                 updateGreetingState(iter->first, timerUpdateHello > 0);
                                 playIdleDialogue(iter->first);
                                 updateMovementSpeed(iter->first);
@@ -1870,7 +1931,7 @@ namespace MWMechanics
                     else if ((isLocalActor || aiActive) && iter->first != player && isConscious(iter->first))
                     {
                         CreatureStats &stats = iter->first.getClass().getCreatureStats(iter->first);
-                        stats.getAiSequence().execute(iter->first, *ctrl, duration, /*outOfRange*/true);
+                        stats.getAiSequence().execute(iter->first, *ctrl, mAiScheduler, duration, /*outOfRange*/true);
                     }
                     /*
                         End of tes3mp change (major)
@@ -1890,6 +1951,15 @@ namespace MWMechanics
                 }
             }
 
+            // Moving an actor to another cell changes its Ptr, so the actors are only moved after all of them are updated
+            for (const auto& move : distantMoves)
+            {
+                const ESM::Position& position = move.first.getRefData().getPosition();
+                world->rotateObject(move.first, position.rot[0], position.rot[1],
+                                    getZAngleToDir(move.second - position.asVec3()));
+                world->moveObject(move.first, move.second.x(), move.second.y(), move.second.z());
+            }
+
             timerUpdateAITargets += duration;
             timerUpdateHeadTrack += duration;
             timerUpdateEquippedLight += duration;
@@ -1914,11 +1984,18 @@ namespace MWMechanics
                 int activeFlag = 1; // Can be changed back to '2' to keep updating bounding boxes off screen (more accurate, but slower)
                 if (isPlayer)
                     activeFlag = 2;
-                int active = inRange ? activeFlag : 0;
+                const bool distant = iter->second->isDistant();
+                int active = inRange && !distant ? activeFlag : 0;
 
                 CharacterController* ctrl = iter->second->getCharacterController();
                 ctrl->setActive(active);
 
+                // Animate actors far from the camera every second, then every fourth frame
+                unsigned int animationUpdateInterval = 1;
+                if (!isPlayer && mReducedAnimationRateDistance > 0)
+                    animationUpdateInterval = 1u << std::min(2, static_cast<int>(dist / mReducedAnimationRateDistance));
+                ctrl->setAnimationUpdateInterval(animationUpdateInterval);
+
                 if (!inRange)
                 {
                     iter->first.getRefData().getBaseNode()->setNodeMask(SceneUtil::Mask_Disabled);
@@ -1928,6 +2005,13 @@ namespace MWMechanics
                 else if (!isPlayer)
                     iter->first.getRefData().getBaseNode()->setNodeMask(SceneUtil::Mask_Actor);
 
+                // Distant actors keep their pose and are only moved by their low rate updates
+                if (distant)
+                {
+                    world->setActorCollisionMode(iter->first, false, false);
+                    continue;
+                }
+
                 const bool isDead = iter->first.getClass().getCreatureStats(iter->first).isDead();
                 if (!isDead && iter->first.getClass().getCreatureStats(iter->first).isParalyzed())
                     ctrl->skipAnim();
@@ -2632,6 +2716,52 @@ namespace MWMechanics
         return it->second->getCharacterController()->isReadyToBlock();
     }
 
+    bool Actors::isDistant(const MWWorld::Ptr& ptr, bool wasDistant, const std::vector<osg::Vec3f>& playerPositions) const
+    {
+        if (mDistantActorsRange <= 0 || ptr == getPlayer() || mwmp::PlayerList::isDedicatedPlayer(ptr)
+            || mwmp::Main::get().getCellController()->isDedicatedActor(ptr))
+            return false;
+
+        const CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+        if (stats.isDead())
+            return false;
+
+        // Only wandering and travelling can be simulated coarsely, other packages need the full AI
+        const int typeId = stats.getAiSequence().getTypeId();
+        if (typeId != AiPackage::TypeIdNone && typeId != AiPackage::TypeIdWander && typeId != AiPackage::TypeIdTravel)
+            return false;
+
+        return isFarFromPlayers(ptr.getRefData().getPosition().asVec3(), wasDistant, mDistantActorsRange, playerPositions);
+    }
+
+    void Actors::updateDistantActor(const MWWorld::Ptr& ptr, Actor& actor, float duration, bool aiActive,
+                                    std::vector<std::pair<MWWorld::Ptr, osg::Vec3f>>& moves)
+    {
+        const float elapsed = actor.updateDistant(duration, sDistantActorsUpdateInterval);
+        if (elapsed == 0)
+            return;
+
+        updateActor(ptr, elapsed);
+
+        if (ptr.getClass().isNpc())
+            calculateNpcStatModifiers(ptr, elapsed);
+
+        const bool isLocalActor = mwmp::Main::get().getCellController()->isLocalActor(ptr);
+        if ((isLocalActor || aiActive) && isConscious(ptr))
+        {
+            const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+            osg::Vec3f newPosition = position;
+            ptr.getClass().getCreatureStats(ptr).getAiSequence().simulateDistant(ptr, elapsed, newPosition);
+            if (newPosition != position)
+                moves.emplace_back(ptr, newPosition);
+        }
+    }
+
+    void Actors::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mAiScheduler.reportStats(frameNumber, stats);
+    }
+
     bool Actors::isCastingSpell(const MWWorld::Ptr &ptr) const
     {
         PtrActorMap::const_iterator it = mActors.find(ptr);
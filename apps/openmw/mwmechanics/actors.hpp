@@ -7,6 +7,9 @@
 #include <list>
 #include <map>
 
+#include "actorsgrid.hpp"
+#include "aischeduler.hpp"
+
 namespace ESM
 {
     class ESMReader;
@@ -15,6 +18,7 @@ namespace ESM
 
 namespace osg
 {
+    class Stats;
     class Vec3f;
 }
 
@@ -200,6 +204,8 @@ namespace MWMechanics
 
             void clear(); // Clear death counter
 
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
             bool isCastingSpell(const MWWorld::Ptr& ptr) const;
             bool isReadyToBlock(const MWWorld::Ptr& ptr) const;
             bool isAttackingOrSpell(const MWWorld::Ptr& ptr) const;
@@ -217,9 +223,21 @@ namespace MWMechanics
     private:
         void updateVisibility (const MWWorld::Ptr& ptr, CharacterController* ctrl);
 
+        /// Check if \a ptr is far enough from every player to be only updated at a low rate
+        bool isDistant(const MWWorld::Ptr& ptr, bool wasDistant, const std::vector<osg::Vec3f>& playerPositions) const;
+
+        /// Low rate update of stats and coarse AI for an actor far from every player
+        /// \param moves Filled with the actor and its new position if it moves
+        void updateDistantActor(const MWWorld::Ptr& ptr, Actor& actor, float duration, bool aiActive,
+                                std::vector<std::pair<MWWorld::Ptr, osg::Vec3f>>& moves);
+
         PtrActorMap mActors;
         float mTimerDisposeSummonsCorpses;
         float mActorsProcessingRange;
+        float mDistantActorsRange;
+        float mReducedAnimationRateDistance;
+        ActorsGrid mActorsGrid;
+        AiScheduler mAiScheduler;
 
     };
 }
@@ -0,0 +1,68 @@
+#include "actorsgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace MWMechanics
+{
+    ActorsGrid::ActorsGrid(float cellSize)
+        : mCellSize(cellSize)
+    {
+    }
+
+    void ActorsGrid::clear()
+    {
+        mEntries.clear();
+    }
+
+    void ActorsGrid::add(std::size_t index, const osg::Vec3f& position)
+    {
+        mEntries.push_back(Entry {getCell(position.x()), getCell(position.y()), index, position});
+    }
+
+    void ActorsGrid::build()
+    {
+        std::sort(mEntries.begin(), mEntries.end(), [] (const Entry& lhs, const Entry& rhs)
+        {
+            return std::tie(lhs.mCellX, lhs.mCellY, lhs.mIndex) < std::tie(rhs.mCellX, rhs.mCellY, rhs.mIndex);
+        });
+    }
+
+    void ActorsGrid::findInRange(const osg::Vec3f& position, float range, std::vector<std::size_t>& result) const
+    {
+        result.clear();
+
+        const int minX = getCell(position.x() - range);
+        const int maxX = getCell(position.x() + range);
+        const int minY = getCell(position.y() - range);
+        const int maxY = getCell(position.y() + range);
+        const float sqrRange = range * range;
+
+        // Entries are sorted by cell column, then row, so every column of the range is one contiguous run
+        for (int x = minX; x <= maxX; ++x)
+        {
+            auto it = std::lower_bound(mEntries.begin(), mEntries.end(), std::make_pair(x, minY),
+                [] (const Entry& entry, const std::pair<int, int>& cell)
+                {
+                    return std::tie(entry.mCellX, entry.mCellY) < std::tie(cell.first, cell.second);
+                });
+
+            for (; it != mEntries.end() && it->mCellX == x && it->mCellY <= maxY; ++it)
+                if ((it->mPosition - position).length2() <= sqrRange)
+                    result.push_back(it->mIndex);
+        }
+
+        std::sort(result.begin(), result.end());
+    }
+
+    std::size_t ActorsGrid::size() const
+    {
+        return mEntries.size();
+    }
+
+    int ActorsGrid::getCell(float coordinate) const
+    {
+        return static_cast<int>(std::floor(coordinate / mCellSize));
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef GAME_MWMECHANICS_ACTORSGRID_H
+#define GAME_MWMECHANICS_ACTORSGRID_H
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <vector>
+
+namespace MWMechanics
+{
+    /// \brief Uniform grid of actor positions on the horizontal plane
+    /// \note Rebuilt whenever the actors are checked against each other, so the checks only visit the actors in range
+    /// instead of every pair.
+    class ActorsGrid
+    {
+        public:
+            explicit ActorsGrid(float cellSize);
+
+            /// Remove all actors, keeping the allocated memory
+            void clear();
+
+            /// Add an actor, identified by \a index
+            void add(std::size_t index, const osg::Vec3f& position);
+
+            /// Sort the added actors into their cells. Must be called before findInRange.
+            void build();
+
+            /// Replace \a result by the indices of the actors within \a range of \a position, in ascending order
+            void findInRange(const osg::Vec3f& position, float range, std::vector<std::size_t>& result) const;
+
+            std::size_t size() const;
+
+        private:
+            struct Entry
+            {
+                int mCellX;
+                int mCellY;
+                std::size_t mIndex;
+                osg::Vec3f mPosition;
+            };
+
+            float mCellSize;
+            std::vector<Entry> mEntries;
+
+            int getCell(float coordinate) const;
+    };
+}
+
+#endif
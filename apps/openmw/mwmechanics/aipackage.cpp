@@ -11,6 +11,7 @@
 #include "../mwworld/action.hpp"
 #include "../mwworld/class.hpp"
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/esmstore.hpp"
 #include "../mwworld/inventorystore.hpp"
 
 #include "../mwphysics/collisiontype.hpp"
@@ -286,7 +287,8 @@ const MWMechanics::PathgridGraph& MWMechanics::AiPackage::getPathGridGraph(const
     CacheMap::iterator found = cache.find(id);
     if (found == cache.end())
     {
-        cache.insert(std::make_pair(id, std::make_unique<MWMechanics::PathgridGraph>(MWMechanics::PathgridGraph(cell))));
+        const ESM::Pathgrid* pathgrid = MWBase::Environment::get().getWorld()->getStore().get<ESM::Pathgrid>().search(*cell->getCell());
+        cache.insert(std::make_pair(id, std::make_unique<MWMechanics::PathgridGraph>(cell->getCell(), pathgrid)));
     }
     return *cache[id].get();
 }
@@ -353,6 +355,38 @@ bool MWMechanics::AiPackage::checkWayIsClearForActor(const osg::Vec3f& startPoin
     return false;
 }
 
+bool MWMechanics::AiPackage::moveDistant(const MWWorld::Ptr& actor, const osg::Vec3f& dest, float duration,
+                                         osg::Vec3f& position)
+{
+    if (distance(position, dest) <= DEFAULT_TOLERANCE)
+    {
+        mPathFinder.clearPath();
+        return true;
+    }
+
+    const MWWorld::CellStore* cell = actor.getCell();
+    if (!mPathFinder.isPathConstructed() || mPathFinder.getPathCell() != cell)
+        mPathFinder.buildPathByPathgrid(position, dest, cell, getPathGridGraph(cell));
+
+    // Nothing blocks the way, so the actor covers the full distance
+    float remaining = actor.getClass().getSpeed(actor) * duration;
+    for (const osg::Vec3f& point : mPathFinder.getPath())
+    {
+        const float toPoint = distance(position, point);
+        if (toPoint > remaining)
+        {
+            position += (point - position) * (remaining / toPoint);
+            break;
+        }
+        position = point;
+        remaining -= toPoint;
+    }
+
+    mPathFinder.update(position, MIN_TOLERANCE, MIN_TOLERANCE);
+
+    return mPathFinder.checkPathCompleted();
+}
+
 bool MWMechanics::AiPackage::doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const
 {
     return mPathFinder.getPath().empty()
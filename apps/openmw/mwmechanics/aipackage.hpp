@@ -81,6 +81,14 @@ namespace MWMechanics
             /// Simulates the passing of time
             virtual void fastForward(const MWWorld::Ptr& actor, AiState& state) {}
 
+            /// Coarse update for an actor far from every player, without animations or physics (default does nothing)
+            /** \param position The actor's position, changed to where the package moves the actor
+                \return Package completed? **/
+            virtual bool simulateDistant(const MWWorld::Ptr& actor, AiState& state, float duration, osg::Vec3f& position)
+            {
+                return false;
+            }
+
             /// Get the target actor the AI is targeted at (not applicable to all AI packages, default return empty Ptr)
             virtual MWWorld::Ptr getTarget() const;
 
@@ -118,6 +126,10 @@ namespace MWMechanics
             /** \return If the actor has arrived at his destination **/
             bool pathTo(const MWWorld::Ptr& actor, const osg::Vec3f& dest, float duration, float destTolerance = 0.0f);
 
+            /// Move \a position towards \a dest along the pathgrid, as far as the actor walks in \a duration
+            /** \return If the actor has arrived at his destination **/
+            bool moveDistant(const MWWorld::Ptr& actor, const osg::Vec3f& dest, float duration, osg::Vec3f& position);
+
             /// Check if there aren't any obstacles along the path to make shortcut possible
             /// If a shortcut is possible then path will be cleared and filled with the destination point.
             /// \param destInLOS If not nullptr function will return ray cast check result
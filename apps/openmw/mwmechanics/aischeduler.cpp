@@ -0,0 +1,81 @@
+#include "aischeduler.hpp"
+
+#include <osg/Stats>
+
+namespace
+{
+    const char* const packageStatNames[] = {
+        "AI Wander",
+        "AI Travel",
+        "AI Escort",
+        "AI Follow",
+        "AI Activate",
+        "AI Combat",
+        "AI Pursue",
+        "AI AvoidDoor",
+        "AI Face",
+        "AI Breathe",
+        "AI InternalTravel",
+        "AI Cast",
+    };
+
+    double toMicroseconds(MWMechanics::AiScheduler::Duration time)
+    {
+        return std::chrono::duration<double, std::micro>(time).count();
+    }
+}
+
+namespace MWMechanics
+{
+    AiScheduler::AiScheduler(float budget)
+        : mDecisionTime(0)
+        , mDecisions(0)
+        , mDeferred(0)
+    {
+        setBudget(budget);
+        mPackageTimes.fill(Duration(0));
+    }
+
+    void AiScheduler::setBudget(float budget)
+    {
+        mBudget = std::chrono::duration_cast<Duration>(std::chrono::duration<float, std::milli>(budget));
+    }
+
+    void AiScheduler::startFrame()
+    {
+        mDecisionTime = Duration(0);
+        mDecisions = 0;
+        mDeferred = 0;
+        mPackageTimes.fill(Duration(0));
+    }
+
+    bool AiScheduler::canDecide(bool urgent)
+    {
+        if (urgent || mDecisionTime < mBudget)
+            return true;
+        ++mDeferred;
+        return false;
+    }
+
+    void AiScheduler::finishDecision(Duration time)
+    {
+        mDecisionTime += time;
+        ++mDecisions;
+    }
+
+    void AiScheduler::addPackageTime(int typeId, Duration time)
+    {
+        if (typeId >= 0 && static_cast<std::size_t>(typeId) < mPackageTimes.size())
+            mPackageTimes[typeId] += time;
+    }
+
+    void AiScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        // Times are in microseconds to show on the stats screen without decimals
+        stats.setAttribute(frameNumber, "AI Decisions", mDecisions);
+        stats.setAttribute(frameNumber, "AI Deferred", mDeferred);
+        stats.setAttribute(frameNumber, "AI DecisionTime", toMicroseconds(mDecisionTime));
+        for (std::size_t i = 0; i < mPackageTimes.size(); ++i)
+            stats.setAttribute(frameNumber, packageStatNames[i], toMicroseconds(mPackageTimes[i]));
+    }
+}
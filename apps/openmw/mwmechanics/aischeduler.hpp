@@ -0,0 +1,57 @@
+#ifndef GAME_MWMECHANICS_AISCHEDULER_H
+#define GAME_MWMECHANICS_AISCHEDULER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace MWMechanics
+{
+    /// \brief Shares a per-frame time budget between the AI decisions of all actors
+    /// \note Urgent decisions are always made. Other ones are deferred to a later frame once the budget is spent, so
+    /// many actors in combat don't make a single frame long.
+    class AiScheduler
+    {
+        public:
+            typedef std::chrono::steady_clock::duration Duration;
+
+            /// \param budget Time in milliseconds that non-urgent decisions may take in one frame
+            explicit AiScheduler(float budget);
+
+            void setBudget(float budget);
+
+            /// Start a new frame with the full budget and reset the counters
+            void startFrame();
+
+            /// Check whether a decision can be made in this frame. A decision that can't be made is counted as
+            /// deferred.
+            bool canDecide(bool urgent);
+
+            /// Count a decision made after canDecide returned true and the time it took
+            void finishDecision(Duration time);
+
+            /// Count the time one AI package of type \a typeId took to execute
+            /** \see enum AiPackage::TypeId **/
+            void addPackageTime(int typeId, Duration time);
+
+            std::size_t getDecisions() const { return mDecisions; }
+
+            std::size_t getDeferred() const { return mDeferred; }
+
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        private:
+            Duration mBudget;
+            Duration mDecisionTime;
+            std::size_t mDecisions;
+            std::size_t mDeferred;
+            std::array<Duration, 12> mPackageTimes;
+    };
+}
+
+#endif
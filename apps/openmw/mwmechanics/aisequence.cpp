@@ -1,5 +1,6 @@
 #include "aisequence.hpp"
 
+#include <chrono>
 #include <limits>
 
 #include <components/debug/debuglog.hpp>
@@ -17,8 +18,22 @@
 #include "aicombat.hpp"
 #include "aicombataction.hpp"
 #include "aipursue.hpp"
+#include "aischeduler.hpp"
 #include "actorutil.hpp"
+#include "creaturestats.hpp"
+#include "spells.hpp"
 #include "../mwworld/class.hpp"
+#include "../mwworld/containerstore.hpp"
+
+namespace
+{
+    /// Ratings younger than this are used as is
+    const float sMinRatingAgeToRefresh = 0.25f;
+
+    /// Ratings also depend on health, magicka, item charges and the target, so even when the scheduler has no
+    /// time left they are not used longer than this
+    const float sMaxRatingAge = 1.f;
+}
 
 namespace MWMechanics
 {
@@ -34,9 +49,10 @@ void AiSequence::copy (const AiSequence& sequence)
     sequence.mAiState.copy<AiWanderStorage>(mAiState);
 }
 
-AiSequence::AiSequence() : mDone (false), mRepeat(false), mLastAiPackage(-1) {}
+AiSequence::AiSequence() : mDone (false), mRepeat(false), mLastAiPackage(-1), mSimulatedDistant(false) {}
 
 AiSequence::AiSequence (const AiSequence& sequence)
+    : mSimulatedDistant(false)
 {
     copy (sequence);
     mDone = sequence.mDone;
@@ -165,6 +181,8 @@ bool AiSequence::isInCombat(const MWWorld::Ptr &actor) const
 
 void AiSequence::stopCombat()
 {
+    mCachedRatings.clear();
+
     for(std::list<AiPackage*>::iterator it = mPackages.begin(); it != mPackages.end(); )
     {
         if ((*it)->getTypeId() == AiPackage::TypeIdCombat)
@@ -202,7 +220,51 @@ bool isActualAiPackage(int packageTypeId)
             packageTypeId <= AiPackage::TypeIdActivate);
 }
 
-void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange)
+float AiSequence::getActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target, AiScheduler& scheduler)
+{
+    const int targetId = target.getClass().getCreatureStats(target).getActorId();
+    const unsigned int inventoryRevision = actor.getClass().getContainerStore(actor).getRevision();
+    const unsigned int spellsRevision = actor.getClass().getCreatureStats(actor).getSpells().getRevision();
+
+    const std::map<int, CachedRating>::iterator cached = mCachedRatings.find(targetId);
+    if (cached != mCachedRatings.end()
+        && cached->second.mInventoryRevision == inventoryRevision
+        && cached->second.mSpellsRevision == spellsRevision
+        && cached->second.mAge < sMaxRatingAge)
+    {
+        if (cached->second.mAge < sMinRatingAgeToRefresh || !scheduler.canDecide(false))
+            return cached->second.mRating;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const float rating = getBestActionRating(actor, target);
+    scheduler.finishDecision(std::chrono::steady_clock::now() - start);
+
+    mCachedRatings[targetId] = CachedRating {rating, inventoryRevision, spellsRevision, 0.f};
+    return rating;
+}
+
+void AiSequence::finishPackage(AiPackage* package)
+{
+    const int packageTypeId = package->getTypeId();
+    // Put repeating noncombat AI packages on the end of the stack so they can be used again
+    if (isActualAiPackage(packageTypeId) && (mRepeat || package->getRepeat()))
+    {
+        package->reset();
+        mPackages.push_back(package->clone());
+    }
+    // To account for the rare case where AiPackage::execute() queued another AI package
+    // (e.g. AiPursue executing a dialogue script that uses startCombat)
+    std::list<MWMechanics::AiPackage*>::iterator toRemove =
+            std::find(mPackages.begin(), mPackages.end(), package);
+    mPackages.erase(toRemove);
+    delete package;
+    if (isActualAiPackage(packageTypeId))
+        mDone = true;
+}
+
+void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& characterController, AiScheduler& scheduler,
+                          float duration, bool outOfRange)
 {
     if(actor != getPlayer())
     {
@@ -216,6 +278,13 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
         if (!package->alwaysActive() && outOfRange)
             return;
 
+        // The package only moved the actor coarsely while it was far from every player, so its path is outdated
+        if (mSimulatedDistant)
+        {
+            mSimulatedDistant = false;
+            package->reset();
+        }
+
         int packageTypeId = package->getTypeId();
         // workaround ai packages not being handled as in the vanilla engine
         if (isActualAiPackage(packageTypeId))
@@ -230,6 +299,16 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
 
             float bestRating = 0.f;
 
+            for (std::map<int, CachedRating>::iterator it = mCachedRatings.begin(); it != mCachedRatings.end();)
+            {
+                it->second.mAge += duration;
+                // Targets that are not rated anymore are not in combat with the actor anymore
+                if (it->second.mAge > 2 * sMaxRatingAge)
+                    it = mCachedRatings.erase(it);
+                else
+                    ++it;
+            }
+
             for(std::list<AiPackage *>::iterator it = mPackages.begin(); it != mPackages.end();)
             {
                 if ((*it)->getTypeId() != AiPackage::TypeIdCombat) break;
@@ -244,7 +323,7 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
                 }
                 else
                 {
-                    float rating = MWMechanics::getBestActionRating(actor, target);
+                    float rating = getActionRating(actor, target, scheduler);
 
                     const ESM::Position &targetPos = target.getRefData().getPosition();
 
@@ -279,27 +358,14 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
 
         try
         {
-            if (package->execute (actor, characterController, mAiState, duration))
-            {
-                // Put repeating noncombat AI packages on the end of the stack so they can be used again
-                if (isActualAiPackage(packageTypeId) && (mRepeat || package->getRepeat()))
-                {
-                    package->reset();
-                    mPackages.push_back(package->clone());
-                }
-                // To account for the rare case where AiPackage::execute() queued another AI package
-                // (e.g. AiPursue executing a dialogue script that uses startCombat)
-                std::list<MWMechanics::AiPackage*>::iterator toRemove =
-                        std::find(mPackages.begin(), mPackages.end(), package);
-                mPackages.erase(toRemove);
-                delete package;
-                if (isActualAiPackage(packageTypeId))
-                    mDone = true;
-            }
+            const auto start = std::chrono::steady_clock::now();
+            const bool done = package->execute (actor, characterController, mAiState, duration);
+            scheduler.addPackageTime(packageTypeId, std::chrono::steady_clock::now() - start);
+
+            if (done)
+                finishPackage(package);
             else
-            {
                 mDone = false;
-            }
         }
         catch (std::exception& e)
         {
@@ -314,6 +380,7 @@ void AiSequence::clear()
         delete *iter;
 
     mPackages.clear();
+    mCachedRatings.clear();
 }
 
 void AiSequence::stack (const AiPackage& package, const MWWorld::Ptr& actor, bool cancelOther)
@@ -532,6 +599,25 @@ void AiSequence::readState(const ESM::AiSequence::AiSequence &sequence)
     mLastAiPackage = sequence.mLastAiPackage;
 }
 
+void AiSequence::simulateDistant(const MWWorld::Ptr& actor, float duration, osg::Vec3f& position)
+{
+    if (mPackages.empty() || actor == getPlayer())
+        return;
+
+    MWMechanics::AiPackage* package = mPackages.front();
+    mSimulatedDistant = true;
+
+    try
+    {
+        if (package->simulateDistant(actor, mAiState, duration, position))
+            finishPackage(package);
+    }
+    catch (std::exception& e)
+    {
+        Log(Debug::Error) << "Error during AiSequence::simulateDistant: " << e.what();
+    }
+}
+
 void AiSequence::fastForward(const MWWorld::Ptr& actor)
 {
     if (!mPackages.empty())
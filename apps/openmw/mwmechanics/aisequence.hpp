@@ -2,6 +2,7 @@
 #define GAME_MWMECHANICS_AISEQUENCE_H
 
 #include <list>
+#include <map>
 
 #include "aistate.hpp"
 
@@ -12,6 +13,11 @@ namespace MWWorld
     class Ptr;
 }
 
+namespace osg
+{
+    class Vec3f;
+}
+
 namespace ESM
 {
     namespace AiSequence
@@ -25,6 +31,7 @@ namespace ESM
 namespace MWMechanics
 {
     class AiPackage;
+    class AiScheduler;
     class CharacterController;
     
     template< class Base > class DerivedClassStorage;
@@ -51,6 +58,26 @@ namespace MWMechanics
             int mLastAiPackage;
             AiState mAiState;
 
+            /// Was the current package simulated coarsely since it was executed last?
+            bool mSimulatedDistant;
+
+            struct CachedRating
+            {
+                float mRating;
+                unsigned int mInventoryRevision;
+                unsigned int mSpellsRevision;
+                float mAge;
+            };
+
+            /// Best combat action ratings against each target, by target actor ID
+            std::map<int, CachedRating> mCachedRatings;
+
+            /// Remove a completed package, or put it at the end of the stack if it repeats
+            void finishPackage(AiPackage* package);
+
+            /// Rate the best combat action against \a target, reusing the last rating while it is recent enough
+            float getActionRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target, AiScheduler& scheduler);
+
         public:
             ///Default constructor
             AiSequence();
@@ -110,7 +137,14 @@ namespace MWMechanics
             void stopPursuit();
 
             /// Execute current package, switching if needed.
-            void execute (const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange=false);
+            /** @param scheduler Decides which combat targets are rated again in this frame and counts the time
+                       packages take **/
+            void execute (const MWWorld::Ptr& actor, CharacterController& characterController, AiScheduler& scheduler,
+                          float duration, bool outOfRange=false);
+
+            /// Coarse update of the current package for an actor far from every player, without animations or physics
+            /** @param position The actor's position, changed to where the package moves the actor **/
+            void simulateDistant(const MWWorld::Ptr& actor, float duration, osg::Vec3f& position);
 
             /// Simulate the passing of time using the currently active AI package
             void fastForward(const MWWorld::Ptr &actor);
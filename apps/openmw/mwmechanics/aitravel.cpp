@@ -97,6 +97,15 @@ namespace MWMechanics
         reset();
     }
 
+    bool AiTravel::simulateDistant(const MWWorld::Ptr& actor, AiState& state, float duration, osg::Vec3f& position)
+    {
+        const osg::Vec3f targetPos(mX, mY, mZ);
+        if (!isWithinMaxRange(targetPos, position))
+            return mHidden;
+
+        return moveDistant(actor, targetPos, duration, position);
+    }
+
     void AiTravel::writeState(ESM::AiSequence::AiSequence &sequence) const
     {
         std::unique_ptr<ESM::AiSequence::AiTravel> travel(new ESM::AiSequence::AiTravel());
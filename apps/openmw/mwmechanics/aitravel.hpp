@@ -24,6 +24,8 @@ namespace MWMechanics
             /// Simulates the passing of time
             virtual void fastForward(const MWWorld::Ptr& actor, AiState& state);
 
+            virtual bool simulateDistant(const MWWorld::Ptr& actor, AiState& state, float duration, osg::Vec3f& position);
+
             void writeState(ESM::AiSequence::AiSequence &sequence) const;
 
             virtual AiTravel *clone() const;
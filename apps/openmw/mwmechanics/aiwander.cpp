@@ -748,6 +748,53 @@ namespace MWMechanics
         actor.getClass().adjustPosition(actor, false);
     }
 
+    bool AiWander::simulateDistant(const MWWorld::Ptr& actor, AiState& state, float duration, osg::Vec3f& position)
+    {
+        MWMechanics::CreatureStats& cStats = actor.getClass().getCreatureStats(actor);
+        if (cStats.isDead() || cStats.getHealth().getCurrent() <= 0)
+            return true;
+
+        AiWanderStorage& storage = state.get<AiWanderStorage>();
+
+        mRemainingDuration -= ((duration*MWBase::Environment::get().getWorld()->getTimeScaleFactor()) / 3600);
+
+        if (isPackageCompleted(actor, storage))
+        {
+            // Reset package so it can be used again
+            mRemainingDuration=mDuration;
+            init();
+            return true;
+        }
+
+        if (mDistance <= 0)
+            return false;
+
+        if (storage.mPopulateAvailableNodes)
+            getAllowedNodes(actor, actor.getCell()->getCell(), storage);
+
+        if (storage.mAllowedNodes.empty())
+            return false;
+
+        if (!mHasDestination)
+        {
+            // Typically idle for a few updates before the next wander
+            if (Misc::Rng::rollDice(4) != 0)
+                return false;
+
+            setPathToAnAllowedNode(actor, storage, actor.getRefData().getPosition());
+            if (!mHasDestination)
+                return false;
+        }
+
+        if (moveDistant(actor, mDestination, duration, position))
+        {
+            stopWalking(actor, storage);
+            storage.setState(AiWanderStorage::Wander_ChooseAction);
+        }
+
+        return false;
+    }
+
     void AiWander::getNeighbouringNodes(ESM::Pathgrid::Point dest, const MWWorld::CellStore* currentCell, ESM::Pathgrid::PointList& points)
     {
         const ESM::Pathgrid *pathgrid =
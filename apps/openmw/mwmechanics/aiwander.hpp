@@ -103,6 +103,8 @@ namespace MWMechanics
 
             virtual void fastForward(const MWWorld::Ptr& actor, AiState& state);
 
+            virtual bool simulateDistant(const MWWorld::Ptr& actor, AiState& state, float duration, osg::Vec3f& position);
+
             bool getRepeat() const;
 
             osg::Vec3f getDestination(const MWWorld::Ptr& actor) const;
@@ -0,0 +1,58 @@
+#include "distantactors.hpp"
+
+#include <algorithm>
+
+namespace MWMechanics
+{
+    float getDistantActorsRange(float range, float viewingDistance)
+    {
+        if (range <= 0)
+            return 0;
+
+        return std::max(range, viewingDistance / sDistantActorsHysteresis);
+    }
+
+    bool isFarFromPlayers(const osg::Vec3f& position, bool wasDistant, float range,
+                          const std::vector<osg::Vec3f>& playerPositions)
+    {
+        if (range <= 0)
+            return false;
+
+        if (wasDistant)
+            range *= sDistantActorsHysteresis;
+
+        return std::none_of(playerPositions.begin(), playerPositions.end(),
+            [&] (const osg::Vec3f& playerPosition) { return (playerPosition - position).length2() <= range * range; });
+    }
+
+    DistantActorTimer::DistantActorTimer()
+        : mDistant(false)
+        , mTime(0)
+        , mDelay(0)
+    {
+    }
+
+    bool DistantActorTimer::isDistant() const
+    {
+        return mDistant;
+    }
+
+    void DistantActorTimer::setDistant(bool distant, float delay)
+    {
+        mDistant = distant;
+        mTime = 0;
+        mDelay = delay;
+    }
+
+    float DistantActorTimer::update(float duration, float interval)
+    {
+        mTime += duration;
+        if (mTime < mDelay)
+            return 0;
+
+        const float result = mTime;
+        mTime = 0;
+        mDelay = interval;
+        return result;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef GAME_MWMECHANICS_DISTANTACTORS_H
+#define GAME_MWMECHANICS_DISTANTACTORS_H
+
+#include <osg/Vec3f>
+
+#include <vector>
+
+namespace MWMechanics
+{
+    /// Distant actors come back to full simulation at this fraction of the distant actors range,
+    /// so that actors at the boundary don't switch every frame
+    const float sDistantActorsHysteresis = 0.9f;
+
+    /// Distant actors range to use for the configured \a range, raised so that actors within \a viewingDistance
+    /// are always fully simulated
+    /// \return 0 if \a range is 0, meaning that all actors are fully simulated
+    float getDistantActorsRange(float range, float viewingDistance);
+
+    /// Check if \a position is farther than \a range from every player. An actor that \a wasDistant only counts as
+    /// close again within the range reduced by sDistantActorsHysteresis.
+    bool isFarFromPlayers(const osg::Vec3f& position, bool wasDistant, float range,
+                          const std::vector<osg::Vec3f>& playerPositions);
+
+    /// \brief Counts the time between the low rate updates of an actor far from every player
+    class DistantActorTimer
+    {
+        public:
+            DistantActorTimer();
+
+            bool isDistant() const;
+
+            /// Start or stop the low rate updates. The first update comes after \a delay seconds.
+            void setDistant(bool distant, float delay = 0);
+
+            /// Count the time since the last low rate update
+            /// \return Time to update the actor by, or 0 if it is not updated in this frame
+            float update(float duration, float interval);
+
+        private:
+            bool mDistant;
+            float mTime;
+            float mDelay;
+    };
+}
+
+#endif
@@ -1921,6 +1921,11 @@ namespace MWMechanics
         mRaceSelected = false;
     }
 
+    void MechanicsManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        mActors.reportStats(frameNumber, stats);
+    }
+
     bool MechanicsManager::isAggressive(const MWWorld::Ptr &ptr, const MWWorld::Ptr &target)
     {
         // Don't become aggressive if a calm effect is active, since it would cause combat to cycle on/off as
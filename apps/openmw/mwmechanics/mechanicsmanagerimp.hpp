@@ -203,6 +203,8 @@ namespace MWMechanics
 
             virtual void clear() override;
 
+            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
             virtual bool isAggressive (const MWWorld::Ptr& ptr, const MWWorld::Ptr& target) override;
 
             virtual void resurrect(const MWWorld::Ptr& ptr) override;
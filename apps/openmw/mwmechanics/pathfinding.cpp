@@ -224,7 +224,7 @@ namespace MWMechanics
                     bool isPathClear = !MWBase::Environment::get().getWorld()->castRay(
                         startPoint.x(), startPoint.y(), startPoint.z() + 16, temp.mX, temp.mY, temp.mZ + 16, mask);
                     if (isPathClear)
-                        path.pop_front();
+                        path.erase(path.begin());
                 }
             }
 
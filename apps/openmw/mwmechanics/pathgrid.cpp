@@ -1,10 +1,11 @@
 #include "pathgrid.hpp"
 
-#include "../mwbase/world.hpp"
-#include "../mwbase/environment.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <tuple>
 
-#include "../mwworld/cellstore.hpp"
-#include "../mwworld/esmstore.hpp"
+#include <components/esm/loadcell.hpp>
 
 namespace
 {
@@ -45,11 +46,39 @@ namespace
         //return distance(a, b);
         return manhattan(a, b);
     }
+
+    struct OpenPoint
+    {
+        float mFScore;
+        std::size_t mOrder; // points with the same cost are traversed in the order they were added
+        int mIndex;
+    };
+
+    bool operator >(const OpenPoint& lhs, const OpenPoint& rhs)
+    {
+        return std::tie(lhs.mFScore, lhs.mOrder) > std::tie(rhs.mFScore, rhs.mOrder);
+    }
+
+    // Buffers reused by all searches of a thread, so that a search doesn't allocate
+    struct AStarBuffers
+    {
+        std::vector<float> mGScore;
+        std::vector<float> mFScore;
+        std::vector<int> mGraphParent;
+        std::vector<char> mClosed;
+        std::vector<OpenPoint> mOpenSet;
+    };
+
+    AStarBuffers& getAStarBuffers()
+    {
+        static thread_local AStarBuffers buffers;
+        return buffers;
+    }
 }
 
 namespace MWMechanics
 {
-    PathgridGraph::PathgridGraph(const MWWorld::CellStore *cell)
+    PathgridGraph::PathgridGraph(const ESM::Cell* cell, const ESM::Pathgrid* pathgrid)
         : mCell(nullptr)
         , mPathgrid(nullptr)
         , mIsExterior(0)
@@ -58,7 +87,7 @@ namespace MWMechanics
         , mSCCId(0)
         , mSCCIndex(0)
     {
-        load(cell);
+        load(cell, pathgrid);
     }
 
     /*
@@ -97,7 +126,7 @@ namespace MWMechanics
      *    +---------------->
      *      high cost
      */
-    bool PathgridGraph::load(const MWWorld::CellStore *cell)
+    bool PathgridGraph::load(const ESM::Cell* cell, const ESM::Pathgrid* pathgrid)
     {
         if(!cell)
             return false;
@@ -105,9 +134,9 @@ namespace MWMechanics
         if(mIsGraphConstructed)
             return true;
 
-        mCell = cell->getCell();
-        mIsExterior = cell->getCell()->isExterior();
-        mPathgrid = MWBase::Environment::get().getWorld()->getStore().get<ESM::Pathgrid>().search(*cell->getCell());
+        mCell = cell;
+        mIsExterior = cell->isExterior();
+        mPathgrid = pathgrid;
         if(!mPathgrid)
             return false;
 
@@ -238,105 +267,148 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
-     *
      * Returns path which may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
      *
      * Input params:
      *   start, goal - pathgrid point indexes (for this cell)
      *
-     * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
-     *   closedset - point indexes already traversed
-     *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
-     *
-     * TODO: An intersting exercise might be to cache the paths created for a
-     *       start/goal pair.  To cache the results the paths need to be in
-     *       pathgrid points form (currently they are converted to world
-     *       coordinates).  Essentially trading speed w/ memory.
+     * The paths are cached as pathgrid point indexes for each start/goal pair,
+     * the least recently used one is dropped when the cache is full.
      */
-    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
+    std::vector<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const int start, const int goal) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
+        std::vector<ESM::Pathgrid::Point> path;
         if(!isPointConnected(start, goal))
         {
             return path; // there is no path, return an empty path
         }
 
-        int graphSize = static_cast<int> (mGraph.size());
-        std::vector<float> gScore (graphSize, -1);
-        std::vector<float> fScore (graphSize, -1);
-        std::vector<int> graphParent (graphSize, -1);
+        const StartGoal key(start, goal);
+        std::vector<int> indexes;
+        bool cached = false;
+
+        {
+            const std::lock_guard<std::mutex> lock(mCachedPathsMutex);
+            const auto found = mCachedPathsIndex.find(key);
+            if (found != mCachedPathsIndex.end())
+            {
+                mCachedPaths.splice(mCachedPaths.begin(), mCachedPaths, found->second);
+                indexes = found->second->second;
+                cached = true;
+            }
+        }
+
+        if (!cached)
+        {
+            indexes = findPath(start, goal);
+
+            const std::lock_guard<std::mutex> lock(mCachedPathsMutex);
+            if (mCachedPathsIndex.find(key) == mCachedPathsIndex.end())
+            {
+                mCachedPaths.emplace_front(key, indexes);
+                mCachedPathsIndex.emplace(key, mCachedPaths.begin());
+                if (mCachedPaths.size() > sMaxCachedPaths)
+                {
+                    mCachedPathsIndex.erase(mCachedPaths.back().first);
+                    mCachedPaths.pop_back();
+                }
+            }
+        }
+
+        path.reserve(indexes.size());
+        for (const int index : indexes)
+            path.push_back(mPathgrid->mPoints[index]);
+        return path;
+    }
+
+    /*
+     * Variables:
+     *   openset - binary heap of point indexes to be traversed, lowest cost on top
+     *   closed - point indexes already traversed
+     *   gScore - past accumulated costs vector indexed by point index
+     *   fScore - future estimated costs vector indexed by point index
+     *
+     * A point whose cost goes down while it is in the openset is added again,
+     * the entry with the old cost is skipped when it comes to the top.
+     */
+    std::vector<int> PathgridGraph::findPath(const int start, const int goal) const
+    {
+        std::vector<int> path;
+
+        AStarBuffers& buffers = getAStarBuffers();
+        std::vector<float>& gScore = buffers.mGScore;
+        std::vector<float>& fScore = buffers.mFScore;
+        std::vector<int>& graphParent = buffers.mGraphParent;
+        std::vector<char>& closed = buffers.mClosed;
+        std::vector<OpenPoint>& openset = buffers.mOpenSet;
+
+        const std::size_t graphSize = mGraph.size();
+        gScore.assign(graphSize, -1);
+        fScore.assign(graphSize, -1);
+        graphParent.assign(graphSize, -1);
+        closed.assign(graphSize, 0);
+        openset.clear();
 
         // gScore & fScore keep costs for each pathgrid point in mPoints
         gScore[start] = 0;
         fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
 
-        std::list<int> openset;
-        std::list<int> closedset;
-        openset.push_back(start);
+        std::size_t order = 0;
+        openset.push_back(OpenPoint {fScore[start], order++, start});
 
         int current = -1;
 
         while(!openset.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            std::pop_heap(openset.begin(), openset.end(), std::greater<OpenPoint>());
+            const OpenPoint top = openset.back();
+            openset.pop_back();
+
+            if(closed[top.mIndex] || top.mFScore != fScore[top.mIndex])
+                continue; // outdated entry
+
+            current = top.mIndex;
 
             if(current == goal)
                 break;
 
-            closedset.push_back(current); // remember we've been here
+            closed[current] = 1; // remember we've been here
 
             // check all edges for the current point index
-            for(int j = 0; j < static_cast<int> (mGraph[current].edges.size()); j++)
+            for(const ConnectedPoint& edge : mGraph[current].edges)
             {
-                if(std::find(closedset.begin(), closedset.end(), mGraph[current].edges[j].index) ==
-                   closedset.end())
+                const int dest = edge.index;
+                if(closed[dest])
+                    continue; // traversed this edge destination already, try the next edge
+
+                const float tentative_g = gScore[current] + edge.cost;
+                const bool isInOpenSet = graphParent[dest] != -1;
+                if(!isInOpenSet || tentative_g < gScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    int dest = mGraph[current].edges[j].index;
-                    float tentative_g = gScore[current] + mGraph[current].edges[j].cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if(!isInOpenSet
-                        || tentative_g < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentative_g;
-                        fScore[dest] = tentative_g + costAStar(mPathgrid->mPoints[dest],
-                                                               mPathgrid->mPoints[goal]);
-                        if(!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            std::list<int>::iterator it = openset.begin();
-                            for(it = openset.begin(); it!= openset.end(); ++it)
-                            {
-                                if(fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    graphParent[dest] = current;
+                    gScore[dest] = tentative_g;
+                    fScore[dest] = tentative_g + costAStar(mPathgrid->mPoints[dest],
+                                                           mPathgrid->mPoints[goal]);
+                    openset.push_back(OpenPoint {fScore[dest], order++, dest});
+                    std::push_heap(openset.begin(), openset.end(), std::greater<OpenPoint>());
+                }
             }
         }
 
         if(current != goal)
             return path; // for some reason couldn't build a path
 
-        // reconstruct path to return, using local coordinates
+        // reconstruct path to return, using pathgrid point indexes
         while(graphParent[current] != -1)
         {
-            path.push_front(mPathgrid->mPoints[current]);
+            path.push_back(current);
             current = graphParent[current];
         }
 
         // add first node to path explicitly
-        path.push_front(mPathgrid->mPoints[start]);
+        path.push_back(start);
+        std::reverse(path.begin(), path.end());
         return path;
     }
 }
-
@@ -1,7 +1,11 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
-#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include <components/esm/loadpgrd.hpp>
 
@@ -10,19 +14,15 @@ namespace ESM
     struct Cell;
 }
 
-namespace MWWorld
-{
-    class CellStore;
-}
-
 namespace MWMechanics
 {
     class PathgridGraph
     {
         public:
-            PathgridGraph(const MWWorld::CellStore* cell);
+            // pathgrid may be null for cells without one
+            PathgridGraph(const ESM::Cell* cell, const ESM::Pathgrid* pathgrid);
 
-            bool load(const MWWorld::CellStore *cell);
+            bool load(const ESM::Cell* cell, const ESM::Pathgrid* pathgrid);
 
             const ESM::Pathgrid* getPathgrid() const;
 
@@ -38,7 +38,10 @@ namespace MWMechanics
             // cells) coordinates
             //
             // NOTE: if start equals end an empty path is returned
-            std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
+            //
+            // Safe to call from several threads at once. The most recently
+            // found paths are cached.
+            std::vector<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
 
         private:
 
@@ -79,6 +82,16 @@ namespace MWMechanics
             // methods used to calculate connected components
             void recursiveStrongConnect(int v);
             void buildConnectedPoints();
+
+            std::vector<int> findPath(const int start, const int goal) const;
+
+            // least recently used paths are dropped first
+            static const std::size_t sMaxCachedPaths = 64;
+            typedef std::pair<int, int> StartGoal;
+            typedef std::list<std::pair<StartGoal, std::vector<int> > > CachedPaths;
+            mutable std::mutex mCachedPathsMutex;
+            mutable CachedPaths mCachedPaths; // most recently used first
+            mutable std::map<StartGoal, CachedPaths::iterator> mCachedPathsIndex;
     };
 }
 
@@ -26,6 +26,7 @@ namespace MWMechanics
 {
     Spells::Spells()
         : mSpellsChanged(false)
+        , mRevision(0)
     {
     }
 
@@ -125,6 +126,7 @@ namespace MWMechanics
             params.mEffectRands = random;
             mSpells.insert (std::make_pair (spell, params));
             mSpellsChanged = true;
+            ++mRevision;
         }
     }
 
@@ -163,6 +165,7 @@ namespace MWMechanics
         {
             mSpells.erase (iter);
             mSpellsChanged = true;
+            ++mRevision;
         }
 
         if (spellId==mSelectedSpell)
@@ -178,10 +181,16 @@ namespace MWMechanics
         return mEffects;
     }
 
+    unsigned int Spells::getRevision() const
+    {
+        return mRevision;
+    }
+
     void Spells::clear()
     {
         mSpells.clear();
         mSpellsChanged = true;
+        ++mRevision;
     }
 
     void Spells::setSelectedSpell (const std::string& spellId)
@@ -252,6 +261,7 @@ namespace MWMechanics
 
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -277,6 +287,7 @@ namespace MWMechanics
 
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -302,6 +313,7 @@ namespace MWMechanics
 
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -327,6 +339,7 @@ namespace MWMechanics
 
                 mSpells.erase(iter++);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             else
                 ++iter;
@@ -349,6 +362,7 @@ namespace MWMechanics
             }
 
             mSpellsChanged = true;
+            ++mRevision;
         }
     }
 
@@ -392,6 +406,7 @@ namespace MWMechanics
                 magnitude *= std::max(1, mCorprusSpells[spell].mWorsenings);
                 mPermanentSpellEffects[spell].add(MWMechanics::EffectKey(*effectIt), MWMechanics::EffectParam(magnitude));
                 mSpellsChanged = true;
+                ++mRevision;
             }
         }
     }
@@ -424,6 +439,7 @@ namespace MWMechanics
                 {
                     spellIt->second.mPurgedEffects.insert(i);
                     mSpellsChanged = true;
+                    ++mRevision;
                 }
                 ++i;
             }
@@ -444,6 +460,7 @@ namespace MWMechanics
             {
                 spellIt->second.mPurgedEffects.insert(i);
                 mSpellsChanged = true;
+                ++mRevision;
             }
             ++i;
         }
@@ -512,6 +529,7 @@ namespace MWMechanics
         }
 
         mSpellsChanged = true;
+        ++mRevision;
     }
 
     void Spells::writeState(ESM::SpellState &state) const
@@ -63,6 +63,7 @@ namespace MWMechanics
             std::map<SpellKey, CorprusStats> mCorprusSpells;
 
             mutable bool mSpellsChanged;
+            unsigned int mRevision;
             mutable MagicEffects mEffects;
             mutable std::map<SpellKey, MagicEffects> mSourcedEffects;
             void rebuildEffects() const;
@@ -108,6 +109,9 @@ namespace MWMechanics
             MagicEffects getMagicEffects() const;
             ///< Return sum of magic effects resulting from abilities, blights, deseases and curses.
 
+            unsigned int getRevision() const;
+            ///< Return a number that changes whenever the spells or their effects change.
+
             void clear();
             ///< Remove all spells of al types.
 
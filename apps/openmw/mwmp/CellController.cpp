@@ -411,3 +411,8 @@ int CellController::getCellSize() const
 {
     return 8192;
 }
+
+unsigned int CellController::getLocalActorCount() const
+{
+    return localActorsToCells.size();
+}
@@ -69,6 +69,7 @@ namespace mwmp
         bool isSameCell(const ESM::Cell& cell, const ESM::Cell& otherCell);
 
         int getCellSize() const;
+        unsigned int getLocalActorCount() const;
 
     private:
         static std::map<std::string, mwmp::Cell *> cellsInitialized;
@@ -81,6 +81,10 @@ LocalPlayer::LocalPlayer()
     isReceivingQuickKeys = false;
     isPlayingAnimation = false;
     diedSinceArrestAttempt = false;
+
+    performanceTimer = 0;
+    performanceFrameTimeSum = 0;
+    performanceFrameCount = 0;
 }
 
 LocalPlayer::~LocalPlayer()
@@ -118,6 +122,8 @@ void LocalPlayer::update()
         updateBounty();
         updateReputation();
     }
+
+    updatePerformance();
 }
 
 bool LocalPlayer::processCharGen()
@@ -362,6 +368,41 @@ void LocalPlayer::updateReputation(bool forceUpdate)
     }
 }
 
+void LocalPlayer::updatePerformance()
+{
+    const float reportInterval = 2;
+
+    // Don't report anything until the player has logged in, and start measuring from there, so that
+    // the frames of the loading screen and character generation don't count
+    if (!isLoggedIn())
+    {
+        performanceTimer = 0;
+        performanceFrameTimeSum = 0;
+        performanceFrameCount = 0;
+        averageFrameTime = 0;
+        localActorCount = 0;
+        return;
+    }
+
+    float frameDuration = MWBase::Environment::get().getFrameDuration();
+    performanceTimer += frameDuration;
+    performanceFrameTimeSum += frameDuration;
+    performanceFrameCount++;
+
+    if (performanceTimer >= reportInterval)
+    {
+        averageFrameTime = performanceFrameTimeSum / performanceFrameCount;
+        localActorCount = Main::get().getCellController()->getLocalActorCount();
+
+        performanceTimer = 0;
+        performanceFrameTimeSum = 0;
+        performanceFrameCount = 0;
+
+        getNetworking()->getPlayerPacket(ID_PLAYER_PERFORMANCE)->setPlayer(this);
+        getNetworking()->getPlayerPacket(ID_PLAYER_PERFORMANCE)->Send();
+    }
+}
+
 void LocalPlayer::updatePosition(bool forceUpdate)
 {
     MWBase::World *world = MWBase::Environment::get().getWorld();
@@ -397,6 +438,11 @@ void LocalPlayer::updatePosition(bool forceUpdate)
         if (!isJumping && !world->isOnGround(ptrPlayer) && !world->isFlying(ptrPlayer))
             isJumping = true;
 
+        // Nothing is sent while the player stands still, so the position the player stopped at has to arrive
+        if (posIsChanging)
+            getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setProperties(getMovementPacketProperties());
+        else
+            getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setProperties(getPacketProperties(ID_PLAYER_POSITION));
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
@@ -410,6 +456,7 @@ void LocalPlayer::updatePosition(bool forceUpdate)
     {
         sentJumpEnd = true;
         position = ptrPlayer.getRefData().getPosition();
+        getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setProperties(getPacketProperties(ID_PLAYER_POSITION));
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
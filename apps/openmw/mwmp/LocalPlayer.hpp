@@ -41,6 +41,7 @@ namespace mwmp
         void updateInventory(bool forceUpdate = false);
         void updateAttackOrCast();
         void updateAnimFlags(bool forceUpdate = false);
+        void updatePerformance();
 
         void addItems();
         void addSpells();
@@ -114,6 +115,11 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
+        // Frame times measured by updatePerformance() since the last ID_PLAYER_PERFORMANCE packet
+        float performanceTimer;
+        float performanceFrameTimeSum;
+        unsigned int performanceFrameCount;
+
     };
 }
 
@@ -0,0 +1,10 @@
+#ifndef OPENMW_MWPHYSICS_CONSTANTS_H
+#define OPENMW_MWPHYSICS_CONSTANTS_H
+
+namespace MWPhysics
+{
+    static const float sMaxSlope = 49.0f;
+    static const float sStepSizeUp = 34.0f;
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
 #include <components/misc/convert.hpp>
+#include <components/settings/settings.hpp>
 
 #include <components/nifosg/particle.hpp> // FindRecIndexVisitor
 
@@ -46,6 +47,7 @@
 #include "object.hpp"
 #include "heightfield.hpp"
 #include "hasspherecollisioncallback.hpp"
+#include "solverpool.hpp"
 
 namespace MWPhysics
 {
@@ -270,14 +272,45 @@ namespace MWPhysics
             }
         }
 
-        static osg::Vec3f move(osg::Vec3f position, const MWWorld::Ptr &ptr, Actor* physicActor, const osg::Vec3f &movement, float time,
-                                  bool isFlying, float waterlevel, float slowFall, const btCollisionWorld* collisionWorld,
-                               std::map<MWWorld::Ptr, MWWorld::Ptr>& standingCollisionTracker)
+        /// Advance acrobatics and decrease fatigue for a jump. This is done once per frame on the main thread, rather than in move().
+        static void jump(const MWWorld::Ptr &ptr)
         {
-            const ESM::Position& refpos = ptr.getRefData().getPosition();
+            const bool isPlayer = (ptr == MWMechanics::getPlayer());
+            // Advance acrobatics and set flag for GetPCJumping
+            if (isPlayer)
+            {
+                ptr.getClass().skillUsageSucceeded(ptr, ESM::Skill::Acrobatics, 0);
+                MWBase::Environment::get().getWorld()->getPlayer().setJumping(true);
+            }
+
+            // Decrease fatigue
+            if (!isPlayer || !MWBase::Environment::get().getWorld()->getGodModeState())
+            {
+                const MWWorld::Store<ESM::GameSetting> &gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+                const float fFatigueJumpBase = gmst.find("fFatigueJumpBase")->mValue.getFloat();
+                const float fFatigueJumpMult = gmst.find("fFatigueJumpMult")->mValue.getFloat();
+                const float normalizedEncumbrance = std::min(1.f, ptr.getClass().getNormalizedEncumbrance(ptr));
+                const float fatigueDecrease = fFatigueJumpBase + normalizedEncumbrance * fFatigueJumpMult;
+                MWMechanics::DynamicStat<float> fatigue = ptr.getClass().getCreatureStats(ptr).getFatigue();
+                fatigue.setCurrent(fatigue.getCurrent() - fatigueDecrease);
+                ptr.getClass().getCreatureStats(ptr).setFatigue(fatigue);
+            }
+            ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
+        }
+
+        /// @note Thread safe for different actors, as long as the collision world is not changed.
+        /// Only the actor's own state is changed, but not its position.
+        static osg::Vec3f move(osg::Vec3f position, ActorFrameData& data, float time, const WorldFrameData& worldData,
+                               const btCollisionWorld* collisionWorld)
+        {
+            Actor* physicActor = data.mActor;
+            const osg::Vec3f& movement = data.mMovement;
+            const bool isFlying = data.mFlying;
+            const float waterlevel = data.mWaterLevel;
+
             // Early-out for totally static creatures
             // (Not sure if gravity should still apply?)
-            if (!ptr.getClass().isMobile(ptr))
+            if (!data.mIsMobile)
                 return position;
 
             // Reset per-frame data
@@ -285,8 +318,8 @@ namespace MWPhysics
             // Anything to collide with?
             if(!physicActor->getCollisionMode())
             {
-                return position +  (osg::Quat(refpos.rot[0], osg::Vec3f(-1, 0, 0)) *
-                                    osg::Quat(refpos.rot[2], osg::Vec3f(0, 0, -1))
+                return position +  (osg::Quat(data.mRotX, osg::Vec3f(-1, 0, 0)) *
+                                    osg::Quat(data.mRotZ, osg::Vec3f(0, 0, -1))
                                     ) * movement * time;
             }
 
@@ -299,9 +332,7 @@ namespace MWPhysics
             // While this is strictly speaking wrong, it's needed for MW compatibility.
             position.z() += halfExtents.z();
 
-            static const float fSwimHeightScale = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                    .find("fSwimHeightScale")->mValue.getFloat();
-            float swimlevel = waterlevel + halfExtents.z() - (physicActor->getRenderingHalfExtents().z() * 2 * fSwimHeightScale);
+            float swimlevel = waterlevel + halfExtents.z() - (physicActor->getRenderingHalfExtents().z() * 2 * worldData.mSwimHeightScale);
 
             ActorTracer tracer;
 
@@ -310,12 +341,12 @@ namespace MWPhysics
 
             if(position.z() < swimlevel || isFlying)
             {
-                velocity = (osg::Quat(refpos.rot[0], osg::Vec3f(-1, 0, 0)) *
-                            osg::Quat(refpos.rot[2], osg::Vec3f(0, 0, -1))) * movement;
+                velocity = (osg::Quat(data.mRotX, osg::Vec3f(-1, 0, 0)) *
+                            osg::Quat(data.mRotZ, osg::Vec3f(0, 0, -1))) * movement;
             }
             else
             {
-                velocity = (osg::Quat(refpos.rot[2], osg::Vec3f(0, 0, -1))) * movement;
+                velocity = (osg::Quat(data.mRotZ, osg::Vec3f(0, 0, -1))) * movement;
 
                 if ((velocity.z() > 0.f && physicActor->getOnGround() && !physicActor->getOnSlope())
                  || (velocity.z() > 0.f && velocity.z() + inertia.z() <= -velocity.z() && physicActor->getOnSlope()))
@@ -325,42 +356,15 @@ namespace MWPhysics
             }
 
             // dead actors underwater will float to the surface, if the CharacterController tells us to do so
-            if (movement.z() > 0 && ptr.getClass().getCreatureStats(ptr).isDead() && position.z() < swimlevel)
+            if (movement.z() > 0 && data.mIsDead && position.z() < swimlevel)
                 velocity = osg::Vec3f(0,0,1) * 25;
 
-            if (ptr.getClass().getMovementSettings(ptr).mPosition[2])
-            {
-                const bool isPlayer = (ptr == MWMechanics::getPlayer());
-                // Advance acrobatics and set flag for GetPCJumping
-                if (isPlayer)
-                {
-                    ptr.getClass().skillUsageSucceeded(ptr, ESM::Skill::Acrobatics, 0);
-                    MWBase::Environment::get().getWorld()->getPlayer().setJumping(true);
-                }
-
-                // Decrease fatigue
-                if (!isPlayer || !MWBase::Environment::get().getWorld()->getGodModeState())
-                {
-                    const MWWorld::Store<ESM::GameSetting> &gmst = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-                    const float fFatigueJumpBase = gmst.find("fFatigueJumpBase")->mValue.getFloat();
-                    const float fFatigueJumpMult = gmst.find("fFatigueJumpMult")->mValue.getFloat();
-                    const float normalizedEncumbrance = std::min(1.f, ptr.getClass().getNormalizedEncumbrance(ptr));
-                    const float fatigueDecrease = fFatigueJumpBase + normalizedEncumbrance * fFatigueJumpMult;
-                    MWMechanics::DynamicStat<float> fatigue = ptr.getClass().getCreatureStats(ptr).getFatigue();
-                    fatigue.setCurrent(fatigue.getCurrent() - fatigueDecrease);
-                    ptr.getClass().getCreatureStats(ptr).setFatigue(fatigue);
-                }
-                ptr.getClass().getMovementSettings(ptr).mPosition[2] = 0;
-            }
-
             // Now that we have the effective movement vector, apply wind forces to it
-            if (MWBase::Environment::get().getWorld()->isInStorm())
+            if (worldData.mIsInStorm)
             {
-                osg::Vec3f stormDirection = MWBase::Environment::get().getWorld()->getStormDirection();
+                const osg::Vec3f& stormDirection = worldData.mStormDirection;
                 float angleDegrees = osg::RadiansToDegrees(std::acos(stormDirection * velocity / (stormDirection.length() * velocity.length())));
-                static const float fStromWalkMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                        .find("fStromWalkMult")->mValue.getFloat();
-                velocity *= 1.f-(fStromWalkMult * (angleDegrees/180.f));
+                velocity *= 1.f-(worldData.mStormWalkMult * (angleDegrees/180.f));
             }
 
             Stepper stepper(collisionWorld, colobj);
@@ -432,7 +436,7 @@ namespace MWPhysics
                 if (result)
                 {
                     // don't let pure water creatures move out of water after stepMove
-                    if (ptr.getClass().isPureWaterCreature(ptr)
+                    if (data.mIsPureWaterCreature
                             && newPosition.z() + halfExtents.z() > waterlevel)
                         newPosition = oldPosition;
                 }
@@ -469,7 +473,7 @@ namespace MWPhysics
                     const btCollisionObject* standingOn = tracer.mHitObject;
                     PtrHolder* ptrHolder = static_cast<PtrHolder*>(standingOn->getUserPointer());
                     if (ptrHolder)
-                        standingCollisionTracker[ptr] = ptrHolder->getPtr();
+                        data.mStandingOn = ptrHolder->getPtr();
 
                     if (standingOn->getBroadphaseHandle()->m_collisionFilterGroup == CollisionType_Water)
                         physicActor->setWalkingOnWater(true);
@@ -524,6 +528,27 @@ namespace MWPhysics
     };
 
 
+    /// @return The number of threads to move actors on in addition to the main thread
+    static std::size_t getNumSolverThreads()
+    {
+        const int wanted = std::max(0, Settings::Manager::getInt("movement solver threads", "Physics"));
+        if (wanted == 0)
+            return 0;
+
+        // Sweep tests on the same collision world can only run concurrently if Bullet was built with
+        // BT_THREADSAFE, which gives the broadphase a separate stack for each thread
+#if BT_BULLET_VERSION >= 287
+        btDbvtBroadphase broadphase;
+        if (broadphase.m_rayTestStacks.size() > 1)
+            return std::min<std::size_t>(wanted, broadphase.m_rayTestStacks.size() - 1);
+#endif
+        // Most Bullet builds are single threaded, so only warn about a value the user asked for, not the default
+        const bool userSet = Settings::Manager::mUserSettings.count(std::make_pair("Physics", "movement solver threads")) > 0;
+        Log(userSet ? Debug::Warning : Debug::Info)
+            << "Bullet was not built with multithreading support, actors are moved on the main thread only";
+        return 0;
+    }
+
     // ---------------------------------------------------------------
 
 
@@ -531,6 +556,9 @@ namespace MWPhysics
         : mShapeManager(new Resource::BulletShapeManager(resourceSystem->getVFS(), resourceSystem->getSceneManager(), resourceSystem->getNifFileManager()))
         , mResourceSystem(resourceSystem)
         , mDebugDrawEnabled(false)
+        , mActorFrameSteps(0)
+        , mAsyncState(Async_Idle)
+        , mAsyncShouldStop(false)
         , mTimeAccum(0.0f)
         , mWaterHeight(0)
         , mWaterEnabled(false)
@@ -560,10 +588,25 @@ namespace MWPhysics
                 Log(Debug::Warning) << "Warning: using custom physics framerate (" << physFramerate << " FPS).";
             }
         }
+
+        mSolverPool.reset(new SolverPool(getNumSolverThreads()));
+
+        if (Settings::Manager::getBool("async physics", "Physics"))
+            mAsyncThread = std::thread([this] { asyncWorker(); });
     }
 
     PhysicsSystem::~PhysicsSystem()
     {
+        if (mAsyncThread.joinable())
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mAsyncMutex);
+                mAsyncShouldStop = true;
+            }
+            mAsyncCondition.notify_all();
+            mAsyncThread.join();
+        }
+
         mResourceSystem->removeResourceManager(mShapeManager.get());
 
         if (mWaterCollisionObject.get())
@@ -1094,6 +1137,10 @@ namespace MWPhysics
         ActorMap::iterator foundActor = mActors.find(ptr);
         if (foundActor != mActors.end())
         {
+            const Actor* actor = foundActor->second;
+            mActorFrameData.erase(std::remove_if(mActorFrameData.begin(), mActorFrameData.end(),
+                [&] (const ActorFrameData& data) { return data.mActor == actor; }), mActorFrameData.end());
+
             delete foundActor->second;
             mActors.erase(foundActor);
         }
@@ -1135,6 +1182,14 @@ namespace MWPhysics
             mActors.insert(std::make_pair(updated, actor));
         }
 
+        for (ActorFrameData& data : mActorFrameData)
+        {
+            if (data.mPtr == old)
+                data.mPtr = updated;
+            if (data.mStandingOn == old)
+                data.mStandingOn = updated;
+        }
+
         updateCollisionMapPtr(mStandingCollisions, old, updated);
     }
 
@@ -1271,7 +1326,13 @@ namespace MWPhysics
 
     void PhysicsSystem::clearQueuedMovement()
     {
+        finishAsyncPhysics();
+        {
+            const std::lock_guard<std::mutex> lock(mAsyncMutex);
+            mAsyncState = Async_Idle;
+        }
         mMovementQueue.clear();
+        mActorFrameData.clear();
         mStandingCollisions.clear();
     }
 
@@ -1287,14 +1348,105 @@ namespace MWPhysics
 
         mTimeAccum -= numSteps * mPhysicsDt;
 
-        if (numSteps)
+        if (mAsyncThread.joinable())
         {
-            // Collision events should be available on every frame
-            mStandingCollisions.clear();
+            // If nothing was rendered since the last call, the actors have not been moved yet
+            startAsyncPhysics();
+            finishAsyncPhysics();
+
+            // Report where the actors were moved to during the last frame, then let them be moved for this one
+            for (const ActorFrameData& data : mActorFrameData)
+                addMovementResult(data);
+
+            gatherActorFrameData(numSteps);
+
+            const std::lock_guard<std::mutex> lock(mAsyncMutex);
+            mAsyncState = Async_Gathered;
         }
+        else
+        {
+            gatherActorFrameData(numSteps);
+            solveActorFrameData();
+            applyActorFrameData();
+
+            for (const ActorFrameData& data : mActorFrameData)
+                addMovementResult(data);
+        }
+
+        return mMovementResults;
+    }
+
+    void PhysicsSystem::startAsyncPhysics()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mAsyncMutex);
+            if (mAsyncState != Async_Gathered)
+                return;
+            mAsyncState = Async_Solving;
+        }
+        mAsyncCondition.notify_all();
+    }
+
+    void PhysicsSystem::finishAsyncPhysics()
+    {
+        std::exception_ptr exception;
+        {
+            std::unique_lock<std::mutex> lock(mAsyncMutex);
+            if (mAsyncState != Async_Solving && mAsyncState != Async_Solved)
+                return;
+            mAsyncCondition.wait(lock, [&] { return mAsyncState == Async_Solved; });
+            mAsyncState = Async_Idle;
+            std::swap(exception, mAsyncException);
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+
+        applyActorFrameData();
+    }
+
+    void PhysicsSystem::asyncWorker()
+    {
+        std::unique_lock<std::mutex> lock(mAsyncMutex);
+        while (true)
+        {
+            mAsyncCondition.wait(lock, [&] { return mAsyncShouldStop || mAsyncState == Async_Solving; });
+            if (mAsyncShouldStop)
+                return;
+
+            lock.unlock();
+            std::exception_ptr exception;
+            try
+            {
+                solveActorFrameData();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            lock.lock();
+
+            mAsyncException = exception;
+            mAsyncState = Async_Solved;
+            mAsyncCondition.notify_all();
+        }
+    }
+
+    void PhysicsSystem::gatherActorFrameData(int numSteps)
+    {
+        mActorFrameSteps = numSteps;
 
-        const MWWorld::Ptr player = MWMechanics::getPlayer();
         const MWBase::World *world = MWBase::Environment::get().getWorld();
+
+        static const float fSwimHeightScale = world->getStore().get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
+        static const float fStromWalkMult = world->getStore().get<ESM::GameSetting>().find("fStromWalkMult")->mValue.getFloat();
+
+        mWorldFrameData.mIsInStorm = world->isInStorm();
+        if (mWorldFrameData.mIsInStorm)
+            mWorldFrameData.mStormDirection = world->getStormDirection();
+        mWorldFrameData.mSwimHeightScale = fSwimHeightScale;
+        mWorldFrameData.mStormWalkMult = fStromWalkMult;
+
+        mActorFrameData.clear();
         PtrVelocityList::iterator iter = mMovementQueue.begin();
         for(;iter != mMovementQueue.end();++iter)
         {
@@ -1324,45 +1476,106 @@ namespace MWPhysics
             }
             physicActor->setCanWaterWalk(waterCollision);
 
+            const MWWorld::Ptr& ptr = iter->first;
+            const ESM::Position& refpos = ptr.getRefData().getPosition();
+
+            ActorFrameData data;
+            data.mPtr = ptr;
+            data.mActor = physicActor;
+            data.mMovement = iter->second;
+            data.mRotX = refpos.rot[0];
+            data.mRotZ = refpos.rot[2];
+            data.mWaterLevel = waterlevel;
             // Slow fall reduces fall speed by a factor of (effect magnitude / 200)
-            float slowFall = 1.f - std::max(0.f, std::min(1.f, effects.get(ESM::MagicEffect::SlowFall).getMagnitude() * 0.005f));
+            data.mSlowFall = 1.f - std::max(0.f, std::min(1.f, effects.get(ESM::MagicEffect::SlowFall).getMagnitude() * 0.005f));
+            data.mIsMobile = ptr.getClass().isMobile(ptr);
+            data.mIsDead = ptr.getClass().getCreatureStats(ptr).isDead();
+            data.mIsPureWaterCreature = ptr.getClass().isPureWaterCreature(ptr);
+            data.mFlying = world->isFlying(ptr);
+            data.mSwimming = world->isSwimming(ptr);
+            data.mWasOnGround = physicActor->getOnGround();
+            data.mOldHeight = physicActor->getPosition().z();
+            data.mPositionChanged = false;
+
+            if (numSteps > 0 && data.mIsMobile && physicActor->getCollisionMode()
+                    && ptr.getClass().getMovementSettings(ptr).mPosition[2])
+                MovementSolver::jump(ptr);
+
+            mActorFrameData.push_back(data);
+        }
 
-            bool flying = world->isFlying(iter->first);
-            bool swimming = world->isSwimming(iter->first);
+        mMovementQueue.clear();
+    }
 
-            bool wasOnGround = physicActor->getOnGround();
-            osg::Vec3f position = physicActor->getPosition();
-            float oldHeight = position.z();
-            bool positionChanged = false;
-            for (int i=0; i<numSteps; ++i)
+    void PhysicsSystem::solveActorFrameData()
+    {
+        // Moving an actor only reads the collision world, so all actors can be moved at the same time.
+        // Their new positions are applied afterwards, so each actor sees the others where they were before this frame.
+        const btCollisionWorld* collisionWorld = mCollisionWorld;
+        const WorldFrameData& worldData = mWorldFrameData;
+        const int numSteps = mActorFrameSteps;
+        const float physicsDt = mPhysicsDt;
+        mSolverPool->run(mActorFrameData.size(), [&] (std::size_t i)
+        {
+            ActorFrameData& data = mActorFrameData[i];
+            osg::Vec3f position = data.mActor->getPosition();
+            data.mLastStepStart = position;
+            for (int step=0; step<numSteps; ++step)
             {
-                position = MovementSolver::move(position, physicActor->getPtr(), physicActor, iter->second, mPhysicsDt,
-                                                flying, waterlevel, slowFall, mCollisionWorld, mStandingCollisions);
-                if (position != physicActor->getPosition())
-                    positionChanged = true;
-                physicActor->setPosition(position); // always set even if unchanged to make sure interpolation is correct
+                data.mLastStepStart = position;
+                position = MovementSolver::move(position, data, physicsDt, worldData, collisionWorld);
+                if (position != data.mLastStepStart)
+                    data.mPositionChanged = true;
             }
-            if (positionChanged)
+            data.mPosition = position;
+        });
+    }
+
+    void PhysicsSystem::applyActorFrameData()
+    {
+        const int numSteps = mActorFrameSteps;
+        if (numSteps)
+        {
+            // Collision events should be available on every frame
+            mStandingCollisions.clear();
+        }
+
+        const MWWorld::Ptr player = MWMechanics::getPlayer();
+
+        for (const ActorFrameData& data : mActorFrameData)
+        {
+            Actor* physicActor = data.mActor;
+
+            // always set even if unchanged to make sure interpolation is correct
+            if (numSteps > 1)
+                physicActor->setPosition(data.mLastStepStart);
+            if (numSteps > 0)
+                physicActor->setPosition(data.mPosition);
+
+            if (data.mPositionChanged)
                 mCollisionWorld->updateSingleAabb(physicActor->getCollisionObject());
 
-            float interpolationFactor = mTimeAccum / mPhysicsDt;
-            osg::Vec3f interpolated = position * interpolationFactor + physicActor->getPreviousPosition() * (1.f - interpolationFactor);
+            if (!data.mStandingOn.isEmpty())
+                mStandingCollisions[data.mPtr] = data.mStandingOn;
 
-            float heightDiff = position.z() - oldHeight;
+            float heightDiff = data.mPosition.z() - data.mOldHeight;
 
-            MWMechanics::CreatureStats& stats = iter->first.getClass().getCreatureStats(iter->first);
-            bool isStillOnGround = (numSteps > 0 && wasOnGround && physicActor->getOnGround());
-            if (isStillOnGround || flying || swimming || slowFall < 1)
-                stats.land(iter->first == player && (flying || swimming));
+            MWMechanics::CreatureStats& stats = data.mPtr.getClass().getCreatureStats(data.mPtr);
+            bool isStillOnGround = (numSteps > 0 && data.mWasOnGround && physicActor->getOnGround());
+            if (isStillOnGround || data.mFlying || data.mSwimming || data.mSlowFall < 1)
+                stats.land(data.mPtr == player && (data.mFlying || data.mSwimming));
             else if (heightDiff < 0)
                 stats.addToFallHeight(-heightDiff);
-
-            mMovementResults.push_back(std::make_pair(iter->first, interpolated));
         }
+    }
 
-        mMovementQueue.clear();
-
-        return mMovementResults;
+    void PhysicsSystem::addMovementResult(const ActorFrameData& data)
+    {
+        // The actor's position rather than the one it was moved to, in case it has been moved since, e.g. by a script
+        const Actor* physicActor = data.mActor;
+        float interpolationFactor = mTimeAccum / mPhysicsDt;
+        osg::Vec3f interpolated = physicActor->getPosition() * interpolationFactor + physicActor->getPreviousPosition() * (1.f - interpolationFactor);
+        mMovementResults.push_back(std::make_pair(data.mPtr, interpolated));
     }
 
     void PhysicsSystem::stepSimulation(float dt)
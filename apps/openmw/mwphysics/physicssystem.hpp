@@ -5,13 +5,20 @@
 #include <map>
 #include <set>
 #include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <osg/Quat>
+#include <osg/Vec3f>
 #include <osg/ref_ptr>
 
 #include "../mwworld/ptr.hpp"
 
 #include "collisiontype.hpp"
+#include "constants.hpp"
 
 namespace osg
 {
@@ -49,9 +56,41 @@ namespace MWPhysics
     class HeightField;
     class Object;
     class Actor;
+    class SolverPool;
 
-    static const float sMaxSlope = 49.0f;
-    static const float sStepSizeUp = 34.0f;
+    /// The state of the world that MovementSolver::move depends on, gathered on the main thread
+    struct WorldFrameData
+    {
+        bool mIsInStorm;
+        osg::Vec3f mStormDirection;
+        float mSwimHeightScale;
+        float mStormWalkMult;
+    };
+
+    /// Moving a single actor for one frame, so that actors can be moved on other threads.
+    /// The inputs are gathered on the main thread, and the results applied there afterwards.
+    struct ActorFrameData
+    {
+        MWWorld::Ptr mPtr;
+        Actor* mActor;
+        osg::Vec3f mMovement;
+        float mRotX;
+        float mRotZ;
+        float mWaterLevel;
+        float mSlowFall;
+        bool mIsMobile;
+        bool mIsDead;
+        bool mIsPureWaterCreature;
+        bool mFlying;
+        bool mSwimming;
+        bool mWasOnGround;
+        float mOldHeight;
+
+        osg::Vec3f mPosition;
+        osg::Vec3f mLastStepStart;
+        bool mPositionChanged;
+        MWWorld::Ptr mStandingOn;
+    };
 
     class PhysicsSystem
     {
@@ -151,8 +190,18 @@ namespace MWPhysics
             void queueObjectMovement(const MWWorld::Ptr &ptr, const osg::Vec3f &velocity);
 
             /// Apply all queued movements, then clear the list.
+            /// @note With async physics, the movements are only applied by the next call, and the positions
+            /// returned are those the actors were moved to during the previous frame.
             const PtrVelocityList& applyQueuedMovement(float dt);
 
+            /// With async physics, start moving the actors queued by the last applyQueuedMovement in the background.
+            /// @note No other function may be called until finishAsyncPhysics, so this is meant to bracket work
+            /// that does not use physics, i.e. rendering.
+            void startAsyncPhysics();
+
+            /// Wait for the actors to be moved and apply their new positions to the collision world.
+            void finishAsyncPhysics();
+
             /// Clear the queued movements list without applying.
             void clearQueuedMovement();
 
@@ -203,6 +252,13 @@ namespace MWPhysics
 
             void updateWater();
 
+            void asyncWorker();
+
+            void gatherActorFrameData(int numSteps);
+            void solveActorFrameData();
+            void applyActorFrameData();
+            void addMovementResult(const ActorFrameData& data);
+
             osg::ref_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
 
             btBroadphaseInterface* mBroadphase;
@@ -237,6 +293,27 @@ namespace MWPhysics
             PtrVelocityList mMovementQueue;
             PtrVelocityList mMovementResults;
 
+            WorldFrameData mWorldFrameData;
+            std::vector<ActorFrameData> mActorFrameData;
+            int mActorFrameSteps;
+            std::unique_ptr<SolverPool> mSolverPool;
+
+            enum AsyncState
+            {
+                Async_Idle,
+                Async_Gathered,
+                Async_Solving,
+                Async_Solved
+            };
+
+            // Moves the actors while the main thread renders, if async physics is enabled
+            std::thread mAsyncThread;
+            std::mutex mAsyncMutex;
+            std::condition_variable mAsyncCondition;
+            AsyncState mAsyncState;
+            bool mAsyncShouldStop;
+            std::exception_ptr mAsyncException;
+
             float mTimeAccum;
 
             float mWaterHeight;
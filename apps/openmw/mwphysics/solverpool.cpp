@@ -0,0 +1,115 @@
+#include "solverpool.hpp"
+
+namespace MWPhysics
+{
+    SolverPool::SolverPool(std::size_t numThreads)
+        : mJob(nullptr)
+        , mCount(0)
+        , mNext(0)
+        , mFinishedThreads(0)
+        , mGeneration(0)
+        , mShouldStop(false)
+    {
+        for (std::size_t i = 0; i < numThreads; ++i)
+            mThreads.emplace_back([this] { worker(); });
+    }
+
+    SolverPool::~SolverPool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    std::size_t SolverPool::getNumThreads() const
+    {
+        return mThreads.size();
+    }
+
+    void SolverPool::run(std::size_t count, const Job& job)
+    {
+        if (mThreads.empty() || count <= 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                job(i);
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mJob = &job;
+            mCount = count;
+            mNext = 0;
+            mFinishedThreads = 0;
+            mException = nullptr;
+            ++mGeneration;
+        }
+        mHasJob.notify_all();
+
+        std::exception_ptr exception;
+        try
+        {
+            work(job, count);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+            // Let the workers skip the remaining indices
+            mNext = count;
+        }
+
+        // Every worker takes part in every job, so that none can still be working on this one when the next one starts
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobDone.wait(lock, [&] { return mFinishedThreads == mThreads.size(); });
+        mJob = nullptr;
+
+        if (!exception)
+            exception = mException;
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    void SolverPool::worker()
+    {
+        unsigned int generation = 0;
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mHasJob.wait(lock, [&] { return mShouldStop || mGeneration != generation; });
+            if (mShouldStop)
+                return;
+
+            generation = mGeneration;
+            const Job& job = *mJob;
+            const std::size_t count = mCount;
+
+            lock.unlock();
+            std::exception_ptr exception;
+            try
+            {
+                work(job, count);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+                mNext = count;
+            }
+            lock.lock();
+
+            if (exception && !mException)
+                mException = exception;
+            if (++mFinishedThreads == mThreads.size())
+                mJobDone.notify_one();
+        }
+    }
+
+    void SolverPool::work(const Job& job, std::size_t count)
+    {
+        for (std::size_t i = mNext++; i < count; i = mNext++)
+            job(i);
+    }
+}
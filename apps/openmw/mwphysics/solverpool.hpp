@@ -0,0 +1,54 @@
+#ifndef OPENMW_MWPHYSICS_SOLVERPOOL_H
+#define OPENMW_MWPHYSICS_SOLVERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MWPhysics
+{
+    /// @brief Worker threads that help the calling thread to run a job for each index of a range.
+    class SolverPool
+    {
+        public:
+            typedef std::function<void(std::size_t)> Job;
+
+            /// @param numThreads Number of worker threads in addition to the calling thread
+            explicit SolverPool(std::size_t numThreads);
+            ~SolverPool();
+
+            std::size_t getNumThreads() const;
+
+            /// Call job(i) for each i in [0, count) and wait until all calls have returned.
+            /// @note The calls run concurrently and in no particular order, so each call must only write
+            /// to data belonging to its own index.
+            /// @note An exception thrown by a call is passed on once all calls have returned.
+            void run(std::size_t count, const Job& job);
+
+        private:
+            void worker();
+
+            void work(const Job& job, std::size_t count);
+
+            std::vector<std::thread> mThreads;
+
+            std::mutex mMutex;
+            std::condition_variable mHasJob;
+            std::condition_variable mJobDone;
+
+            const Job* mJob;
+            std::size_t mCount;
+            std::atomic<std::size_t> mNext;
+            std::size_t mFinishedThreads;
+            unsigned int mGeneration;
+            bool mShouldStop;
+            std::exception_ptr mException;
+    };
+}
+
+#endif
@@ -655,6 +655,12 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    void Animation::setUpdateInterval(unsigned int interval)
+    {
+        if (mSkeleton)
+            mSkeleton->setUpdateInterval(interval);
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr &ptr)
     {
         mPtr = ptr;
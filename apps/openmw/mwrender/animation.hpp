@@ -351,6 +351,10 @@ public:
     /// 0 = Inactive, 1 = Active in place, 2 = Active
     void setActive(int active);
 
+    /// Set the number of frames between updates of the object skeleton, if one exists.
+    /// @see SceneUtil::Skeleton::setUpdateInterval
+    void setUpdateInterval(unsigned int interval);
+
     osg::Group* getOrCreateObjectRoot();
 
     osg::Group* getObjectRoot();
@@ -82,6 +82,26 @@ namespace MWScript
                 }
         };
 
+        class OpTestTerrainFlight : public Interpreter::Opcode0
+        {
+            public:
+
+                virtual void execute (Interpreter::Runtime& runtime)
+                {
+                    if (MWBase::Environment::get().getStateManager()->getState() != MWBase::StateManager::State_Running)
+                    {
+                        runtime.getContext().report("Use TestTerrainFlight in an active game session.");
+                        return;
+                    }
+
+                    // The game is paused while the console is open
+                    if (MWBase::Environment::get().getWindowManager()->isConsoleMode())
+                        MWBase::Environment::get().getWindowManager()->toggleConsole();
+
+                    MWBase::Environment::get().getWorld()->testTerrainFlight();
+                }
+        };
+
         class OpCOC : public Interpreter::Opcode0
         {
             public:
@@ -254,6 +274,7 @@ namespace MWScript
             interpreter.installSegment5 (Compiler::Cell::opcodeCellChanged, new OpCellChanged);
             interpreter.installSegment5 (Compiler::Cell::opcodeTestCells, new OpTestCells);
             interpreter.installSegment5 (Compiler::Cell::opcodeTestInteriorCells, new OpTestInteriorCells);
+            interpreter.installSegment5 (Compiler::Cell::opcodeTestTerrainFlight, new OpTestTerrainFlight);
             interpreter.installSegment5 (Compiler::Cell::opcodeCOC, new OpCOC);
             interpreter.installSegment5 (Compiler::Cell::opcodeCOE, new OpCOE);
             interpreter.installSegment5 (Compiler::Cell::opcodeGetInterior, new OpGetInterior);
@@ -1,5 +1,6 @@
 #include "cellpreloader.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
 
@@ -12,6 +13,7 @@
 #include <components/misc/stringops.hpp>
 #include <components/terrain/world.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
+#include <components/vfs/manager.hpp>
 #include <components/esm/loadcell.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -43,6 +45,44 @@ namespace MWWorld
         std::vector<std::string>& mOut;
     };
 
+    /// Worker thread item: prepare some of a cell's model files for loading, so that decompressing
+    /// them from archives is spread over all worker threads instead of being done by the PreloadItem.
+    class PrefetchItem : public SceneUtil::WorkItem
+    {
+    public:
+        PrefetchItem(const VFS::Manager* vfs, std::vector<std::string>::const_iterator begin, std::vector<std::string>::const_iterator end)
+            : mVFS(vfs)
+            , mFiles(begin, end)
+            , mAbort(false)
+        {
+        }
+
+        virtual void abort()
+        {
+            mAbort = true;
+        }
+
+        virtual void doWork()
+        {
+            if (mAbort)
+                return;
+
+            try
+            {
+                mVFS->prefetch(mFiles);
+            }
+            catch (std::exception& e)
+            {
+                // errors will be shown when the files are actually loaded
+            }
+        }
+
+    private:
+        const VFS::Manager* mVFS;
+        std::vector<std::string> mFiles;
+        std::atomic<bool> mAbort;
+    };
+
     /// Worker thread item: preload models in a cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
@@ -82,9 +122,28 @@ namespace MWWorld
             }
         }
 
+        /// Split the model files up into PrefetchItems, to be queued ahead of this item. There are none
+        /// unless a compressed archive is registered, since prefetching does nothing for other files.
+        /// @note Call from the main thread before queueing this item.
+        std::vector<osg::ref_ptr<PrefetchItem> > createPrefetchItems()
+        {
+            if (!mSceneManager->getVFS()->canPrefetch())
+                return mPrefetchItems;
+
+            const size_t filesPerItem = 16;
+            for (size_t i = 0; i < mMeshes.size(); i += filesPerItem)
+            {
+                size_t end = std::min(i + filesPerItem, mMeshes.size());
+                mPrefetchItems.push_back(new PrefetchItem(mSceneManager->getVFS(), mMeshes.begin() + i, mMeshes.begin() + end));
+            }
+            return mPrefetchItems;
+        }
+
         virtual void abort()
         {
             mAbort = true;
+            for (osg::ref_ptr<PrefetchItem>& item : mPrefetchItems)
+                item->abort();
         }
 
         /// Preload work to be called from the worker thread.
@@ -161,6 +220,8 @@ namespace MWWorld
 
         std::atomic<bool> mAbort;
 
+        std::vector<osg::ref_ptr<PrefetchItem> > mPrefetchItems;
+
         osg::ref_ptr<Terrain::View> mTerrainView;
 
         // keep a ref to the loaded objects to make sure it stays loaded as long as this cell is in the preloaded state
@@ -308,6 +369,8 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        for (const osg::ref_ptr<PrefetchItem>& prefetchItem : item->createPrefetchItems())
+            mWorkQueue->addWorkItem(prefetchItem);
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
@@ -131,7 +131,8 @@ MWWorld::ContainerStore::ContainerStore()
     : mListener(nullptr)
     , mRechargingItemsUpToDate(false)
     , mCachedWeight (0)
-    , mWeightUpToDate (false) {}
+    , mWeightUpToDate (false)
+    , mRevision (0) {}
 
 MWWorld::ContainerStore::~ContainerStore() {}
 
@@ -753,6 +754,12 @@ void MWWorld::ContainerStore::flagAsModified()
 {
     mWeightUpToDate = false;
     mRechargingItemsUpToDate = false;
+    ++mRevision;
+}
+
+unsigned int MWWorld::ContainerStore::getRevision() const
+{
+    return mRevision;
 }
 
 float MWWorld::ContainerStore::getWeight() const
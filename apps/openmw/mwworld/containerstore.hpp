@@ -98,6 +98,7 @@ namespace MWWorld
 
             mutable float mCachedWeight;
             mutable bool mWeightUpToDate;
+            unsigned int mRevision;
             ContainerStoreIterator addImp (const Ptr& ptr, int count);
             void addInitialItem (const std::string& id, const std::string& owner, int count, bool topLevel=true, const std::string& levItem = "");
             void addInitialItemImp (const MWWorld::Ptr& ptr, const std::string& owner, int count, bool topLevel=true, const std::string& levItem = "");
@@ -206,6 +207,9 @@ namespace MWWorld
             float getWeight() const;
             ///< Return total weight of the items contained in *this.
 
+            unsigned int getRevision() const;
+            ///< Return a number that changes whenever the items or the equipment change.
+
             static int getType (const ConstPtr& ptr);
             ///< This function throws an exception, if ptr does not point to an object, that can be
             /// put into a container.
@@ -1,17 +1,70 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
 #include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+namespace
+{
+  // Increase when the layout of the content cache or the records in it change
+  const int sCacheFormat = 3;
+
+  const uint32_t sCacheKey = ESM::FourCC<'C','K','E','Y'>::value;
+
+  // Only the start of each content file, which holds its header, and its end are checksummed for the cache key,
+  // because reading whole files would cost about as much as the parsing the cache saves
+  const std::streamsize sChecksumBlockSize = 64 * 1024;
+
+  uint32_t getContentChecksum(const boost::filesystem::path& path, uint64_t size)
+  {
+    boost::filesystem::ifstream stream(path, std::ios::binary);
+    std::vector<char> buffer(sChecksumBlockSize);
+    boost::crc_32_type checksum;
+
+    stream.read(buffer.data(), sChecksumBlockSize);
+    checksum.process_bytes(buffer.data(), static_cast<std::size_t>(stream.gcount()));
+
+    if (size > static_cast<uint64_t>(sChecksumBlockSize))
+    {
+      stream.clear();
+      stream.seekg(static_cast<std::streamoff>(std::max(size - sChecksumBlockSize, static_cast<uint64_t>(sChecksumBlockSize))));
+      stream.read(buffer.data(), sChecksumBlockSize);
+      checksum.process_bytes(buffer.data(), static_cast<std::size_t>(stream.gcount()));
+    }
+
+    if (stream.bad())
+      throw std::runtime_error("Failed to read " + path.string());
+
+    return checksum.checksum();
+  }
+}
 
 namespace MWWorld
 {
 
 EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
-  ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener)
+  ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, bool useCache)
   : ContentLoader(listener)
   , mEsm(readers)
   , mStore(store)
   , mEncoder(encoder)
+  , mUseCache(useCache)
 {
 }
 
@@ -25,7 +78,235 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
   lEsm.setGlobalReaderList(&mEsm);
   lEsm.open(filepath.string());
   mEsm[index] = lEsm;
-  mStore.load(mEsm[index], &mListener);
+  mStore.prepareLoad(mEsm[index]);
+
+  File file = {filepath, index, 0, 0, mEsm[index].getRecordCount(), 0};
+
+  // Don't read the files again for the cache key unless the cache is used
+  if (mUseCache)
+  {
+    file.mSize = boost::filesystem::file_size(filepath);
+    file.mModified = static_cast<int64_t>(boost::filesystem::last_write_time(filepath));
+    file.mChecksum = getContentChecksum(filepath, file.mSize);
+  }
+
+  mFiles.push_back(file);
+}
+
+void EsmLoader::loadRecords()
+{
+  const size_t fileCount = mFiles.size();
+
+  std::vector<ESMStore::ParsedFile> parsedFiles(fileCount);
+  std::vector<std::exception_ptr> errors(fileCount);
+  std::vector<bool> parsed(fileCount, false);
+  std::mutex mutex;
+  std::condition_variable fileParsed;
+  std::atomic<size_t> nextFile(0);
+  std::atomic<bool> aborted(false);
+
+  auto parseFiles = [&] ()
+  {
+    // The encoder keeps a conversion buffer, so every thread needs its own
+    std::unique_ptr<ToUTF8::Utf8Encoder> encoder(mEncoder ? new ToUTF8::Utf8Encoder(*mEncoder) : nullptr);
+
+    for (size_t i = nextFile++; i < fileCount && !aborted; i = nextFile++)
+    {
+      ESM::ESMReader& esm = mEsm[mFiles[i].mIndex];
+      esm.setEncoder(encoder.get());
+
+      try
+      {
+        mStore.parse(esm, parsedFiles[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+
+      esm.setEncoder(mEncoder);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        parsed[i] = true;
+      }
+      fileParsed.notify_all();
+    }
+  };
+
+  const size_t threadCount = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), fileCount));
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadCount; ++i)
+    threads.emplace_back(parseFiles);
+
+  auto joinThreads = [&] ()
+  {
+    for (std::thread& thread : threads)
+      thread.join();
+  };
+
+  try
+  {
+    for (size_t i = 0; i < fileCount; ++i)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        fileParsed.wait(lock, [&] { return parsed[i]; });
+      }
+
+      if (errors[i])
+        std::rethrow_exception(errors[i]);
+
+      mListener.setLabel(MyGUI::TextIterator::toTagsString(mFiles[i].mPath.filename().string()));
+      mStore.merge(mEsm[mFiles[i].mIndex], parsedFiles[i], &mListener);
+      ESMStore::ParsedFile().swap(parsedFiles[i]);
+    }
+  }
+  catch (...)
+  {
+    aborted = true;
+    joinThreads();
+    throw;
+  }
+
+  joinThreads();
+}
+
+int EsmLoader::getEncoding() const
+{
+  return mEncoder ? static_cast<int>(mEncoder->getEncoding()) : -1;
+}
+
+bool EsmLoader::loadCache(const boost::filesystem::path& path)
+{
+  if (!boost::filesystem::exists(path))
+    return false;
+
+  ESM::ESMReader reader;
+
+  // Check the key before anything is added to the store, so that an outdated cache can simply be ignored
+  try
+  {
+    reader.open(path.string());
+
+    bool matches = reader.getFormat() == sCacheFormat && reader.getGameFiles().size() == mFiles.size();
+    for (size_t i = 0; matches && i < mFiles.size(); ++i)
+    {
+      const ESM::Header::MasterData& master = reader.getGameFiles()[i];
+      matches = master.name == mFiles[i].mPath.string() && master.size == mFiles[i].mSize;
+    }
+
+    if (matches)
+    {
+      if (reader.getRecName() != sCacheKey)
+        reader.fail("Missing cache key");
+      reader.getRecHeader();
+
+      int encoding = 0;
+      reader.getHNT(encoding, "ENCO");
+      matches = encoding == getEncoding();
+
+      for (size_t i = 0; matches && i < mFiles.size(); ++i)
+      {
+        int64_t modified = 0;
+        reader.getHNT(modified, "MTIM");
+        int recordCount = 0;
+        reader.getHNT(recordCount, "NREC");
+        uint32_t checksum = 0;
+        reader.getHNT(checksum, "CRCS");
+        matches = modified == mFiles[i].mModified && recordCount == mFiles[i].mRecordCount
+            && checksum == mFiles[i].mChecksum;
+      }
+    }
+
+    if (!matches)
+    {
+      Log(Debug::Info) << "Content cache " << path << " is out of date";
+      return false;
+    }
+
+    reader.skipRecord();
+  }
+  catch (const std::exception& e)
+  {
+    Log(Debug::Warning) << "Warning: Failed to open content cache " << path << ": " << e.what();
+    return false;
+  }
+
+  try
+  {
+    mStore.readCache(reader);
+  }
+  catch (const std::exception& e)
+  {
+    // Some of the records may have been added already, drop them before the content files are parsed
+    mStore.clearCache();
+    Log(Debug::Warning) << "Warning: Failed to load content cache " << path << ", loading the content files instead: "
+                        << e.what();
+    return false;
+  }
+
+  Log(Debug::Info) << "Loaded content cache " << path;
+  return true;
+}
+
+void EsmLoader::writeCache(const boost::filesystem::path& path) const
+{
+  try
+  {
+    // Write to a memory stream first, so that a failed write can't leave a partial cache behind
+    std::stringstream stream;
+
+    ESM::ESMWriter writer;
+    writer.setFormat(sCacheFormat);
+    writer.setVersion(0);
+    writer.setType(0);
+    writer.setAuthor("");
+    writer.setDescription("");
+
+    for (const File& file : mFiles)
+      writer.addMaster(file.mPath.string(), file.mSize);
+
+    writer.save(stream);
+
+    writer.startRecord(sCacheKey);
+    writer.writeHNT("ENCO", getEncoding());
+    for (const File& file : mFiles)
+    {
+      writer.writeHNT("MTIM", file.mModified);
+      writer.writeHNT("NREC", file.mRecordCount);
+      writer.writeHNT("CRCS", file.mChecksum);
+    }
+    writer.endRecord(sCacheKey);
+
+    mStore.writeCache(writer);
+
+    writer.close();
+
+    if (stream.fail())
+      throw std::runtime_error("Write operation failed (memory stream)");
+
+    boost::filesystem::create_directories(path.parent_path());
+
+    boost::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+      boost::filesystem::ofstream file(tempPath, std::ios::binary);
+      file << stream.rdbuf();
+
+      if (file.fail())
+        throw std::runtime_error("Write operation failed (file stream)");
+    }
+
+    boost::filesystem::rename(tempPath, path);
+
+    Log(Debug::Info) << "Wrote content cache " << path;
+  }
+  catch (const std::exception& e)
+  {
+    Log(Debug::Warning) << "Warning: Failed to write content cache " << path << ": " << e.what();
+  }
 }
 
 } /* namespace MWWorld */
@@ -1,6 +1,7 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <cstdint>
 #include <vector>
 
 #include "contentloader.hpp"
@@ -22,15 +23,45 @@ class ESMStore;
 
 struct EsmLoader : public ContentLoader
 {
+    /// \param useCache Collect the cache key of the content files, for loadCache() and writeCache()
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
-      ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener);
+      ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, bool useCache);
 
+    /// Open the content file. Its records are only loaded by loadRecords().
     void load(const boost::filesystem::path& filepath, int& index);
 
+    /// Read the records of all opened content files on worker threads, then add them to the store
+    /// in load order as each file is ready.
+    void loadRecords();
+
+    /// Load the records that are kept in the content cache at \a path, if it was written for the same
+    /// content files in the same order, with the same sizes, modification times, record counts, checksums
+    /// and encoding. Has to be called after all content files have been opened, but before loadRecords().
+    /// A cache that fails to load is discarded, so that loadRecords() loads the content files instead.
+    /// \return Was the cache loaded?
+    bool loadCache(const boost::filesystem::path& path);
+
+    /// Write the content cache for the opened content files, once the store has been set up.
+    void writeCache(const boost::filesystem::path& path) const;
+
     private:
+      struct File
+      {
+          boost::filesystem::path mPath;
+          int mIndex;
+          uint64_t mSize;
+          int64_t mModified;
+          int mRecordCount;
+          uint32_t mChecksum;
+      };
+
+      int getEncoding() const;
+
       std::vector<ESM::ESMReader>& mEsm;
       MWWorld::ESMStore& mStore;
       ToUTF8::Utf8Encoder* mEncoder;
+      bool mUseCache;
+      std::vector<File> mFiles;
 };
 
 } /* namespace MWWorld */
@@ -26,12 +26,8 @@ static bool isCacheableRecord(int id)
     return false;
 }
 
-void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+void ESMStore::prepareLoad(ESM::ESMReader &esm)
 {
-    listener->setProgressRange(1000);
-
-    ESM::Dialogue *dialogue = 0;
-
     // Land texture loading needs to use a separate internal store for each plugin.
     // We set the number of plugins here to avoid continual resizes during loading,
     // and so we can properly verify if valid plugin indices are being passed to the
@@ -42,6 +38,7 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
     // Cache parent esX files by tracking their indices in the global list of
     //  all files/readers used by the engine. This will greaty accelerate
     //  refnumber mangling, as required for handling moved references.
+    // Only the names of the other readers are used, because they may be parsing on other threads.
     const std::vector<ESM::Header::MasterData> &masters = esm.getGameFiles();
     std::vector<ESM::ESMReader> *allPlugins = esm.getGlobalReaderList();
     for (size_t j = 0; j < masters.size(); j++) {
@@ -49,7 +46,7 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         std::string fname = mast.name;
         int index = ~0;
         for (int i = 0; i < esm.getIndex(); i++) {
-            const std::string candidate = allPlugins->at(i).getContext().filename;
+            const std::string candidate = allPlugins->at(i).getName();
             std::string fnamecandidate = boost::filesystem::path(candidate).filename().string();
             if (Misc::StringUtils::ciEqual(fname, fnamecandidate)) {
                 index = i;
@@ -65,57 +62,164 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         }
         mast.index = index;
     }
+}
 
-    // Loop through all records
-    while(esm.hasMoreRecs())
-    {
-        ESM::NAME n = esm.getRecName();
-        esm.getRecHeader();
+void ESMStore::loadRecord(ESM::ESMReader &esm, ESM::Dialogue *&dialogue)
+{
+    ESM::NAME n = esm.getRecName();
+    esm.getRecHeader();
 
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
 
-        if (it == mStores.end()) {
-            if (n.intval == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.intval == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.intval == ESM::REC_SKIL) {
-                mSkills.load (esm);
+    if (it == mStores.end()) {
+        if (n.intval == ESM::REC_INFO) {
+            if (dialogue)
+            {
+                dialogue->readInfo(esm, esm.getIndex() != 0);
             }
-            else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+            else
             {
-                // ignore project file only records
+                Log(Debug::Error) << "Error: info record without dialog";
                 esm.skipRecord();
             }
-            else {
-                std::stringstream error;
-                error << "Unknown record: " << n.toString();
-                throw std::runtime_error(error.str());
-            }
+        } else if (n.intval == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (n.intval == ESM::REC_SKIL) {
+            mSkills.load (esm);
+        }
+        else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+        }
+        else {
+            std::stringstream error;
+            error << "Unknown record: " << n.toString();
+            throw std::runtime_error(error.str());
+        }
+    } else {
+        RecordId id = it->second->load(esm);
+        if (id.mIsDeleted)
+        {
+            it->second->eraseStatic(id.mId);
+            return;
+        }
+
+        if (n.intval==ESM::REC_DIAL) {
+            dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
         } else {
-            RecordId id = it->second->load(esm);
-            if (id.mIsDeleted)
-            {
-                it->second->eraseStatic(id.mId);
-                continue;
-            }
+            dialogue = 0;
+        }
+    }
+}
 
-            if (n.intval==ESM::REC_DIAL) {
-                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
+void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+{
+    listener->setProgressRange(1000);
+
+    prepareLoad(esm);
+
+    ESM::Dialogue *dialogue = 0;
+
+    // Loop through all records
+    while(esm.hasMoreRecs())
+    {
+        loadRecord(esm, dialogue);
+        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+    }
+}
+
+namespace
+{
+    struct ParsedInfo : public StagedRecord
+    {
+        ESM::DialInfo mInfo;
+        bool mIsDeleted = false;
+    };
+}
+
+void ESMStore::parse(ESM::ESMReader &esm, ParsedFile &file) const
+{
+    // Reused so that saving the position of every record doesn't allocate
+    ESM::ESM_Context context;
+
+    while(esm.hasMoreRecs())
+    {
+        ParsedRecord record;
+        context = esm.getContext();
+
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+        record.mType = n.intval;
+
+        if (mCacheLoaded && isCachedRecord(n.intval))
+        {
+            esm.skipRecord();
+            continue;
+        }
+
+        if (n.intval == ESM::REC_INFO)
+        {
+            ParsedInfo *info = new ParsedInfo;
+            record.mRecord.reset(info);
+            info->mInfo.load(esm, info->mIsDeleted);
+        }
+        else
+        {
+            std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+            if (it != mStores.end())
+                record.mRecord = it->second->parse(esm);
+        }
+
+        // Everything else is loaded by merge() in the same way as by load()
+        if (!record.mRecord)
+        {
+            esm.skipRecord();
+            record.mContext = context;
+        }
+
+        file.push_back(std::move(record));
+    }
+}
+
+void ESMStore::merge(ESM::ESMReader &esm, ParsedFile &file, Loading::Listener* listener)
+{
+    listener->setProgressRange(1000);
+
+    ESM::Dialogue *dialogue = 0;
+
+    for (size_t i = 0; i < file.size(); ++i)
+    {
+        ParsedRecord &record = file[i];
+
+        if (!record.mRecord)
+        {
+            esm.restoreContext(record.mContext);
+            loadRecord(esm, dialogue);
+        }
+        else if (record.mType == ESM::REC_INFO)
+        {
+            ParsedInfo &info = static_cast<ParsedInfo&>(*record.mRecord);
+            if (dialogue)
+                dialogue->addInfo(info.mInfo, info.mIsDeleted, esm.getIndex() != 0);
+            else
+                Log(Debug::Error) << "Error: info record without dialog";
+        }
+        else
+        {
+            StoreBase *store = mStores.find(record.mType)->second;
+            RecordId id = store->insertParsed(*record.mRecord);
+            if (id.mIsDeleted)
+                store->eraseStatic(id.mId);
+            else
                 dialogue = 0;
-            }
         }
-        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+
+        // Parsed records aren't needed any more once they have been copied into the store
+        record.mRecord.reset();
+
+        listener->setProgress(static_cast<size_t>((i + 1) / (float)file.size() * 1000));
     }
 }
 
@@ -141,7 +245,7 @@ void ESMStore::setUp(bool validateRecords)
     mAttributes.setUp();
     mDialogs.setUp();
 
-    if (validateRecords)
+    if (validateRecords && !mCacheLoaded)
         validate();
 }
 
@@ -297,6 +401,77 @@ void ESMStore::validate()
         mCreatureLists.write (writer, progress);
     }
 
+    bool ESMStore::isCachedRecord(int type) const
+    {
+        if (type == ESM::REC_INFO)
+            return true;
+
+        if (type == ESM::REC_CELL || type == ESM::REC_LAND || type == ESM::REC_LTEX || type == ESM::REC_PGRD)
+            return false;
+
+        return mStores.find(type) != mStores.end();
+    }
+
+    void ESMStore::writeCache (ESM::ESMWriter& writer) const
+    {
+        writer.startRecord(ESM::REC_DYNA);
+        writer.startSubRecord("COUN");
+        writer.writeT(mDynamicCount);
+        writer.endRecord("COUN");
+        writer.endRecord(ESM::REC_DYNA);
+
+        for (std::map<int, StoreBase *>::const_iterator it = mStores.begin(); it != mStores.end(); ++it)
+            it->second->writeStatic (writer);
+    }
+
+    void ESMStore::readCache (ESM::ESMReader& reader)
+    {
+        ESM::Dialogue *dialogue = 0;
+
+        while (reader.hasMoreRecs())
+        {
+            ESM::NAME n = reader.getRecName();
+            reader.getRecHeader();
+
+            if (n.intval == ESM::REC_DYNA)
+            {
+                reader.getHNT(mDynamicCount, "COUN");
+            }
+            else if (n.intval == ESM::REC_INFO)
+            {
+                if (!dialogue)
+                    reader.fail("Info record without dialog");
+
+                dialogue->readInfo(reader, false);
+            }
+            else
+            {
+                std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+                if (it == mStores.end() || !isCachedRecord(n.intval))
+                    reader.fail("Unexpected record: " + n.toString());
+
+                RecordId id = it->second->readStatic(reader);
+
+                if (n.intval == ESM::REC_DIAL)
+                    dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+            }
+        }
+
+        mCacheLoaded = true;
+    }
+
+    void ESMStore::clearCache()
+    {
+        for (std::map<int, StoreBase *>::iterator it = mStores.begin(); it != mStores.end(); ++it)
+        {
+            if (isCachedRecord(it->first))
+                it->second->clearStatic();
+        }
+
+        mDynamicCount = 0;
+        mCacheLoaded = false;
+    }
+
     bool ESMStore::readRecord (ESM::ESMReader& reader, uint32_t type)
     {
         switch (type)
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <stdexcept>
 
+#include <components/esm/esmcommon.hpp>
 #include <components/esm/records.hpp>
 #include "store.hpp"
 
@@ -74,9 +75,16 @@ namespace MWWorld
 
         unsigned int mDynamicCount;
 
+        bool mCacheLoaded;
+
         /// Validate entries in store after setup
         void validate();
 
+        void loadRecord(ESM::ESMReader &esm, ESM::Dialogue *&dialogue);
+
+        /// Is the record type written by writeCache()?
+        bool isCachedRecord(int type) const;
+
     public:
         /// \todo replace with SharedIterator<StoreBase>
         typedef std::map<int, StoreBase *>::const_iterator iterator;
@@ -102,6 +110,7 @@ namespace MWWorld
 
         ESMStore()
           : mDynamicCount(0)
+          , mCacheLoaded(false)
         {
             mStores[ESM::REC_ACTI] = &mActivators;
             mStores[ESM::REC_ALCH] = &mPotions;
@@ -163,6 +172,28 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /// A record read by parse(), or the position to load it from in merge() when it can't be read
+        /// out of order
+        struct ParsedRecord
+        {
+            int mType;
+            std::unique_ptr<StagedRecord> mRecord;
+            ESM::ESM_Context mContext;
+        };
+
+        typedef std::vector<ParsedRecord> ParsedFile;
+
+        /// Set up the stores for another content file and find the indices of its masters.
+        /// Has to be called for each content file in load order before parse().
+        void prepareLoad(ESM::ESMReader &esm);
+
+        /// Read the records of a content file without modifying the store. Different content files
+        /// can be parsed at the same time, as long as each has its own reader and encoder.
+        void parse(ESM::ESMReader &esm, ParsedFile &file) const;
+
+        /// Add the records of a content file returned by parse(). Files have to be merged in load order.
+        void merge(ESM::ESMReader &esm, ParsedFile &file, Loading::Listener* listener);
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -239,6 +270,20 @@ namespace MWWorld
 
         bool readRecord (ESM::ESMReader& reader, uint32_t type);
         ///< \return Known type?
+
+        /// Write the records loaded from the content files, except for the ones that are read on demand
+        /// from the content files later on (cells, landscape, land textures, path grids, magic effects and
+        /// skills). Has to be called after setUp(true).
+        void writeCache (ESM::ESMWriter& writer) const;
+
+        /// Read the records written by writeCache(). The records of the content files that are in the
+        /// cache are skipped when the content files are loaded afterwards, and setUp() doesn't need to
+        /// validate them again.
+        void readCache (ESM::ESMReader& reader);
+
+        /// Remove the records read by readCache(), so that the content files can be loaded without it
+        /// after the cache turned out to be broken.
+        void clearCache();
     };
 
     /*
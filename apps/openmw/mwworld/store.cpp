@@ -8,6 +8,7 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace
@@ -136,16 +137,16 @@ namespace MWWorld
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end()) {
-            return &dit->second;
+        // Most stores never get dynamic records, so don't hash the ID twice for them
+        if (!mDynamic.empty()) {
+            typename Dynamic::const_iterator dit = mDynamic.find(id);
+            if (dit != mDynamic.end()) {
+                return &dit->second;
+            }
         }
 
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
+        typename Static::const_iterator it = mStatic.find(id);
+        if (it != mStatic.end()) {
             return &(it->second);
         }
 
@@ -197,6 +198,28 @@ namespace MWWorld
         record.load(esm, isDeleted);
         Misc::StringUtils::lowerCaseInPlace(record.mId);
 
+        return insertLoaded(record, isDeleted);
+    }
+    template<typename T>
+    std::unique_ptr<StagedRecord> Store<T>::parse(ESM::ESMReader &esm) const
+    {
+        ParsedRecord *parsed = new ParsedRecord;
+        std::unique_ptr<StagedRecord> staged(parsed);
+
+        parsed->mRecord.load(esm, parsed->mIsDeleted);
+        Misc::StringUtils::lowerCaseInPlace(parsed->mRecord.mId);
+
+        return staged;
+    }
+    template<typename T>
+    RecordId Store<T>::insertParsed(StagedRecord &record)
+    {
+        ParsedRecord &parsed = static_cast<ParsedRecord&>(record);
+        return insertLoaded(parsed.mRecord, parsed.mIsDeleted);
+    }
+    template<typename T>
+    RecordId Store<T>::insertLoaded(const T &record, bool isDeleted)
+    {
         std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
         if (inserted.second)
             mShared.push_back(&inserted.first->second);
@@ -272,17 +295,15 @@ namespace MWWorld
     template<typename T>
     bool Store<T>::eraseStatic(const std::string &id)
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
+        typename Static::iterator it = mStatic.find(id);
 
-        typename std::map<std::string, T>::iterator it = mStatic.find(idLower);
-
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
+        if (it != mStatic.end()) {
             // delete from the static part of mShared
             typename std::vector<T *>::iterator sharedIter = mShared.begin();
             typename std::vector<T *>::iterator end = sharedIter + mStatic.size();
 
             while (sharedIter != mShared.end() && sharedIter != end) {
-                if((*sharedIter)->mId == idLower) {
+                if(*sharedIter == &it->second) {
                     mShared.erase(sharedIter);
                     break;
                 }
@@ -297,19 +318,15 @@ namespace MWWorld
     template<typename T>
     bool Store<T>::erase(const std::string &id)
     {
-        std::string key = Misc::StringUtils::lowerCase(id);
-        typename Dynamic::iterator it = mDynamic.find(key);
+        typename Dynamic::iterator it = mDynamic.find(id);
         if (it == mDynamic.end()) {
             return false;
         }
-        mDynamic.erase(it);
 
-        // have to reinit the whole shared part
+        // remove it from the dynamic part of mShared, keeping the order of the others
         assert(mShared.size() >= mStatic.size());
-        mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
-        for (it = mDynamic.begin(); it != mDynamic.end(); ++it) {
-            mShared.push_back(&it->second);
-        }
+        mShared.erase(std::find(mShared.begin() + mStatic.size(), mShared.end(), &it->second));
+        mDynamic.erase(it);
         return true;
     }
     template<typename T>
@@ -320,11 +337,24 @@ namespace MWWorld
     template<typename T>
     void Store<T>::write (ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
+        // Write the records sorted by their lower case ID, so that saved games don't depend on the hash order
+        std::vector<const typename Dynamic::value_type *> records;
+        records.reserve(mDynamic.size());
         for (typename Dynamic::const_iterator iter (mDynamic.begin()); iter!=mDynamic.end();
              ++iter)
+        {
+            records.push_back(&*iter);
+        }
+        std::sort(records.begin(), records.end(),
+            [] (const typename Dynamic::value_type *left, const typename Dynamic::value_type *right)
+        {
+            return left->first < right->first;
+        });
+
+        for (const typename Dynamic::value_type *record : records)
         {
             writer.startRecord (T::sRecordId);
-            iter->second.save (writer);
+            record->second.save (writer);
             writer.endRecord (T::sRecordId);
         }
     }
@@ -339,6 +369,43 @@ namespace MWWorld
 
         return RecordId(record.mId, isDeleted);
     }
+    template<typename T>
+    void Store<T>::writeStatic (ESM::ESMWriter& writer) const
+    {
+        // The static records come first in mShared, in the order they were loaded in
+        for (size_t i = 0; i < mStatic.size(); ++i)
+        {
+            writer.startRecord (T::sRecordId);
+            mShared[i]->save (writer);
+            writer.endRecord (T::sRecordId);
+        }
+    }
+    template<typename T>
+    RecordId Store<T>::readStatic(ESM::ESMReader& reader)
+    {
+        T record;
+        bool isDeleted = false;
+
+        record.load (reader, isDeleted);
+
+        // Keep the letter case of records that were inserted with insertStatic()
+        std::pair<typename Static::iterator, bool> inserted =
+            mStatic.insert(std::make_pair(Misc::StringUtils::lowerCase(record.mId), record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+        else
+            inserted.first->second = record;
+
+        return RecordId(record.mId, isDeleted);
+    }
+    template<typename T>
+    void Store<T>::clearStatic()
+    {
+        // remove the static part of mShared
+        assert(mShared.size() >= mStatic.size());
+        mShared.erase(mShared.begin(), mShared.begin() + mStatic.size());
+        mStatic.clear();
+    }
 
     // LandTexture
     //=========================================================================
@@ -1105,10 +1172,16 @@ namespace MWWorld
 
         mShared.clear();
         mShared.reserve(mStatic.size());
-        std::map<std::string, ESM::Dialogue>::iterator it = mStatic.begin();
+        Static::iterator it = mStatic.begin();
         for (; it != mStatic.end(); ++it) {
             mShared.push_back(&(it->second));
         }
+
+        // Dialogues are listed by ID
+        std::sort(mShared.begin(), mShared.end(), [] (const ESM::Dialogue *left, const ESM::Dialogue *right)
+        {
+            return Misc::StringUtils::ciLess(left->mId, right->mId);
+        });
     }
 
     template <>
@@ -1120,7 +1193,7 @@ namespace MWWorld
         dialogue.loadId(esm);
 
         std::string idLower = Misc::StringUtils::lowerCase(dialogue.mId);
-        std::map<std::string, ESM::Dialogue>::iterator found = mStatic.find(idLower);
+        Static::iterator found = mStatic.find(idLower);
         if (found == mStatic.end())
         {
             dialogue.loadData(esm, isDeleted);
@@ -1135,12 +1208,40 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    template <>
+    void Store<ESM::Dialogue>::writeStatic (ESM::ESMWriter& writer) const
+    {
+        // Infos follow their dialogue, in the order set up by the content files
+        for (std::vector<ESM::Dialogue *>::const_iterator it = mShared.begin(); it != mShared.end(); ++it)
+        {
+            const ESM::Dialogue& dialogue = **it;
+
+            writer.startRecord (ESM::REC_DIAL);
+            dialogue.save (writer);
+            writer.endRecord (ESM::REC_DIAL);
+
+            for (ESM::Dialogue::InfoContainer::const_iterator info = dialogue.mInfo.begin(); info != dialogue.mInfo.end(); ++info)
+            {
+                writer.startRecord (ESM::REC_INFO);
+                info->save (writer);
+                writer.endRecord (ESM::REC_INFO);
+            }
+        }
+    }
+
+    template <>
+    std::unique_ptr<StagedRecord> Store<ESM::Dialogue>::parse(ESM::ESMReader &esm) const
+    {
+        // Dialogues are merged with the ones loaded before them, and their infos follow them
+        return nullptr;
+    }
+
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
-        auto it = mStatic.find(Misc::StringUtils::lowerCase(id));
+        auto it = mStatic.find(id);
 
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
+        if (it != mStatic.end()) {
             mStatic.erase(it);
         }
 
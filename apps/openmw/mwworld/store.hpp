@@ -4,6 +4,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <unordered_map>
+
+#include <components/misc/stringops.hpp>
 
 #include "recordcmp.hpp"
 
@@ -27,6 +31,12 @@ namespace MWWorld
         RecordId(const std::string &id = "", bool isDeleted = false);
     };
 
+    /// A record read by StoreBase::parse(), waiting to be inserted in load order
+    struct StagedRecord
+    {
+        virtual ~StagedRecord() {}
+    };
+
     class StoreBase
     {
     public:
@@ -41,6 +51,14 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        /// Read a record without modifying the store, so that content files can be read on worker threads.
+        /// Returns nullptr without reading anything if the record depends on the records loaded before it,
+        /// in which case it has to be loaded in order using load().
+        virtual std::unique_ptr<StagedRecord> parse(ESM::ESMReader &esm) const { return nullptr; }
+
+        /// Insert a record returned by parse()
+        virtual RecordId insertParsed(StagedRecord &record) { return RecordId(); }
+
         virtual bool eraseStatic(const std::string &id) {return false;}
         virtual void clearDynamic() {}
 
@@ -48,6 +66,16 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /// Write the static records in the order they were loaded in, so that readStatic() can restore
+        /// them without the content files. No-op for Stores that keep references into the content files.
+        virtual void writeStatic (ESM::ESMWriter& writer) const {}
+
+        virtual RecordId readStatic (ESM::ESMReader& reader) { return RecordId(); }
+        ///< Read a record written by writeStatic() into static storage
+
+        virtual void clearStatic() {}
+        ///< Remove the records read by readStatic()
     };
 
     template <class T>
@@ -145,14 +173,24 @@ namespace MWWorld
     template <class T>
     class Store : public StoreBase
     {
-        std::map<std::string, T>      mStatic;
+        // Records are keyed by their lower case ID, but looked up case-insensitively, so that search()
+        // doesn't need to lower-case a copy of the ID. Both maps keep the addresses of their records stable.
+        typedef std::unordered_map<std::string, T, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> Dynamic;
+        typedef std::unordered_map<std::string, T, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> Static;
+
+        Static              mStatic;
         std::vector<T *>    mShared; // Preserves the record order as it came from the content files (this
                                      // is relevant for the spell autocalc code and selection order
                                      // for heads/hairs in the character creation)
-        std::map<std::string, T> mDynamic;
+        Dynamic             mDynamic;
+
+        struct ParsedRecord : StagedRecord
+        {
+            T mRecord;
+            bool mIsDeleted = false;
+        };
 
-        typedef std::map<std::string, T> Dynamic;
-        typedef std::map<std::string, T> Static;
+        RecordId insertLoaded(const T &record, bool isDeleted);
 
         friend class ESMStore;
 
@@ -199,8 +237,13 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm);
+        std::unique_ptr<StagedRecord> parse(ESM::ESMReader &esm) const;
+        RecordId insertParsed(StagedRecord &record);
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const;
         RecordId read(ESM::ESMReader& reader);
+        void writeStatic(ESM::ESMWriter& writer) const;
+        RecordId readStatic(ESM::ESMReader& reader);
+        void clearStatic();
     };
 
     template <>
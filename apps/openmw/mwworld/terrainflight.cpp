@@ -0,0 +1,98 @@
+#include "terrainflight.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include <components/misc/constants.hpp>
+
+namespace
+{
+    // Fast enough that cells have to be loaded well ahead of the player
+    const float sSpeed = 2 * Constants::CellSizeInUnits;
+}
+
+namespace MWWorld
+{
+    TerrainFlight::TerrainFlight(const osg::Vec2f& minCell, const osg::Vec2f& maxCell)
+        : mSegment(0)
+        , mSegmentDistance(0.f)
+        , mStarted(false)
+    {
+        // Cross the exterior along both diagonals, keeping away from the edges, where there is usually only water
+        const osg::Vec2f size = maxCell - minCell;
+        const osg::Vec2f low = (minCell + size * 0.2f) * Constants::CellSizeInUnits;
+        const osg::Vec2f high = (minCell + size * 0.8f) * Constants::CellSizeInUnits;
+        mWaypoints.push_back(low);
+        mWaypoints.push_back(high);
+        mWaypoints.push_back(osg::Vec2f(low.x(), high.y()));
+        mWaypoints.push_back(osg::Vec2f(high.x(), low.y()));
+    }
+
+    bool TerrainFlight::update(float duration)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (mStarted)
+            mFrameTimes.push_back(std::chrono::duration<double, std::milli>(now - mLastFrame).count());
+        mLastFrame = now;
+        mStarted = true;
+
+        mSegmentDistance += sSpeed * duration;
+        while (mSegment + 1 < mWaypoints.size())
+        {
+            const float length = (mWaypoints[mSegment + 1] - mWaypoints[mSegment]).length();
+            if (mSegmentDistance < length)
+                return false;
+            mSegmentDistance -= length;
+            ++mSegment;
+        }
+
+        mSegmentDistance = 0.f;
+        return true;
+    }
+
+    osg::Vec2f TerrainFlight::getPosition() const
+    {
+        if (mSegment + 1 >= mWaypoints.size())
+            return mWaypoints.back();
+
+        osg::Vec2f direction = mWaypoints[mSegment + 1] - mWaypoints[mSegment];
+        direction.normalize();
+        return mWaypoints[mSegment] + direction * mSegmentDistance;
+    }
+
+    float TerrainFlight::getHeading() const
+    {
+        const std::size_t segment = std::min(mSegment, mWaypoints.size() - 2);
+        const osg::Vec2f direction = mWaypoints[segment + 1] - mWaypoints[segment];
+        return std::atan2(direction.x(), direction.y());
+    }
+
+    std::string TerrainFlight::getReport() const
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(1);
+
+        if (mFrameTimes.empty())
+        {
+            stream << "No frames recorded";
+            return stream.str();
+        }
+
+        std::vector<double> sorted = mFrameTimes;
+        std::sort(sorted.begin(), sorted.end());
+
+        const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        const double median = sorted[sorted.size() / 2];
+        const std::size_t spikes = sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), 2 * median);
+
+        stream << sorted.size() << " frames in " << total / 1000.0 << " s, frame time in ms: mean " << total / sorted.size()
+               << ", median " << median
+               << ", 99th percentile " << sorted[sorted.size() * 99 / 100]
+               << ", max " << sorted.back()
+               << ", spikes above " << 2 * median << ": " << spikes;
+        return stream.str();
+    }
+}
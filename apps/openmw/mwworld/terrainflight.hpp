@@ -0,0 +1,45 @@
+#ifndef GAME_MWWORLD_TERRAINFLIGHT_H
+#define GAME_MWWORLD_TERRAINFLIGHT_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <osg/Vec2f>
+
+namespace MWWorld
+{
+    /// @brief Flies along a fixed path over the exterior and records frame times, to measure the stutter
+    /// caused by loading terrain and cells while moving.
+    class TerrainFlight
+    {
+    public:
+        /// @param minCell Lower corner of the exterior, in cells
+        /// @param maxCell Upper corner of the exterior, in cells
+        TerrainFlight(const osg::Vec2f& minCell, const osg::Vec2f& maxCell);
+
+        /// Move along the path and record the time since the previous call.
+        /// @return Has the end of the path been reached?
+        bool update(float duration);
+
+        /// Current position in world units
+        osg::Vec2f getPosition() const;
+
+        /// Current heading around the Z axis in radians
+        float getHeading() const;
+
+        /// Frame time statistics, including spikes of more than twice the median frame time.
+        std::string getReport() const;
+
+    private:
+        std::vector<osg::Vec2f> mWaypoints;
+        std::size_t mSegment;
+        float mSegmentDistance;
+
+        std::vector<double> mFrameTimes;
+        std::chrono::steady_clock::time_point mLastFrame;
+        bool mStarted;
+    };
+}
+
+#endif
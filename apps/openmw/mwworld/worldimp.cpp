@@ -87,6 +87,7 @@
 #include "actionteleport.hpp"
 #include "projectilemanager.hpp"
 #include "weather.hpp"
+#include "terrainflight.hpp"
 
 #include "contentloader.hpp"
 #include "esmloader.hpp"
@@ -181,10 +182,10 @@ namespace MWWorld
         const std::vector<std::string>& contentFiles,
         ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
         const std::string& startCell, const std::string& startupScript,
-        const std::string& resourcePath, const std::string& userDataPath)
+        const std::string& resourcePath, const std::string& userDataPath, const std::string& cachePath)
     : mResourceSystem(resourceSystem), mLocalScripts (mStore),
       mSky (true), mCells (mStore, mEsm),
-      mGodMode(false), mScriptsEnabled(true), mContentFiles (contentFiles), mUserDataPath(userDataPath),
+      mTerrainFlightCollision(false), mGodMode(false), mScriptsEnabled(true), mContentFiles (contentFiles), mUserDataPath(userDataPath),
       mActivationDistanceOverride (activationDistanceOverride),
       mStartCell (startCell), mDistanceToFacedObject(-1), mTeleportEnabled(true),
       mLevitationEnabled(true), mGoToJail(false), mDaysInPrison(0),
@@ -195,7 +196,8 @@ namespace MWWorld
         listener->loadingOn();
 
         GameContentLoader gameContentLoader(*listener);
-        EsmLoader esmLoader(mStore, mEsm, encoder, *listener);
+        const bool useContentCache = Settings::Manager::getBool("content cache", "Game");
+        EsmLoader esmLoader(mStore, mEsm, encoder, *listener, useContentCache);
 
         gameContentLoader.addLoader(".esm", &esmLoader);
         gameContentLoader.addLoader(".esp", &esmLoader);
@@ -205,6 +207,11 @@ namespace MWWorld
 
         loadContentFiles(fileCollections, contentFiles, gameContentLoader);
 
+        const boost::filesystem::path contentCachePath = boost::filesystem::path(cachePath) / "content.cache";
+        const bool contentCacheLoaded = useContentCache && esmLoader.loadCache(contentCachePath);
+
+        esmLoader.loadRecords();
+
         listener->loadingOff();
 
         // insert records that may not be present in all versions of MW
@@ -214,6 +221,10 @@ namespace MWWorld
         fillGlobalVariables();
 
         mStore.setUp(true);
+
+        if (useContentCache && !contentCacheLoaded)
+            esmLoader.writeCache(contentCachePath);
+
         mStore.movePlayerRecord();
 
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
@@ -225,6 +236,7 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            navigatorSettings->mNavMeshDiskCachePath = (boost::filesystem::path(cachePath) / "navmesh").string();
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -360,6 +372,9 @@ namespace MWWorld
 
         mCells.clear();
 
+        mTerrainFlight.reset();
+        mTerrainFlightCollision = false;
+
         mDoorStates.clear();
 
         mGoToJail = false;
@@ -627,6 +642,72 @@ namespace MWWorld
         mWorldScene->testInteriorCells();
     }
 
+    void World::testTerrainFlight()
+    {
+        const Store<ESM::Land>& lands = mStore.get<ESM::Land>();
+        if (lands.begin() == lands.end())
+        {
+            MWBase::Environment::get().getWindowManager()->messageBox("There is no exterior to fly over.");
+            return;
+        }
+
+        osg::Vec2f minCell(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        osg::Vec2f maxCell(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+        for (const ESM::Land& land : lands)
+        {
+            minCell.x() = std::min(minCell.x(), static_cast<float>(land.mX));
+            minCell.y() = std::min(minCell.y(), static_cast<float>(land.mY));
+            maxCell.x() = std::max(maxCell.x(), static_cast<float>(land.mX + 1));
+            maxCell.y() = std::max(maxCell.y(), static_cast<float>(land.mY + 1));
+        }
+
+        mTerrainFlight.reset(new TerrainFlight(minCell, maxCell));
+
+        // Fly through hills instead of getting stuck on them
+        if (!mTerrainFlightCollision && isActorCollisionEnabled(getPlayerPtr()))
+        {
+            mPhysics->toggleCollisionMode();
+            mTerrainFlightCollision = true;
+        }
+
+        const osg::Vec2f start = mTerrainFlight->getPosition();
+        ESM::Position pos;
+        pos.pos[0] = start.x();
+        pos.pos[1] = start.y();
+        pos.pos[2] = 0.f;
+        pos.rot[0] = pos.rot[1] = 0.f;
+        pos.rot[2] = mTerrainFlight->getHeading();
+        changeToExteriorCell(pos, true);
+
+        Log(Debug::Info) << "Starting terrain flight";
+    }
+
+    void World::updateTerrainFlight(float duration)
+    {
+        const bool finished = mTerrainFlight->update(duration);
+
+        const osg::Vec2f position = mTerrainFlight->getPosition();
+        const float groundHeight = std::max(getTerrainHeightAt(osg::Vec3f(position, 0.f)), 0.f);
+
+        MWWorld::Ptr player = getPlayerPtr();
+        moveObject(player, position.x(), position.y(), groundHeight + 1500.f);
+        rotateObject(player, 0.f, 0.f, mTerrainFlight->getHeading());
+
+        if (finished)
+        {
+            const std::string report = mTerrainFlight->getReport();
+            Log(Debug::Info) << "Terrain flight finished: " << report;
+            MWBase::Environment::get().getWindowManager()->messageBox(report);
+
+            mTerrainFlight.reset();
+            if (mTerrainFlightCollision)
+            {
+                toggleCollisionMode();
+                mTerrainFlightCollision = false;
+            }
+        }
+    }
+
     void World::useDeathCamera()
     {
         if(mRendering->getCamera()->isVanityOrPreviewModeEnabled() )
@@ -2104,6 +2185,9 @@ namespace MWWorld
             updateNavigator();
         }
 
+        if (mTerrainFlight && !paused)
+            updateTerrainFlight(duration);
+
         updatePlayer();
 
         mPhysics->debugDraw();
@@ -2128,6 +2212,16 @@ namespace MWWorld
         }
     }
 
+    void World::startAsyncPhysics()
+    {
+        mPhysics->startAsyncPhysics();
+    }
+
+    void World::finishAsyncPhysics()
+    {
+        mPhysics->finishAsyncPhysics();
+    }
+
     void World::updatePlayer()
     {
         MWWorld::Ptr player = getPlayerPtr();
@@ -71,6 +71,7 @@ namespace MWWorld
     class WeatherManager;
     class Player;
     class ProjectileManager;
+    class TerrainFlight;
 
     /// \brief The game world and its visual representation
 
@@ -102,6 +103,8 @@ namespace MWWorld
             std::unique_ptr<MWWorld::Scene> mWorldScene;
             std::unique_ptr<MWWorld::WeatherManager> mWeatherManager;
             std::shared_ptr<ProjectileManager> mProjectileManager;
+            std::unique_ptr<TerrainFlight> mTerrainFlight;
+            bool mTerrainFlightCollision;
 
             bool mGodMode;
             bool mScriptsEnabled;
@@ -136,6 +139,8 @@ namespace MWWorld
             void updateSoundListener();
             void updatePlayer();
 
+            void updateTerrainFlight(float duration);
+
             void preloadSpells();
 
             MWWorld::Ptr getFacedObject(float maxDistance, bool ignorePlayer=true);
@@ -209,7 +214,7 @@ namespace MWWorld
                 const std::vector<std::string>& contentFiles,
                 ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
                 const std::string& startCell, const std::string& startupScript,
-                const std::string& resourcePath, const std::string& userDataPath);
+                const std::string& resourcePath, const std::string& userDataPath, const std::string& cachePath);
 
             virtual ~World();
 
@@ -234,6 +239,7 @@ namespace MWWorld
 
             void testExteriorCells() override;
             void testInteriorCells() override;
+            void testTerrainFlight() override;
 
             //switch to POV before showing player's death animation
             void useDeathCamera() override;
@@ -629,6 +635,12 @@ namespace MWWorld
             void update (float duration, bool paused) override;
             void updatePhysics (float duration, bool paused) override;
 
+            void startAsyncPhysics() override;
+            ///< With async physics, move the actors in the background until finishAsyncPhysics is called.
+            /// Nothing else may use physics in between.
+
+            void finishAsyncPhysics() override;
+
             void updateWindowManager () override;
 
             MWWorld::Ptr placeObject (const MWWorld::ConstPtr& object, float cursorX, float cursorY, int amount) override;
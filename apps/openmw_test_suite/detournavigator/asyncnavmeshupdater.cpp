@@ -0,0 +1,131 @@
+#include "operators.hpp"
+
+#include <components/detournavigator/asyncnavmeshupdater.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+
+#include <DetourNavMesh.h>
+
+#include <osg/Stats>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorAsyncNavMeshUpdaterTest : Test
+    {
+        Settings mSettings;
+        osg::Vec3f mAgentHalfExtents {29, 29, 66};
+        std::vector<btScalar> mHeightfieldData;
+        btHeightfieldTerrainShape mHeightfieldShape;
+
+        DetourNavigatorAsyncNavMeshUpdaterTest()
+            : mHeightfieldData(makeHeightfieldData())
+            , mHeightfieldShape(sSize, sSize, mHeightfieldData.data(), 1, -64, 64, 2, PHY_FLOAT, false)
+        {
+            mSettings.mBorderSize = 16;
+            mSettings.mCellHeight = 0.2f;
+            mSettings.mCellSize = 0.2f;
+            mSettings.mDetailSampleDist = 6;
+            mSettings.mDetailSampleMaxError = 1;
+            mSettings.mMaxClimb = 34;
+            mSettings.mMaxSimplificationError = 1.3f;
+            mSettings.mMaxSlope = 49;
+            mSettings.mRecastScaleFactor = 0.017647058823529415f;
+            mSettings.mSwimHeightScale = 0.89999997615814208984375f;
+            mSettings.mMaxEdgeLen = 12;
+            mSettings.mMaxNavMeshQueryNodes = 2048;
+            mSettings.mMaxVertsPerPoly = 6;
+            mSettings.mRegionMergeSize = 20;
+            mSettings.mRegionMinSize = 8;
+            mSettings.mTileSize = 64;
+            mSettings.mMaxNavMeshTilesCacheSize = 1024 * 1024;
+            mSettings.mTrianglesPerChunk = 256;
+            mSettings.mMaxPolys = 4096;
+            mSettings.mMaxTilesNumber = 512;
+            mHeightfieldShape.setLocalScaling(btVector3(64, 64, 1));
+        }
+
+        static const int sSize = 33;
+
+        static std::vector<btScalar> makeHeightfieldData()
+        {
+            std::vector<btScalar> result;
+            for (int y = 0; y < sSize; ++y)
+                for (int x = 0; x < sSize; ++x)
+                    result.push_back(32 * std::sin(x * 0.5f) * std::cos(y * 0.3f));
+            return result;
+        }
+
+        /// Returns the number of polygons of every tile the updater added to the navmesh
+        std::map<TilePosition, int> generate(std::size_t threads, int churnRounds)
+        {
+            mSettings.mAsyncNavMeshUpdaterThreads = threads;
+
+            TileCachedRecastMeshManager recastMeshManager(mSettings);
+            OffMeshConnectionsManager offMeshConnectionsManager(mSettings);
+            recastMeshManager.addObject(ObjectId(&mHeightfieldShape), mHeightfieldShape, btTransform::getIdentity(),
+                                        AreaType_ground);
+
+            std::map<TilePosition, ChangeType> allTiles;
+            recastMeshManager.forEachTilePosition([&] (const TilePosition& tile) { allTiles[tile] = ChangeType::add; });
+
+            const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), 1);
+
+            {
+                AsyncNavMeshUpdater updater(mSettings, recastMeshManager, offMeshConnectionsManager);
+
+                // Moves the heightfield while the jobs posted for it are still processed
+                for (int i = 0; i < churnRounds; ++i)
+                {
+                    const btTransform transform(btMatrix3x3::getIdentity(), btVector3(0, 0, (i % 3) * 8.0f));
+                    std::map<TilePosition, ChangeType> changedTiles;
+                    for (const auto& tile : recastMeshManager.updateObject(ObjectId(&mHeightfieldShape),
+                            mHeightfieldShape, transform, AreaType_ground))
+                        changedTiles[tile] = ChangeType::update;
+                    updater.post(mAgentHalfExtents, navMeshCacheItem, TilePosition(i % 5 - 2, 2 - i % 5), changedTiles);
+                }
+
+                recastMeshManager.updateObject(ObjectId(&mHeightfieldShape), mHeightfieldShape,
+                                               btTransform::getIdentity(), AreaType_ground);
+                updater.post(mAgentHalfExtents, navMeshCacheItem, TilePosition(0, 0), allTiles);
+                updater.wait();
+
+                osg::Stats stats("stats");
+                updater.reportStats(0, stats);
+                double jobs = -1;
+                EXPECT_TRUE(stats.getAttribute(0, "NavMesh UpdateJobs", jobs));
+                EXPECT_EQ(jobs, 0);
+            }
+
+            std::map<TilePosition, int> result;
+            const auto locked = navMeshCacheItem->lockConst();
+            for (const auto& tile : allTiles)
+                if (const dtMeshTile* const meshTile = locked->getImpl().getTileAt(tile.first.x(), tile.first.y(), 0))
+                    result[tile.first] = meshTile->header->polyCount;
+            return result;
+        }
+    };
+
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, wait_should_return_after_all_posted_tiles_are_generated)
+    {
+        const auto result = generate(1, 0);
+        EXPECT_FALSE(result.empty());
+    }
+
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, multiple_threads_with_object_churn_should_give_same_tiles_as_one_thread)
+    {
+        const auto expected = generate(1, 0);
+        const auto result = generate(4, 50);
+        EXPECT_EQ(result, expected);
+    }
+}
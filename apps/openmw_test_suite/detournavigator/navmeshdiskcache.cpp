@@ -0,0 +1,165 @@
+#include "operators.hpp"
+
+#include <components/detournavigator/navmeshdiskcache.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <DetourAlloc.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDiskCacheTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents {1, 2, 3};
+        const TilePosition mTilePosition {0, 0};
+        const std::vector<int> mIndices {{0, 1, 2}};
+        const std::vector<float> mVertices {{0, 0, 0, 1, 0, 0, 1, 1, 0}};
+        const std::vector<AreaType> mAreaTypes {1, AreaType_ground};
+        const std::vector<RecastMesh::Water> mWater {};
+        const std::size_t mTrianglesPerChunk {1};
+        const RecastMesh mRecastMesh {mIndices, mVertices, mAreaTypes, mWater, mTrianglesPerChunk};
+        const std::vector<OffMeshConnection> mOffMeshConnections {};
+        const std::vector<unsigned char> mData {{1, 2, 3, 4}};
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw_test_navmesh_%%%%%%%%");
+        Settings mSettings;
+
+        DetourNavigatorNavMeshDiskCacheTest()
+        {
+            mSettings.mCellSize = 0.2f;
+            mSettings.mTileSize = 64;
+        }
+
+        ~DetourNavigatorNavMeshDiskCacheTest()
+        {
+            boost::filesystem::remove_all(mPath);
+        }
+
+        void setModifiedTime(std::time_t newerThan, std::time_t modified)
+        {
+            for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+                if (boost::filesystem::last_write_time(it->path()) > newerThan)
+                    boost::filesystem::last_write_time(it->path(), modified);
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_for_empty_cache_should_return_none)
+    {
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+
+        EXPECT_FALSE(cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_should_return_written_tile)
+    {
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+
+        const auto result = cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections);
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->mSize, static_cast<int>(mData.size()));
+        EXPECT_EQ(std::memcmp(result->mValue.get(), mData.data(), mData.size()), 0);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_should_return_tile_written_by_other_instance)
+    {
+        {
+            NavMeshDiskCache cache(mPath.string(), mSettings);
+            cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                        static_cast<int>(mData.size()));
+        }
+
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        const auto result = cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->mSize, static_cast<int>(mData.size()));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_should_return_null_data_for_written_empty_tile)
+    {
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, nullptr, 0);
+        cache.wait();
+
+        const auto result = cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->mValue, nullptr);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_for_other_recast_mesh_should_return_none)
+    {
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 2, 0}};
+        const RecastMesh recastMesh {mIndices, vertices, mAreaTypes, mWater, mTrianglesPerChunk};
+        EXPECT_FALSE(cache.read(mAgentHalfExtents, mTilePosition, recastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_for_other_tile_should_return_none)
+    {
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+
+        EXPECT_FALSE(cache.read(mAgentHalfExtents, TilePosition {1, 0}, mRecastMesh, mOffMeshConnections));
+        EXPECT_FALSE(cache.read(osg::Vec3f(1, 2, 4), mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, read_with_other_settings_should_return_none)
+    {
+        {
+            NavMeshDiskCache cache(mPath.string(), mSettings);
+            cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                        static_cast<int>(mData.size()));
+        }
+
+        mSettings.mTileSize = 128;
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        EXPECT_FALSE(cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDiskCacheTest, write_over_max_size_should_remove_least_recently_used_tiles)
+    {
+        // Each file takes 44 bytes, the third one exceeds the limit and one of them is removed
+        mSettings.mMaxNavMeshDiskCacheSize = 120;
+        const std::time_t now = std::time(nullptr);
+        const TilePosition otherTilePosition {1, 0};
+        const TilePosition newTilePosition {2, 0};
+
+        NavMeshDiskCache cache(mPath.string(), mSettings);
+        cache.write(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+        setModifiedTime(0, now - 200);
+        cache.write(mAgentHalfExtents, otherTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+        setModifiedTime(now - 150, now - 100);
+
+        ASSERT_TRUE(cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+
+        cache.write(mAgentHalfExtents, newTilePosition, mRecastMesh, mOffMeshConnections, mData.data(),
+                    static_cast<int>(mData.size()));
+        cache.wait();
+
+        EXPECT_TRUE(cache.read(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+        EXPECT_FALSE(cache.read(mAgentHalfExtents, otherTilePosition, mRecastMesh, mOffMeshConnections));
+        EXPECT_TRUE(cache.read(mAgentHalfExtents, newTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+}
@@ -0,0 +1,357 @@
+#include <components/esmterrain/normals.hpp>
+#include <components/esmterrain/storage.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    const int sMinCell = -20;
+    const int sMaxCell = 20;
+
+    /// A world of generated land, with some holes and some cells without normals or colours
+    class TestStorage : public ESMTerrain::Storage
+    {
+    public:
+        TestStorage()
+            : ESMTerrain::Storage(nullptr)
+        {
+            unsigned int seed = 1;
+            auto random = [&] (int min, int max)
+            {
+                seed = seed * 1103515245 + 12345;
+                return min + static_cast<int>((seed >> 16) % static_cast<unsigned int>(max - min + 1));
+            };
+
+            for (int cellX = sMinCell; cellX < sMaxCell; ++cellX)
+            {
+                for (int cellY = sMinCell; cellY < sMaxCell; ++cellY)
+                {
+                    if ((cellX * 7 + cellY * 3) % 11 == 0)
+                        continue;
+
+                    std::unique_ptr<ESM::Land> land (new ESM::Land);
+                    land->blank();
+                    land->mX = cellX;
+                    land->mY = cellY;
+
+                    ESM::Land::LandData* data = land->getLandData();
+                    for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+                    {
+                        data->mHeights[i] = static_cast<float>(random(-2000, 4000));
+                        data->mNormals[i * 3] = static_cast<signed char>(random(-60, 60));
+                        data->mNormals[i * 3 + 1] = static_cast<signed char>(random(-60, 60));
+                        data->mNormals[i * 3 + 2] = static_cast<signed char>(random(40, 127));
+                        for (int j = 0; j < 3; ++j)
+                            data->mColours[i * 3 + j] = static_cast<unsigned char>(random(0, 255));
+                    }
+
+                    int dataTypes = data->mDataLoaded;
+                    if (cellX % 5 == 0)
+                        dataTypes &= ~ESM::Land::DATA_VNML;
+                    if (cellY % 7 == 0)
+                        dataTypes &= ~ESM::Land::DATA_VCLR;
+                    data->mDataLoaded = dataTypes;
+                    land->mDataTypes = dataTypes;
+
+                    mLandObjects[std::make_pair(cellX, cellY)] = new ESMTerrain::LandObject(land.get(), dataTypes);
+                    mLands.push_back(std::move(land));
+                }
+            }
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY) override
+        {
+            auto found = mLandObjects.find(std::make_pair(cellX, cellY));
+            if (found == mLandObjects.end())
+                return nullptr;
+            return found->second;
+        }
+
+        const ESM::LandTexture* getLandTexture(int index, short plugin) override
+        {
+            return nullptr;
+        }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY) override
+        {
+            minX = minY = static_cast<float>(sMinCell);
+            maxX = maxY = static_cast<float>(sMaxCell);
+        }
+
+    private:
+        std::vector<std::unique_ptr<ESM::Land>> mLands;
+        std::map<std::pair<int, int>, osg::ref_ptr<const ESMTerrain::LandObject>> mLandObjects;
+    };
+
+    /// Converts one vertex at a time, as ESMTerrain::Storage::fillVertexBuffers used to
+    class ReferenceStorage
+    {
+    public:
+        ReferenceStorage(TestStorage& storage) : mStorage(storage) {}
+
+        void fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
+                               osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours)
+        {
+            mCache.clear();
+
+            size_t increment = static_cast<size_t>(1) << lodLevel;
+            osg::Vec2f origin = center - osg::Vec2f(size/2.f, size/2.f);
+            int startCellX = static_cast<int>(std::floor(origin.x()));
+            int startCellY = static_cast<int>(std::floor(origin.y()));
+            size_t numVerts = static_cast<size_t>(size*(ESM::Land::LAND_SIZE - 1) / increment + 1);
+
+            positions.resize(numVerts*numVerts);
+            normals.resize(numVerts*numVerts);
+            colours.resize(numVerts*numVerts);
+
+            osg::Vec3f normal;
+            osg::Vec4ub color;
+            float vertY = 0;
+            float vertX = 0;
+            float vertY_ = 0;
+            for (int cellY = startCellY; cellY < startCellY + std::ceil(size); ++cellY)
+            {
+                float vertX_ = 0;
+                for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
+                {
+                    const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+                    const ESM::Land::LandData* heightData = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
+                    const ESM::Land::LandData* normalData = land ? land->getData(ESM::Land::DATA_VNML) : nullptr;
+                    const ESM::Land::LandData* colourData = land ? land->getData(ESM::Land::DATA_VCLR) : nullptr;
+
+                    int rowStart = 0;
+                    int colStart = 0;
+                    if (vertY_ != 0)
+                        colStart += increment;
+                    if (vertX_ != 0)
+                        rowStart += increment;
+                    rowStart += (origin.x() - startCellX) * ESM::Land::LAND_SIZE;
+                    colStart += (origin.y() - startCellY) * ESM::Land::LAND_SIZE;
+                    int rowEnd = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1), static_cast<int>(ESM::Land::LAND_SIZE));
+                    int colEnd = std::min(static_cast<int>(colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1), static_cast<int>(ESM::Land::LAND_SIZE));
+
+                    vertY = vertY_;
+                    for (int col=colStart; col<colEnd; col += increment)
+                    {
+                        vertX = vertX_;
+                        for (int row=rowStart; row<rowEnd; row += increment)
+                        {
+                            int srcArrayIndex = col*ESM::Land::LAND_SIZE*3+row*3;
+                            float height = heightData ? heightData->mHeights[col*ESM::Land::LAND_SIZE + row] : ESM::Land::DEFAULT_HEIGHT;
+                            positions[static_cast<unsigned int>(vertX*numVerts + vertY)]
+                                = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
+                                             (vertY / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
+                                             height);
+
+                            if (normalData)
+                            {
+                                for (int i=0; i<3; ++i)
+                                    normal[i] = normalData->mNormals[srcArrayIndex+i];
+                                normal.normalize();
+                            }
+                            else
+                                normal = osg::Vec3f(0,0,1);
+                            if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
+                                fixNormal(normal, cellX, cellY, col, row);
+                            if ((row == 0 || row == ESM::Land::LAND_SIZE-1) && (col == 0 || col == ESM::Land::LAND_SIZE-1))
+                                averageNormal(normal, cellX, cellY, col, row);
+                            normals[static_cast<unsigned int>(vertX*numVerts + vertY)] = normal;
+
+                            if (colourData)
+                            {
+                                for (int i=0; i<3; ++i)
+                                    color[i] = colourData->mColours[srcArrayIndex+i];
+                            }
+                            else
+                                color = osg::Vec4ub(255, 255, 255, 255);
+                            if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
+                                fixColour(color, cellX, cellY, col, row);
+                            color.a() = 255;
+                            colours[static_cast<unsigned int>(vertX*numVerts + vertY)] = color;
+
+                            ++vertX;
+                        }
+                        ++vertY;
+                    }
+                    vertX_ = vertX;
+                }
+                vertY_ = vertY;
+            }
+        }
+
+    private:
+        const ESMTerrain::LandObject* getLand(int cellX, int cellY)
+        {
+            auto found = mCache.find(std::make_pair(cellX, cellY));
+            if (found == mCache.end())
+                found = mCache.emplace(std::make_pair(cellX, cellY), mStorage.getLand(cellX, cellY)).first;
+            return found->second;
+        }
+
+        void fixNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row)
+        {
+            while (col >= ESM::Land::LAND_SIZE-1) { ++cellY; col -= ESM::Land::LAND_SIZE-1; }
+            while (row >= ESM::Land::LAND_SIZE-1) { ++cellX; row -= ESM::Land::LAND_SIZE-1; }
+            while (col < 0) { --cellY; col += ESM::Land::LAND_SIZE-1; }
+            while (row < 0) { --cellX; row += ESM::Land::LAND_SIZE-1; }
+
+            const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+            const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : nullptr;
+            if (data)
+            {
+                for (int i=0; i<3; ++i)
+                    normal[i] = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+i];
+                normal.normalize();
+            }
+            else
+                normal = osg::Vec3f(0,0,1);
+        }
+
+        void averageNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row)
+        {
+            osg::Vec3f n1,n2,n3,n4;
+            fixNormal(n1, cellX, cellY, col+1, row);
+            fixNormal(n2, cellX, cellY, col-1, row);
+            fixNormal(n3, cellX, cellY, col, row+1);
+            fixNormal(n4, cellX, cellY, col, row-1);
+            normal = (n1+n2+n3+n4);
+            normal.normalize();
+        }
+
+        void fixColour(osg::Vec4ub& color, int cellX, int cellY, int col, int row)
+        {
+            if (col == ESM::Land::LAND_SIZE-1) { ++cellY; col = 0; }
+            if (row == ESM::Land::LAND_SIZE-1) { ++cellX; row = 0; }
+
+            const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+            const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : nullptr;
+            for (int i=0; i<3; ++i)
+                color[i] = data ? data->mColours[col*ESM::Land::LAND_SIZE*3+row*3+i] : 255;
+        }
+
+        TestStorage& mStorage;
+        std::map<std::pair<int, int>, osg::ref_ptr<const ESMTerrain::LandObject>> mCache;
+    };
+
+    struct ESMTerrainStorageTest : Test
+    {
+        TestStorage mStorage;
+        ReferenceStorage mReference {mStorage};
+    };
+
+    TEST_F(ESMTerrainStorageTest, fillVertexBuffers_should_match_per_vertex_conversion)
+    {
+        const float sizes[] = {0.125f, 0.25f, 0.5f, 1.f, 2.f, 4.f};
+        for (float size : sizes)
+        {
+            for (int lod = 0; lod < 4; ++lod)
+            {
+                if ((ESM::Land::LAND_SIZE - 1) * size < (1 << lod))
+                    continue;
+
+                // Chunks around holes, around cells without normals or colours, and at the world edge
+                for (float x = -21.f; x <= 20.f; x += 2.875f)
+                {
+                    for (float y = -21.f; y <= 20.f; y += 3.625f)
+                    {
+                        const osg::Vec2f center(std::floor(x / size) * size + size / 2.f, std::floor(y / size) * size + size / 2.f);
+
+                        osg::ref_ptr<osg::Vec3Array> positions (new osg::Vec3Array);
+                        osg::ref_ptr<osg::Vec3Array> normals (new osg::Vec3Array);
+                        osg::ref_ptr<osg::Vec4ubArray> colours (new osg::Vec4ubArray);
+                        mStorage.fillVertexBuffers(lod, size, center, positions, normals, colours);
+
+                        osg::Vec3Array expectedPositions;
+                        osg::Vec3Array expectedNormals;
+                        osg::Vec4ubArray expectedColours;
+                        mReference.fillVertexBuffers(lod, size, center, expectedPositions, expectedNormals, expectedColours);
+
+                        ASSERT_EQ(positions->size(), expectedPositions.size());
+                        for (size_t i = 0; i < expectedPositions.size(); ++i)
+                        {
+                            ASSERT_EQ((*positions)[i], expectedPositions[i]) << "size " << size << " lod " << lod << " center " << center.x() << " " << center.y() << " vertex " << i;
+                            ASSERT_EQ((*normals)[i], expectedNormals[i]) << "size " << size << " lod " << lod << " center " << center.x() << " " << center.y() << " vertex " << i;
+                            ASSERT_EQ((*colours)[i], expectedColours[i]) << "size " << size << " lod " << lod << " center " << center.x() << " " << center.y() << " vertex " << i;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    TEST(ESMTerrainNormalsTest, normalizeSse2_should_match_normalizeScalar)
+    {
+        // Every normal with components in the range of ESM::Land::VNML, in steps that cover both ends,
+        // zero length normals and a count that isn't a multiple of 4
+        std::vector<float> x, y, z;
+        for (int i = -128; i <= 127; i += 5)
+        {
+            for (int j = -128; j <= 127; j += 7)
+            {
+                for (int k = -128; k <= 127; k += 3)
+                {
+                    x.push_back(static_cast<float>(i));
+                    y.push_back(static_cast<float>(j));
+                    z.push_back(static_cast<float>(k));
+                }
+            }
+        }
+        x.push_back(0);
+        y.push_back(0);
+        z.push_back(0);
+        const int count = static_cast<int>(x.size());
+
+        std::vector<float> expectedX = x, expectedY = y, expectedZ = z;
+        ESMTerrain::normalizeScalar(count, expectedX.data(), expectedY.data(), expectedZ.data());
+
+        const int done = ESMTerrain::normalizeSse2(count, x.data(), y.data(), z.data());
+        ASSERT_LE(done, count);
+        ESMTerrain::normalizeScalar(count - done, x.data() + done, y.data() + done, z.data() + done);
+
+        for (int i = 0; i < count; ++i)
+        {
+            ASSERT_EQ(x[i], expectedX[i]) << "normal " << i;
+            ASSERT_EQ(y[i], expectedY[i]) << "normal " << i;
+            ASSERT_EQ(z[i], expectedZ[i]) << "normal " << i;
+        }
+    }
+
+    /// Compares the time to convert every cell of the world with converting one vertex at a time. Disabled by
+    /// default, run it with --gtest_also_run_disabled_tests and read the timings from the --gtest_output report.
+    TEST_F(ESMTerrainStorageTest, DISABLED_fillVertexBuffers_benchmark)
+    {
+        osg::ref_ptr<osg::Vec3Array> positions (new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals (new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec4ubArray> colours (new osg::Vec4ubArray);
+
+        const int passes = 3;
+        const int cells = (sMaxCell - sMinCell) * (sMaxCell - sMinCell);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass)
+            for (int cellX = sMinCell; cellX < sMaxCell; ++cellX)
+                for (int cellY = sMinCell; cellY < sMaxCell; ++cellY)
+                    mStorage.fillVertexBuffers(0, 1.f, osg::Vec2f(cellX + 0.5f, cellY + 0.5f), positions, normals, colours);
+        auto storageTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass)
+            for (int cellX = sMinCell; cellX < sMaxCell; ++cellX)
+                for (int cellY = sMinCell; cellY < sMaxCell; ++cellY)
+                    mReference.fillVertexBuffers(0, 1.f, osg::Vec2f(cellX + 0.5f, cellY + 0.5f), *positions, *normals, *colours);
+        auto referenceTime = std::chrono::steady_clock::now() - start;
+
+        RecordProperty("cells", passes * cells);
+        RecordProperty("storage_ms", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(storageTime).count()));
+        RecordProperty("per_vertex_conversion_ms",
+                       static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(referenceTime).count()));
+    }
+}
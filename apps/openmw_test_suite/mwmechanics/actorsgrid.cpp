@@ -0,0 +1,143 @@
+#include "apps/openmw/mwmechanics/actorsgrid.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    std::vector<osg::Vec3f> makePositions(std::size_t count, float size)
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> horizontal(-size / 2, size / 2);
+        std::uniform_real_distribution<float> vertical(-512, 512);
+        std::vector<osg::Vec3f> result;
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(horizontal(random), horizontal(random), vertical(random));
+        return result;
+    }
+
+    std::vector<std::size_t> findInRange(const std::vector<osg::Vec3f>& positions, const osg::Vec3f& position, float range)
+    {
+        std::vector<std::size_t> result;
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            if ((positions[i] - position).length2() <= range * range)
+                result.push_back(i);
+        return result;
+    }
+
+    ActorsGrid makeGrid(const std::vector<osg::Vec3f>& positions)
+    {
+        ActorsGrid grid(2048);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            grid.add(i, positions[i]);
+        grid.build();
+        return grid;
+    }
+
+    TEST(MWMechanicsActorsGridTest, find_in_range_for_empty_grid_should_return_empty)
+    {
+        const ActorsGrid grid = makeGrid({});
+        std::vector<std::size_t> result {1, 2, 3};
+        grid.findInRange(osg::Vec3f(0, 0, 0), 1000, result);
+        EXPECT_EQ(result, std::vector<std::size_t>());
+    }
+
+    TEST(MWMechanicsActorsGridTest, find_in_range_should_include_actors_at_exactly_range)
+    {
+        const ActorsGrid grid = makeGrid({osg::Vec3f(0, 0, 0), osg::Vec3f(1024, 0, 0), osg::Vec3f(0, -1025, 0)});
+        std::vector<std::size_t> result;
+        grid.findInRange(osg::Vec3f(0, 0, 0), 1024, result);
+        EXPECT_EQ(result, std::vector<std::size_t>({0, 1}));
+    }
+
+    TEST(MWMechanicsActorsGridTest, find_in_range_should_return_same_actors_as_checking_every_actor)
+    {
+        const std::vector<osg::Vec3f> positions = makePositions(500, 8192 * 4);
+        const ActorsGrid grid = makeGrid(positions);
+        std::vector<std::size_t> result;
+        for (const float range : {100.0f, 400.0f, 1024.0f, 3000.0f, 7168.0f, 100000.0f})
+        {
+            for (const osg::Vec3f& position : positions)
+            {
+                grid.findInRange(position, range, result);
+                EXPECT_EQ(result, findInRange(positions, position, range)) << "range=" << range;
+            }
+        }
+    }
+
+    TEST(MWMechanicsActorsGridTest, clear_should_remove_all_actors)
+    {
+        ActorsGrid grid = makeGrid(makePositions(10, 1000));
+        grid.clear();
+        grid.build();
+        std::vector<std::size_t> result;
+        grid.findInRange(osg::Vec3f(0, 0, 0), 100000, result);
+        EXPECT_EQ(grid.size(), 0u);
+        EXPECT_EQ(result, std::vector<std::size_t>());
+    }
+
+    /// Compares the time to find the actors in range with checking every pair. Disabled by default, run it with
+    /// --gtest_also_run_disabled_tests and read the timings from the --gtest_output report.
+    TEST(MWMechanicsActorsGridTest, DISABLED_benchmark_300_actors)
+    {
+        // Actors spread over 3x3 exterior cells, as with several players in neighbouring cells.
+        // The ranges are the default actors processing range and head tracking distance.
+        const std::vector<osg::Vec3f> positions = makePositions(300, 8192 * 3);
+        const int frames = 20;
+
+        for (const float range : {7168.0f, 400.0f})
+        {
+            std::size_t pairs = 0;
+            std::size_t checks = 0;
+            std::vector<std::size_t> result;
+
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (const osg::Vec3f& position : positions)
+                {
+                    for (const osg::Vec3f& other : positions)
+                    {
+                        ++checks;
+                        if ((other - position).length2() <= range * range)
+                            ++pairs;
+                    }
+                }
+            }
+            const auto everyPairTime = std::chrono::steady_clock::now() - start;
+
+            ActorsGrid grid(2048);
+            std::size_t gridPairs = 0;
+            start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                grid.clear();
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                    grid.add(i, positions[i]);
+                grid.build();
+                for (const osg::Vec3f& position : positions)
+                {
+                    grid.findInRange(position, range, result);
+                    gridPairs += result.size();
+                }
+            }
+            const auto gridTime = std::chrono::steady_clock::now() - start;
+
+            EXPECT_EQ(gridPairs, pairs);
+
+            using Us = std::chrono::duration<double, std::micro>;
+            const std::string name = "range_" + std::to_string(static_cast<int>(range));
+            RecordProperty(name + "_pairs", static_cast<int>(pairs / frames));
+            RecordProperty(name + "_checks", static_cast<int>(checks / frames));
+            RecordProperty(name + "_every_pair_us_per_frame", static_cast<int>(Us(everyPairTime).count() / frames));
+            RecordProperty(name + "_grid_us_per_frame", static_cast<int>(Us(gridTime).count() / frames));
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include "apps/openmw/mwmechanics/aischeduler.hpp"
+
+#include <osg/Stats>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    const AiScheduler::Duration millisecond = std::chrono::milliseconds(1);
+
+    TEST(MWMechanicsAiSchedulerTest, can_decide_should_return_true_within_budget)
+    {
+        AiScheduler scheduler(2);
+        scheduler.startFrame();
+        EXPECT_TRUE(scheduler.canDecide(false));
+        scheduler.finishDecision(millisecond);
+        EXPECT_TRUE(scheduler.canDecide(false));
+        EXPECT_EQ(scheduler.getDeferred(), 0u);
+    }
+
+    TEST(MWMechanicsAiSchedulerTest, can_decide_should_defer_not_urgent_decisions_when_budget_is_spent)
+    {
+        AiScheduler scheduler(2);
+        scheduler.startFrame();
+        scheduler.finishDecision(2 * millisecond);
+        EXPECT_FALSE(scheduler.canDecide(false));
+        EXPECT_TRUE(scheduler.canDecide(true));
+        EXPECT_EQ(scheduler.getDecisions(), 1u);
+        EXPECT_EQ(scheduler.getDeferred(), 1u);
+    }
+
+    TEST(MWMechanicsAiSchedulerTest, start_frame_should_restore_budget)
+    {
+        AiScheduler scheduler(2);
+        scheduler.startFrame();
+        scheduler.finishDecision(3 * millisecond);
+        EXPECT_FALSE(scheduler.canDecide(false));
+        scheduler.startFrame();
+        EXPECT_TRUE(scheduler.canDecide(false));
+        EXPECT_EQ(scheduler.getDecisions(), 0u);
+        EXPECT_EQ(scheduler.getDeferred(), 0u);
+    }
+
+    TEST(MWMechanicsAiSchedulerTest, report_stats_should_report_package_times_in_microseconds)
+    {
+        AiScheduler scheduler(2);
+        scheduler.startFrame();
+        scheduler.addPackageTime(5, millisecond);
+        scheduler.addPackageTime(5, millisecond);
+        scheduler.addPackageTime(-1, millisecond);
+        osg::Stats stats("stats");
+        scheduler.reportStats(0, stats);
+        double combat = 0;
+        EXPECT_TRUE(stats.getAttribute(0, "AI Combat", combat));
+        EXPECT_EQ(combat, 2000);
+        double wander = -1;
+        EXPECT_TRUE(stats.getAttribute(0, "AI Wander", wander));
+        EXPECT_EQ(wander, 0);
+    }
+}
@@ -0,0 +1,92 @@
+#include "apps/openmw/mwmechanics/distantactors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    struct MWMechanicsDistantActorsTest : Test
+    {
+        const float mRange = 8192;
+        const std::vector<osg::Vec3f> mPlayerPositions {osg::Vec3f(0, 0, 0), osg::Vec3f(20000, 0, 0)};
+    };
+
+    TEST_F(MWMechanicsDistantActorsTest, is_far_from_players_should_be_false_within_range_of_any_player)
+    {
+        EXPECT_FALSE(isFarFromPlayers(osg::Vec3f(1000, 0, 0), false, mRange, mPlayerPositions));
+        EXPECT_FALSE(isFarFromPlayers(osg::Vec3f(19000, 0, 0), false, mRange, mPlayerPositions));
+        EXPECT_FALSE(isFarFromPlayers(osg::Vec3f(0, 0, mRange), false, mRange, mPlayerPositions));
+    }
+
+    TEST_F(MWMechanicsDistantActorsTest, is_far_from_players_should_be_true_beyond_range_of_every_player)
+    {
+        EXPECT_TRUE(isFarFromPlayers(osg::Vec3f(10000, 0, 0), false, mRange, mPlayerPositions));
+        EXPECT_TRUE(isFarFromPlayers(osg::Vec3f(0, 10000, 0), false, mRange, mPlayerPositions));
+    }
+
+    TEST_F(MWMechanicsDistantActorsTest, is_far_from_players_should_keep_distant_actor_until_within_reduced_range)
+    {
+        const osg::Vec3f betweenRanges(0, 0.95f * mRange, 0);
+        EXPECT_FALSE(isFarFromPlayers(betweenRanges, false, mRange, mPlayerPositions));
+        EXPECT_TRUE(isFarFromPlayers(betweenRanges, true, mRange, mPlayerPositions));
+
+        const osg::Vec3f withinReducedRange(0, 0.85f * mRange, 0);
+        EXPECT_FALSE(isFarFromPlayers(withinReducedRange, true, mRange, mPlayerPositions));
+    }
+
+    TEST_F(MWMechanicsDistantActorsTest, is_far_from_players_should_be_false_for_zero_range)
+    {
+        EXPECT_FALSE(isFarFromPlayers(osg::Vec3f(10000, 0, 0), false, 0, mPlayerPositions));
+        EXPECT_FALSE(isFarFromPlayers(osg::Vec3f(10000, 0, 0), true, 0, mPlayerPositions));
+    }
+
+    TEST_F(MWMechanicsDistantActorsTest, get_distant_actors_range_should_keep_visible_actors_fully_simulated)
+    {
+        EXPECT_FLOAT_EQ(getDistantActorsRange(8192, 6656), 8192);
+        EXPECT_FLOAT_EQ(getDistantActorsRange(4096, 6656), 6656 / sDistantActorsHysteresis);
+        EXPECT_GE(getDistantActorsRange(7168, 6656) * sDistantActorsHysteresis, 6656);
+        EXPECT_EQ(getDistantActorsRange(0, 6656), 0);
+    }
+
+    TEST(MWMechanicsDistantActorTimerTest, should_not_be_distant_by_default)
+    {
+        const DistantActorTimer timer;
+        EXPECT_FALSE(timer.isDistant());
+    }
+
+    TEST(MWMechanicsDistantActorTimerTest, update_should_return_elapsed_time_after_delay)
+    {
+        DistantActorTimer timer;
+        timer.setDistant(true, 0.25f);
+        EXPECT_TRUE(timer.isDistant());
+        EXPECT_EQ(timer.update(0.125f, 1), 0);
+        EXPECT_EQ(timer.update(0.125f, 1), 0.25f);
+    }
+
+    TEST(MWMechanicsDistantActorTimerTest, update_should_return_elapsed_time_once_per_interval)
+    {
+        DistantActorTimer timer;
+        timer.setDistant(true);
+        EXPECT_EQ(timer.update(0.5f, 1), 0.5f);
+        EXPECT_EQ(timer.update(0.5f, 1), 0);
+        EXPECT_EQ(timer.update(0.25f, 1), 0);
+        EXPECT_EQ(timer.update(0.5f, 1), 1.25f);
+        EXPECT_EQ(timer.update(0.5f, 1), 0);
+    }
+
+    TEST(MWMechanicsDistantActorTimerTest, set_distant_should_drop_counted_time)
+    {
+        DistantActorTimer timer;
+        timer.setDistant(true, 1);
+        EXPECT_EQ(timer.update(0.75f, 1), 0);
+        timer.setDistant(false);
+        EXPECT_FALSE(timer.isDistant());
+        timer.setDistant(true, 0.5f);
+        EXPECT_EQ(timer.update(0.25f, 1), 0);
+        EXPECT_EQ(timer.update(0.25f, 1), 0.5f);
+    }
+}
@@ -0,0 +1,370 @@
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+#include <components/esm/esmreader.hpp>
+#include <components/esm/loadcell.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    /// Points on a jittered square grid, each one connected both ways to its neighbours on the grid, with some
+    /// connections left out so that a pathgrid can have several connected parts
+    ESM::Pathgrid makePathgrid(int side, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> jitter(-100, 100);
+        std::uniform_int_distribution<int> height(-50, 50);
+        std::uniform_int_distribution<int> connect(0, 9);
+
+        ESM::Pathgrid result;
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                result.mPoints.emplace_back(x * 500 + jitter(random), y * 500 + jitter(random), height(random));
+
+        const auto addEdge = [&] (int v0, int v1)
+        {
+            ESM::Pathgrid::Edge edge;
+            edge.mV0 = v0;
+            edge.mV1 = v1;
+            result.mEdges.push_back(edge);
+        };
+
+        for (int y = 0; y < side; ++y)
+        {
+            for (int x = 0; x < side; ++x)
+            {
+                const int point = y * side + x;
+                if (x + 1 < side && connect(random) > 0)
+                {
+                    addEdge(point, point + 1);
+                    addEdge(point + 1, point);
+                }
+                if (y + 1 < side && connect(random) > 0)
+                {
+                    addEdge(point, point + side);
+                    addEdge(point + side, point);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /// Pathgrids of a content file given by the OPENMW_TEST_PATHGRIDS_CONTENT environment variable,
+    /// e.g. Morrowind.esm, or generated ones of similar sizes
+    std::vector<ESM::Pathgrid> getBenchmarkPathgrids()
+    {
+        std::vector<ESM::Pathgrid> result;
+
+        if (const char* const content = std::getenv("OPENMW_TEST_PATHGRIDS_CONTENT"))
+        {
+            ESM::ESMReader esm;
+            esm.open(content);
+            while (esm.hasMoreRecs())
+            {
+                const ESM::NAME name = esm.getRecName();
+                esm.getRecHeader();
+                if (name == ESM::REC_PGRD)
+                {
+                    ESM::Pathgrid pathgrid;
+                    bool isDeleted = false;
+                    pathgrid.load(esm, isDeleted);
+                    if (!isDeleted && !pathgrid.mPoints.empty())
+                        result.push_back(std::move(pathgrid));
+                }
+                else
+                    esm.skipRecord();
+            }
+            return result;
+        }
+
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> side(2, 9);
+        for (int i = 0; i < 200; ++i)
+            result.push_back(makePathgrid(side(random), random));
+        return result;
+    }
+
+    float getCost(const ESM::Pathgrid::Point& a, const ESM::Pathgrid::Point& b)
+    {
+        return 300.0f * (std::abs(a.mX - b.mX) + std::abs(a.mY - b.mY) + std::abs(a.mZ - b.mZ));
+    }
+
+    using Graph = std::vector<std::vector<std::pair<int, float>>>;
+
+    Graph makeGraph(const ESM::Pathgrid& pathgrid)
+    {
+        Graph graph(pathgrid.mPoints.size());
+        for (const ESM::Pathgrid::Edge& edge : pathgrid.mEdges)
+            graph[edge.mV0].emplace_back(edge.mV1, getCost(pathgrid.mPoints[edge.mV0], pathgrid.mPoints[edge.mV1]));
+        return graph;
+    }
+
+    /// The search with a sorted list as openset that PathgridGraph used before, to compare with.
+    /// Returns the cost of the found path or -1 if there is none. A point is not moved in the list
+    /// when its cost goes down, so the found path is not always the cheapest one.
+    float getPathCostWithSortedList(const ESM::Pathgrid& pathgrid, const Graph& graph, int start, int goal)
+    {
+        const int graphSize = static_cast<int>(pathgrid.mPoints.size());
+
+        std::vector<float> gScore(graphSize, -1);
+        std::vector<float> fScore(graphSize, -1);
+        gScore[start] = 0;
+        fScore[start] = getCost(pathgrid.mPoints[start], pathgrid.mPoints[goal]);
+
+        std::list<int> openset;
+        std::list<int> closedset;
+        openset.push_back(start);
+
+        while (!openset.empty())
+        {
+            const int current = openset.front();
+            openset.pop_front();
+
+            if (current == goal)
+                return gScore[goal];
+
+            closedset.push_back(current);
+
+            for (const auto& edge : graph[current])
+            {
+                if (std::find(closedset.begin(), closedset.end(), edge.first) != closedset.end())
+                    continue;
+                const int dest = edge.first;
+                const float tentativeG = gScore[current] + edge.second;
+                const bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
+                if (!isInOpenSet || tentativeG < gScore[dest])
+                {
+                    gScore[dest] = tentativeG;
+                    fScore[dest] = tentativeG + getCost(pathgrid.mPoints[dest], pathgrid.mPoints[goal]);
+                    if (!isInOpenSet)
+                    {
+                        auto it = openset.begin();
+                        for (; it != openset.end(); ++it)
+                            if (fScore[*it] > fScore[dest])
+                                break;
+                        openset.insert(it, dest);
+                    }
+                }
+            }
+        }
+
+        return -1;
+    }
+
+    /// Dijkstra's search over all points, the cost of the cheapest path or -1 if there is none
+    float getCheapestPathCost(const Graph& graph, int start, int goal)
+    {
+        std::vector<float> cost(graph.size(), -1);
+        std::vector<char> done(graph.size(), 0);
+        cost[start] = 0;
+        while (true)
+        {
+            int current = -1;
+            for (int i = 0; i < static_cast<int>(graph.size()); ++i)
+                if (!done[i] && cost[i] >= 0 && (current == -1 || cost[i] < cost[current]))
+                    current = i;
+            if (current == -1)
+                return -1;
+            if (current == goal)
+                return cost[goal];
+            done[current] = 1;
+            for (const auto& edge : graph[current])
+                if (cost[edge.first] < 0 || cost[current] + edge.second < cost[edge.first])
+                    cost[edge.first] = cost[current] + edge.second;
+        }
+    }
+
+    float getPathCost(const std::vector<ESM::Pathgrid::Point>& path)
+    {
+        float result = 0;
+        for (std::size_t i = 1; i < path.size(); ++i)
+            result += getCost(path[i - 1], path[i]);
+        return result;
+    }
+
+    bool isSamePoint(const ESM::Pathgrid::Point& lhs, const ESM::Pathgrid::Point& rhs)
+    {
+        return lhs.mX == rhs.mX && lhs.mY == rhs.mY && lhs.mZ == rhs.mZ;
+    }
+
+    int findPoint(const ESM::Pathgrid& pathgrid, const ESM::Pathgrid::Point& point)
+    {
+        const auto it = std::find_if(pathgrid.mPoints.begin(), pathgrid.mPoints.end(),
+            [&] (const ESM::Pathgrid::Point& v) { return isSamePoint(v, point); });
+        return it == pathgrid.mPoints.end() ? -1 : static_cast<int>(it - pathgrid.mPoints.begin());
+    }
+
+    bool hasEdge(const ESM::Pathgrid& pathgrid, int v0, int v1)
+    {
+        return std::any_of(pathgrid.mEdges.begin(), pathgrid.mEdges.end(),
+            [&] (const ESM::Pathgrid::Edge& edge) { return edge.mV0 == v0 && edge.mV1 == v1; });
+    }
+
+    void addEdges(ESM::Pathgrid& pathgrid, int v0, int v1)
+    {
+        ESM::Pathgrid::Edge edge;
+        edge.mV0 = v0;
+        edge.mV1 = v1;
+        pathgrid.mEdges.push_back(edge);
+        std::swap(edge.mV0, edge.mV1);
+        pathgrid.mEdges.push_back(edge);
+    }
+
+    struct MWMechanicsPathgridGraphTest : Test
+    {
+        ESM::Cell mCell;
+        std::mt19937 mRandom {13};
+        const ESM::Pathgrid mPathgrid = makePathgrid(8, mRandom);
+    };
+
+    TEST_F(MWMechanicsPathgridGraphTest, a_star_search_should_return_connected_path_from_start_to_goal)
+    {
+        const PathgridGraph graph(&mCell, &mPathgrid);
+        const Graph referenceGraph = makeGraph(mPathgrid);
+        const int size = static_cast<int>(mPathgrid.mPoints.size());
+        for (int start = 0; start < size; ++start)
+        {
+            for (int goal = 0; goal < size; ++goal)
+            {
+                const std::vector<ESM::Pathgrid::Point> path = graph.aStarSearch(start, goal);
+                const float sortedListCost = getPathCostWithSortedList(mPathgrid, referenceGraph, start, goal);
+                EXPECT_EQ(!path.empty(), sortedListCost >= 0) << start << " " << goal;
+                if (path.empty())
+                    continue;
+                const float cost = getPathCost(path);
+                EXPECT_FLOAT_EQ(cost, getCheapestPathCost(referenceGraph, start, goal)) << start << " " << goal;
+                EXPECT_LE(cost, sortedListCost) << start << " " << goal;
+                EXPECT_EQ(findPoint(mPathgrid, path.front()), start);
+                EXPECT_EQ(findPoint(mPathgrid, path.back()), goal);
+                for (std::size_t i = 1; i < path.size(); ++i)
+                    EXPECT_TRUE(hasEdge(mPathgrid, findPoint(mPathgrid, path[i - 1]), findPoint(mPathgrid, path[i])));
+            }
+        }
+    }
+
+    TEST_F(MWMechanicsPathgridGraphTest, a_star_search_should_return_cheapest_path_when_it_has_more_points)
+    {
+        ESM::Pathgrid pathgrid;
+        pathgrid.mPoints.emplace_back(0, 0, 0);
+        pathgrid.mPoints.emplace_back(15, 20, 0);
+        pathgrid.mPoints.emplace_back(10, 0, 0);
+        pathgrid.mPoints.emplace_back(20, 0, 0);
+        pathgrid.mPoints.emplace_back(30, 0, 0);
+        // 0 -> 1 -> 4 costs 300 * (35 + 35), 0 -> 2 -> 3 -> 4 costs 300 * (10 + 10 + 10)
+        addEdges(pathgrid, 0, 1);
+        addEdges(pathgrid, 1, 4);
+        addEdges(pathgrid, 0, 2);
+        addEdges(pathgrid, 2, 3);
+        addEdges(pathgrid, 3, 4);
+
+        const PathgridGraph graph(&mCell, &pathgrid);
+        const std::vector<ESM::Pathgrid::Point> path = graph.aStarSearch(0, 4);
+        ASSERT_EQ(path.size(), 4u);
+        EXPECT_EQ(findPoint(pathgrid, path[0]), 0);
+        EXPECT_EQ(findPoint(pathgrid, path[1]), 2);
+        EXPECT_EQ(findPoint(pathgrid, path[2]), 3);
+        EXPECT_EQ(findPoint(pathgrid, path[3]), 4);
+        EXPECT_FLOAT_EQ(getPathCost(path), 9000);
+        EXPECT_FLOAT_EQ(getPathCostWithSortedList(pathgrid, makeGraph(pathgrid), 0, 4), 9000);
+    }
+
+    TEST_F(MWMechanicsPathgridGraphTest, a_star_search_should_return_same_path_when_cached)
+    {
+        const PathgridGraph graph(&mCell, &mPathgrid);
+        const int size = static_cast<int>(mPathgrid.mPoints.size());
+
+        std::vector<std::vector<ESM::Pathgrid::Point>> paths;
+        for (int goal = 0; goal < size; ++goal)
+            paths.push_back(graph.aStarSearch(0, goal));
+
+        // Recent paths come from the cache, the older ones are searched again
+        for (int goal = size - 1; goal >= 0; --goal)
+        {
+            const std::vector<ESM::Pathgrid::Point> path = graph.aStarSearch(0, goal);
+            ASSERT_EQ(path.size(), paths[goal].size());
+            EXPECT_TRUE(std::equal(path.begin(), path.end(), paths[goal].begin(), isSamePoint)) << goal;
+        }
+    }
+
+    /// Disabled by default, run it with --gtest_also_run_disabled_tests and read the timings from the
+    /// --gtest_output report.
+    TEST(MWMechanicsPathgridGraphBenchmark, DISABLED_a_star_search_for_all_pathgrids)
+    {
+        const std::vector<ESM::Pathgrid> pathgrids = getBenchmarkPathgrids();
+        const ESM::Cell cell;
+        using Ms = std::chrono::duration<double, std::milli>;
+
+        std::size_t queries = 0;
+        std::size_t found = 0;
+        std::chrono::steady_clock::duration sortedListTime {};
+        std::chrono::steady_clock::duration heapTime {};
+
+        for (const ESM::Pathgrid& pathgrid : pathgrids)
+        {
+            const PathgridGraph graph(&cell, &pathgrid);
+            const Graph referenceGraph = makeGraph(pathgrid);
+            const int size = static_cast<int>(pathgrid.mPoints.size());
+
+            // Every pair of points once, so that nothing comes from the cache
+            for (int start = 0; start < size; ++start)
+            {
+                for (int goal = 0; goal < size; ++goal)
+                {
+                    if (!graph.isPointConnected(start, goal))
+                        continue;
+
+                    auto begin = std::chrono::steady_clock::now();
+                    const bool hasPath = getPathCostWithSortedList(pathgrid, referenceGraph, start, goal) >= 0;
+                    sortedListTime += std::chrono::steady_clock::now() - begin;
+
+                    begin = std::chrono::steady_clock::now();
+                    const bool hasPathWithHeap = !graph.aStarSearch(start, goal).empty();
+                    heapTime += std::chrono::steady_clock::now() - begin;
+
+                    ASSERT_EQ(hasPathWithHeap, hasPath);
+                    ++queries;
+                    found += hasPath;
+                }
+            }
+        }
+
+        // Wandering actors go back and forth between a few points
+        std::mt19937 random(7);
+        std::size_t repeatedQueries = 0;
+        std::chrono::steady_clock::duration repeatedTime {};
+        for (const ESM::Pathgrid& pathgrid : pathgrids)
+        {
+            const PathgridGraph graph(&cell, &pathgrid);
+            std::uniform_int_distribution<int> point(0, static_cast<int>(pathgrid.mPoints.size()) - 1);
+            std::vector<std::pair<int, int>> pairs;
+            for (int i = 0; i < 16; ++i)
+                pairs.emplace_back(point(random), point(random));
+
+            const auto begin = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < 20; ++pass)
+                for (const auto& pair : pairs)
+                    graph.aStarSearch(pair.first, pair.second);
+            repeatedTime += std::chrono::steady_clock::now() - begin;
+            repeatedQueries += 20 * pairs.size();
+        }
+
+        RecordProperty("pathgrids", static_cast<int>(pathgrids.size()));
+        RecordProperty("searches", static_cast<int>(queries));
+        RecordProperty("paths", static_cast<int>(found));
+        RecordProperty("sorted_list_ms", static_cast<int>(Ms(sortedListTime).count()));
+        RecordProperty("binary_heap_ms", static_cast<int>(Ms(heapTime).count()));
+        RecordProperty("repeated_searches", static_cast<int>(repeatedQueries));
+        RecordProperty("repeated_searches_ms", static_cast<int>(Ms(repeatedTime).count()));
+    }
+}
@@ -0,0 +1,183 @@
+#include "apps/openmw/mwphysics/solverpool.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWPhysics;
+
+    TEST(MWPhysicsSolverPoolTest, run_should_call_job_once_for_each_index)
+    {
+        SolverPool pool(3);
+        for (std::size_t count : {0, 1, 2, 100, 1000})
+        {
+            std::vector<int> calls(count, 0);
+            pool.run(count, [&] (std::size_t i) { ++calls[i]; });
+            EXPECT_EQ(calls, std::vector<int>(count, 1));
+        }
+    }
+
+    TEST(MWPhysicsSolverPoolTest, run_should_pass_on_exception_after_all_calls_returned)
+    {
+        SolverPool pool(3);
+        std::vector<int> calls(100, 0);
+        EXPECT_THROW(pool.run(calls.size(), [&] (std::size_t i) {
+            ++calls[i];
+            if (i == 10)
+                throw std::runtime_error("test");
+        }), std::runtime_error);
+
+        // The pool can still be used afterwards
+        pool.run(calls.size(), [&] (std::size_t i) { calls[i] = 2; });
+        EXPECT_EQ(calls, std::vector<int>(calls.size(), 2));
+    }
+
+    class NotMeConvexResultCallback : public btCollisionWorld::ClosestConvexResultCallback
+    {
+    public:
+        NotMeConvexResultCallback(const btCollisionObject* me, const btVector3& from, const btVector3& to)
+            : btCollisionWorld::ClosestConvexResultCallback(from, to)
+            , mMe(me)
+        {
+        }
+
+        btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override
+        {
+            if (convexResult.m_hitCollisionObject == mMe)
+                return 1;
+            return ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+        }
+
+    private:
+        const btCollisionObject* mMe;
+    };
+
+    /// A crowd of capsules walking in circles on a box, swept against each other like PhysicsSystem moves actors
+    struct Crowd
+    {
+        btDefaultCollisionConfiguration mConfiguration;
+        btCollisionDispatcher mDispatcher;
+        btDbvtBroadphase mBroadphase;
+        btCollisionWorld mWorld;
+        btBoxShape mGroundShape;
+        btCapsuleShapeZ mActorShape;
+        btCollisionObject mGround;
+        std::vector<std::unique_ptr<btCollisionObject>> mActors;
+
+        Crowd(int numActors)
+            : mDispatcher(&mConfiguration)
+            , mWorld(&mDispatcher, &mBroadphase, &mConfiguration)
+            , mGroundShape(btVector3(8192, 8192, 100))
+            , mActorShape(30, 68)
+        {
+            mGround.setCollisionShape(&mGroundShape);
+            mGround.getWorldTransform().setOrigin(btVector3(0, 0, -100));
+            mWorld.addCollisionObject(&mGround);
+
+            const int side = static_cast<int>(std::ceil(std::sqrt(numActors)));
+            for (int i = 0; i < numActors; ++i)
+            {
+                std::unique_ptr<btCollisionObject> actor(new btCollisionObject);
+                actor->setCollisionShape(&mActorShape);
+                actor->getWorldTransform().setOrigin(btVector3((i % side) * 100.f, (i / side) * 100.f, 65));
+                mWorld.addCollisionObject(actor.get());
+                mActors.push_back(std::move(actor));
+            }
+        }
+
+        /// Move each actor for the given number of steps, only reading the collision world
+        std::vector<btVector3> solve(SolverPool& pool, int numSteps)
+        {
+            std::vector<btVector3> positions(mActors.size());
+            pool.run(mActors.size(), [&] (std::size_t i)
+            {
+                const btCollisionObject* actor = mActors[i].get();
+                btVector3 position = actor->getWorldTransform().getOrigin();
+                for (int step = 0; step < numSteps; ++step)
+                {
+                    const float angle = (i + step) * 0.1f;
+                    const btVector3 velocity(std::cos(angle) * 300.f, std::sin(angle) * 300.f, -10.f);
+                    // Several sweeps per step, as MovementSolver::move slides along and steps up obstacles
+                    for (int iteration = 0; iteration < 4; ++iteration)
+                    {
+                        btTransform from = actor->getWorldTransform();
+                        btTransform to = from;
+                        from.setOrigin(position);
+                        to.setOrigin(position + velocity / 60.f);
+                        NotMeConvexResultCallback callback(actor, from.getOrigin(), to.getOrigin());
+                        mWorld.convexSweepTest(&mActorShape, from, to, callback);
+                        position = from.getOrigin().lerp(to.getOrigin(), callback.m_closestHitFraction);
+                    }
+                }
+                positions[i] = position;
+            });
+            return positions;
+        }
+    };
+
+    std::size_t getThreadSafeThreads()
+    {
+#if BT_BULLET_VERSION >= 287
+        btDbvtBroadphase broadphase;
+        if (broadphase.m_rayTestStacks.size() > 1)
+            return 3;
+#endif
+        return 0;
+    }
+
+    TEST(MWPhysicsSolverPoolTest, results_should_not_depend_on_number_of_threads)
+    {
+        Crowd crowd(50);
+        SolverPool serialPool(0);
+        SolverPool parallelPool(getThreadSafeThreads());
+
+        EXPECT_EQ(crowd.solve(serialPool, 5), crowd.solve(parallelPool, 5));
+    }
+
+    /// Compares the time to move a crowd on the main thread and with additional threads. Disabled by default,
+    /// run it with --gtest_also_run_disabled_tests and read the timings from the --gtest_output report.
+    TEST(MWPhysicsSolverPoolTest, DISABLED_benchmark_500_actors)
+    {
+        // Without multithreading support in Bullet, both pools use only the main thread
+        const std::size_t numThreads = getThreadSafeThreads();
+
+        Crowd crowd(500);
+        SolverPool serialPool(0);
+        SolverPool parallelPool(numThreads);
+
+        const int frames = 10;
+        const int numSteps = 20;
+        std::chrono::steady_clock::duration serialTime {};
+        std::chrono::steady_clock::duration parallelTime {};
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            auto start = std::chrono::steady_clock::now();
+            const std::vector<btVector3> serial = crowd.solve(serialPool, numSteps);
+            serialTime += std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            const std::vector<btVector3> parallel = crowd.solve(parallelPool, numSteps);
+            parallelTime += std::chrono::steady_clock::now() - start;
+
+            // Results must not depend on the number of threads
+            ASSERT_EQ(serial, parallel);
+        }
+
+        using Us = std::chrono::duration<double, std::micro>;
+        RecordProperty("additional_threads", static_cast<int>(numThreads));
+        RecordProperty("main_thread_us_per_frame", static_cast<int>(Us(serialTime).count() / frames));
+        RecordProperty("with_threads_us_per_frame", static_cast<int>(Us(parallelTime).count() / frames));
+    }
+}
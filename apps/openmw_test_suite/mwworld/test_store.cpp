@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <map>
+
 #include <boost/filesystem/fstream.hpp>
 
 #include <components/files/configurationmanager.hpp>
@@ -313,3 +316,192 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that records parsed ahead of time are merged like loaded ones.
+TEST_F(StoreTest, parse_merge_test)
+{
+    const std::string recordId = "foobar";
+
+    typedef ESM::Apparatus RecordType;
+
+    RecordType record;
+    record.blank();
+    record.mId = recordId;
+
+    ESM::ESMReader reader;
+    std::vector<ESM::ESMReader> readerList;
+    readerList.push_back(reader);
+    reader.setGlobalReaderList(&readerList);
+
+    // master file inserts a record
+    Files::IStreamPtr file = getEsmFile(record, false);
+    reader.open(file, "filename");
+    mEsmStore.prepareLoad(reader);
+
+    MWWorld::ESMStore::ParsedFile parsed;
+    mEsmStore.parse(reader, parsed);
+
+    ASSERT_TRUE (parsed.size() == 1);
+    ASSERT_TRUE (mEsmStore.get<RecordType>().getSize() == 0);
+
+    mEsmStore.merge(reader, parsed, &dummyListener);
+    mEsmStore.setUp();
+
+    ASSERT_TRUE (mEsmStore.get<RecordType>().getSize() == 1);
+
+    // now a plugin deletes it
+    file = getEsmFile(record, true);
+    reader.open(file, "filename");
+    mEsmStore.prepareLoad(reader);
+
+    parsed.clear();
+    mEsmStore.parse(reader, parsed);
+    mEsmStore.merge(reader, parsed, &dummyListener);
+    mEsmStore.setUp();
+
+    ASSERT_TRUE (mEsmStore.get<RecordType>().getSize() == 0);
+}
+
+/// Tests restoring records from the content cache.
+TEST_F(StoreTest, cache_test)
+{
+    const std::string recordId = "foobar";
+
+    typedef ESM::Apparatus RecordType;
+
+    RecordType record;
+    record.blank();
+    record.mId = recordId;
+
+    ESM::ESMReader reader;
+    std::vector<ESM::ESMReader> readerList;
+    readerList.push_back(reader);
+    reader.setGlobalReaderList(&readerList);
+
+    Files::IStreamPtr file = getEsmFile(record, false);
+    reader.open(file, "filename");
+    mEsmStore.load(reader, &dummyListener);
+    mEsmStore.setUp();
+
+    ESM::ESMWriter writer;
+    std::stringstream* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+    mEsmStore.writeCache(writer);
+
+    MWWorld::ESMStore cachedStore;
+    reader.open(Files::IStreamPtr(stream), "cache");
+    cachedStore.readCache(reader);
+    cachedStore.setUp();
+
+    ASSERT_TRUE (cachedStore.get<RecordType>().getSize() == 1);
+    ASSERT_TRUE (cachedStore.get<RecordType>().find(recordId)->mId == recordId);
+
+    // records that are in the cache are skipped when the content file is loaded afterwards
+    file = getEsmFile(record, false);
+    reader.open(file, "filename");
+    cachedStore.prepareLoad(reader);
+
+    MWWorld::ESMStore::ParsedFile parsed;
+    cachedStore.parse(reader, parsed);
+
+    ASSERT_TRUE (parsed.empty());
+
+    // a cache that failed to load is cleared, so that the content file is loaded instead
+    cachedStore.clearCache();
+    cachedStore.setUp();
+
+    ASSERT_TRUE (cachedStore.get<RecordType>().getSize() == 0);
+
+    file = getEsmFile(record, false);
+    reader.open(file, "filename");
+    cachedStore.parse(reader, parsed);
+
+    ASSERT_TRUE (parsed.size() == 1);
+}
+
+/// Compares the time of Store lookups with lower-casing the ID and searching an ordered map, as the
+/// Store used to do. Disabled by default, run it with --gtest_also_run_disabled_tests and read the
+/// timings from the --gtest_output report.
+TEST_F(StoreTest, DISABLED_search_benchmark)
+{
+    typedef ESM::Static RecordType;
+
+    const size_t recordCount = 20000;
+    const size_t lookupCount = 1000000;
+
+    MWWorld::Store<RecordType> &store = const_cast<MWWorld::Store<RecordType>&>(mEsmStore.get<RecordType>());
+    std::map<std::string, RecordType> orderedMap;
+    std::vector<std::string> lookupIds;
+
+    for (size_t i = 0; i < recordCount; ++i)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = "Furn_De_Bench_" + std::to_string(i);
+        store.insertStatic(record);
+        orderedMap[Misc::StringUtils::lowerCase(record.mId)] = record;
+        lookupIds.push_back(record.mId);
+    }
+
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+        found += store.search(lookupIds[(i * 7919) % recordCount]) != nullptr;
+    auto storeTime = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(found, lookupCount);
+
+    found = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lookupCount; ++i)
+        found += orderedMap.find(Misc::StringUtils::lowerCase(lookupIds[(i * 7919) % recordCount])) != orderedMap.end();
+    auto orderedMapTime = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(found, lookupCount);
+
+    RecordProperty("store_ms", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(storeTime).count()));
+    RecordProperty("lower_cased_map_ms",
+                   static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(orderedMapTime).count()));
+}
+
+/// Tests that dynamic records are written in the order of their IDs.
+TEST_F(StoreTest, write_sorted_test)
+{
+    typedef ESM::Potion RecordType;
+
+    const std::vector<std::string> recordIds = {"potion_c", "Potion_A", "potion_d", "POTION_B"};
+
+    MWWorld::Store<RecordType> &store = const_cast<MWWorld::Store<RecordType>&>(mEsmStore.get<RecordType>());
+
+    for (const std::string &recordId : recordIds)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = recordId;
+        store.insert(record);
+    }
+
+    ESM::ESMWriter writer;
+    std::stringstream* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+    store.write(writer, dummyListener);
+
+    ESM::ESMReader reader;
+    reader.open(Files::IStreamPtr(stream), "written");
+
+    std::vector<std::string> writtenIds;
+    while (reader.hasMoreRecs())
+    {
+        reader.getRecName();
+        reader.getRecHeader();
+
+        RecordType record;
+        bool isDeleted = false;
+        record.load(reader, isDeleted);
+        writtenIds.push_back(record.mId);
+    }
+
+    ASSERT_EQ (writtenIds, std::vector<std::string>({"Potion_A", "POTION_B", "potion_c", "potion_d"}));
+}
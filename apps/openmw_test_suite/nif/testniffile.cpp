@@ -0,0 +1,106 @@
+#include <components/files/memorystream.hpp>
+#include <components/nif/extra.hpp>
+#include <components/nif/niffile.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace Nif;
+
+    struct NifFileTest : Test
+    {
+        std::string mData;
+
+        NifFileTest()
+        {
+            mData = "NetImmerse File Format, Version 4.0.0.2\n";
+            writeUInt(NIFFile::VER_MW);
+            writeUInt(2); // records
+
+            writeString("NiTextKeyExtraData");
+            writeUInt(1); // next extra
+            writeUInt(0); // record size
+            writeUInt(2); // keys
+            writeFloat(0.5f);
+            writeString("start");
+            writeFloat(1.5f);
+            writeString(std::string("stop\0ignored", 12));
+
+            writeString("NiStringExtraData");
+            writeUInt(static_cast<std::uint32_t>(-1));
+            writeUInt(0);
+            writeString("sgoKeep");
+
+            writeUInt(1); // roots
+            writeUInt(0);
+        }
+
+        void writeUInt(std::uint32_t value)
+        {
+            mData.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeFloat(float value)
+        {
+            mData.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void writeString(const std::string& value)
+        {
+            writeUInt(static_cast<std::uint32_t>(value.size()));
+            mData += value;
+        }
+
+        void checkRecords(const NIFFile& nif)
+        {
+            ASSERT_EQ(nif.numRecords(), 2u);
+            ASSERT_EQ(nif.numRoots(), 1u);
+
+            const NiTextKeyExtraData* textKeys = dynamic_cast<const NiTextKeyExtraData*>(nif.getRoot());
+            ASSERT_NE(textKeys, nullptr);
+            ASSERT_EQ(textKeys->list.size(), 2u);
+            EXPECT_EQ(textKeys->list[0].time, 0.5f);
+            EXPECT_EQ(textKeys->list[0].text, "start");
+            EXPECT_EQ(textKeys->list[1].time, 1.5f);
+            EXPECT_EQ(textKeys->list[1].text, "stop");
+
+            const NiStringExtraData* string = dynamic_cast<const NiStringExtraData*>(textKeys->next.getPtr());
+            ASSERT_NE(string, nullptr);
+            EXPECT_EQ(string->string, "sgoKeep");
+            EXPECT_TRUE(string->next.empty());
+        }
+    };
+
+    TEST_F(NifFileTest, should_parse_memory_stream_in_place)
+    {
+        const NIFFile nif(std::make_shared<Files::IMemStream>(mData.data(), mData.size()), "test.nif");
+        checkRecords(nif);
+    }
+
+    TEST_F(NifFileTest, should_parse_file_stream)
+    {
+        const NIFFile nif(std::make_shared<std::istringstream>(mData), "test.nif");
+        checkRecords(nif);
+    }
+
+    TEST_F(NifFileTest, should_throw_on_truncated_file)
+    {
+        for (size_t size : {mData.size() - 1, mData.size() / 2, size_t(50)})
+        {
+            const std::string truncated = mData.substr(0, size);
+            EXPECT_THROW(NIFFile(std::make_shared<std::istringstream>(truncated), "test.nif"), std::runtime_error);
+        }
+    }
+
+    TEST_F(NifFileTest, should_throw_on_unknown_record)
+    {
+        const std::string::size_type found = mData.find("NiStringExtraData");
+        mData.replace(found, std::strlen("NiStringExtraData"), "NiStringExtraDatb");
+        EXPECT_THROW(NIFFile(std::make_shared<std::istringstream>(mData), "test.nif"), std::runtime_error);
+    }
+}
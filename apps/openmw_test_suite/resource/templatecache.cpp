@@ -0,0 +1,165 @@
+#include <components/resource/templatecache.hpp>
+#include <components/nifosg/userdata.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osg/NodeCallback>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    /// OSG has no serializer for this callback, so a template using it can't be read back.
+    struct UnserializableCallback : osg::NodeCallback
+    {
+    };
+
+    osg::ref_ptr<osg::Group> makeTemplate()
+    {
+        osg::ref_ptr<osg::Geometry> geometry (new osg::Geometry);
+        osg::ref_ptr<osg::Vec3Array> vertices (new osg::Vec3Array);
+        vertices->push_back(osg::Vec3f(0, 0, 0));
+        vertices->push_back(osg::Vec3f(1, 0, 0));
+        vertices->push_back(osg::Vec3f(1, 1, 0));
+        geometry->setVertexArray(vertices);
+        geometry->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, 3));
+
+        Nif::Matrix3 rotationScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                rotationScale.mValues[i][j] = i == j ? 2.f : 0.f;
+
+        osg::ref_ptr<osg::Group> node (new osg::Group);
+        node->setName("Bip01");
+        node->getOrCreateUserDataContainer()->addUserObject(new NifOsg::NodeUserData(42, 2.f, rotationScale));
+        node->addChild(geometry);
+        return node;
+    }
+
+    struct ResourceTemplateCacheTest : Test
+    {
+        const std::string mKey {"meshes\\x\\ex_common_house_tall_02.nif;optimizer=1"};
+        const std::uint64_t mSourceHash {0x1234};
+        const boost::filesystem::path mPath = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw_test_templates_%%%%%%%%");
+
+        ~ResourceTemplateCacheTest()
+        {
+            boost::filesystem::remove_all(mPath);
+        }
+    };
+
+    TEST_F(ResourceTemplateCacheTest, read_for_empty_cache_should_return_null)
+    {
+        TemplateCache cache(mPath.string());
+
+        bool cacheable = true;
+        EXPECT_FALSE(cache.read(mKey, mSourceHash, nullptr, cacheable));
+        EXPECT_TRUE(cacheable);
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_should_return_written_template)
+    {
+        TemplateCache cache(mPath.string());
+        cache.write(mKey, mSourceHash, *makeTemplate(), nullptr);
+
+        bool cacheable = true;
+        const osg::ref_ptr<osg::Node> result = cache.read(mKey, mSourceHash, nullptr, cacheable);
+        ASSERT_TRUE(result);
+        EXPECT_TRUE(cacheable);
+        EXPECT_EQ(result->getName(), "Bip01");
+
+        ASSERT_TRUE(result->getUserDataContainer());
+        ASSERT_EQ(result->getUserDataContainer()->getNumUserObjects(), 1u);
+        const NifOsg::NodeUserData* userData
+            = dynamic_cast<const NifOsg::NodeUserData*>(result->getUserDataContainer()->getUserObject(0));
+        ASSERT_TRUE(userData);
+        EXPECT_EQ(userData->mIndex, 42);
+        EXPECT_EQ(userData->mScale, 2.f);
+        EXPECT_EQ(userData->mRotationScale.mValues[1][1], 2.f);
+        EXPECT_EQ(userData->mRotationScale.mValues[0][1], 0.f);
+
+        ASSERT_TRUE(result->asGroup());
+        ASSERT_EQ(result->asGroup()->getNumChildren(), 1u);
+        const osg::Geometry* geometry = result->asGroup()->getChild(0)->asGeometry();
+        ASSERT_TRUE(geometry);
+        ASSERT_TRUE(geometry->getVertexArray());
+        EXPECT_EQ(geometry->getVertexArray()->getNumElements(), 3u);
+        EXPECT_EQ(geometry->getNumPrimitiveSets(), 1u);
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_should_return_template_written_by_other_instance)
+    {
+        TemplateCache(mPath.string()).write(mKey, mSourceHash, *makeTemplate(), nullptr);
+
+        TemplateCache cache(mPath.string());
+        bool cacheable = true;
+        EXPECT_TRUE(cache.read(mKey, mSourceHash, nullptr, cacheable));
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_for_changed_source_should_return_null)
+    {
+        TemplateCache cache(mPath.string());
+        cache.write(mKey, mSourceHash, *makeTemplate(), nullptr);
+
+        bool cacheable = true;
+        EXPECT_FALSE(cache.read(mKey, mSourceHash + 1, nullptr, cacheable));
+        EXPECT_TRUE(cacheable);
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_for_other_key_should_return_null)
+    {
+        TemplateCache cache(mPath.string());
+        cache.write(mKey, mSourceHash, *makeTemplate(), nullptr);
+
+        bool cacheable = true;
+        EXPECT_FALSE(cache.read(mKey + ";markers=1", mSourceHash, nullptr, cacheable));
+        EXPECT_TRUE(cacheable);
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_should_return_newest_written_template)
+    {
+        TemplateCache cache(mPath.string());
+        cache.write(mKey, mSourceHash, *makeTemplate(), nullptr);
+
+        osg::ref_ptr<osg::Group> changed = makeTemplate();
+        changed->setName("Bip02");
+        cache.write(mKey, mSourceHash + 1, *changed, nullptr);
+
+        bool cacheable = true;
+        EXPECT_FALSE(cache.read(mKey, mSourceHash, nullptr, cacheable));
+        const osg::ref_ptr<osg::Node> result = cache.read(mKey, mSourceHash + 1, nullptr, cacheable);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->getName(), "Bip02");
+    }
+
+    TEST_F(ResourceTemplateCacheTest, read_for_template_that_does_not_read_back_should_report_not_cacheable)
+    {
+        TemplateCache cache(mPath.string());
+        osg::ref_ptr<osg::Group> node = makeTemplate();
+        node->setUpdateCallback(new UnserializableCallback);
+        cache.write(mKey, mSourceHash, *node, nullptr);
+
+        bool cacheable = true;
+        EXPECT_FALSE(cache.read(mKey, mSourceHash, nullptr, cacheable));
+        EXPECT_FALSE(cacheable);
+    }
+
+    TEST_F(ResourceTemplateCacheTest, hash_source_should_depend_on_contents)
+    {
+        std::istringstream source("NetImmerse File Format");
+        std::istringstream sameSource("NetImmerse File Format");
+        std::istringstream changedSource("NetImmerse File Format!");
+
+        const std::uint64_t hash = TemplateCache::hashSource(source);
+        EXPECT_EQ(hash, TemplateCache::hashSource(sameSource));
+        EXPECT_NE(hash, TemplateCache::hashSource(changedSource));
+    }
+}
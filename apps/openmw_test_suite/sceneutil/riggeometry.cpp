@@ -0,0 +1,416 @@
+#include <components/files/constrainedfilestream.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/sceneutil/clone.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/skeleton.hpp>
+#include <components/sceneutil/skinningbatch.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <osg/MatrixTransform>
+#include <osg/TriangleFunctor>
+#include <osg/Version>
+#include <osgUtil/UpdateVisitor>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct CollectVertices
+    {
+        std::vector<osg::Vec3f>* mVertices = nullptr;
+
+#if OSG_MIN_VERSION_REQUIRED(3,5,6)
+        void operator()(const osg::Vec3 v1, const osg::Vec3 v2, const osg::Vec3 v3)
+#else
+        void operator()(const osg::Vec3 v1, const osg::Vec3 v2, const osg::Vec3 v3, bool)
+#endif
+        {
+            mVertices->push_back(v1);
+            mVertices->push_back(v2);
+            mVertices->push_back(v3);
+        }
+    };
+
+    std::vector<osg::Vec3f> getVertices(const RigGeometry& rig)
+    {
+        std::vector<osg::Vec3f> result;
+        osg::TriangleFunctor<CollectVertices> functor;
+        functor.mVertices = &result;
+        rig.accept(functor);
+        return result;
+    }
+
+    class CollectRigsAndBones : public osg::NodeVisitor
+    {
+    public:
+        std::vector<osg::ref_ptr<RigGeometry>> mRigs;
+        std::vector<osg::ref_ptr<osg::MatrixTransform>> mBones;
+
+        CollectRigsAndBones()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+        {
+        }
+
+        void apply(osg::MatrixTransform& node) override
+        {
+            mBones.push_back(&node);
+            traverse(node);
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            if (RigGeometry* rig = dynamic_cast<RigGeometry*>(&drawable))
+                mRigs.push_back(rig);
+        }
+    };
+
+    void update(osg::Node& root, unsigned int traversalNumber)
+    {
+        osgUtil::UpdateVisitor visitor;
+        visitor.setTraversalNumber(traversalNumber);
+        root.accept(visitor);
+    }
+
+    osg::ref_ptr<osg::Geometry> makeSourceGeometry(const std::vector<osg::Vec3f>& positions)
+    {
+        osg::ref_ptr<osg::Vec3Array> vertices(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+        for (const osg::Vec3f& position : positions)
+        {
+            vertices->push_back(position);
+            normals->push_back(osg::Vec3f(0, 0, 1));
+        }
+
+        osg::ref_ptr<osg::Geometry> result(new osg::Geometry);
+        result->setVertexArray(vertices);
+        result->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+        result->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(positions.size())));
+        return result;
+    }
+
+    osg::ref_ptr<osg::MatrixTransform> makeBone(const std::string& name, const osg::Matrixf& matrix)
+    {
+        osg::ref_ptr<osg::MatrixTransform> result(new osg::MatrixTransform(matrix));
+        result->setName(name);
+        return result;
+    }
+
+    /// A skeleton with a chain of bones for the spine and every limb, like the one of an NPC, and a rig of about the size
+    /// of an NPC body, whose vertices are each influenced by one or two neighbouring bones
+    osg::ref_ptr<osg::Node> makeActor(std::mt19937& random)
+    {
+        const int limbs = 5;
+        const int bonesPerLimb = 7;
+        const float boneLength = 10;
+        const std::size_t vertices = 2400;
+
+        osg::ref_ptr<Skeleton> skeleton(new Skeleton);
+        osg::ref_ptr<RigGeometry::InfluenceMap> influenceMap(new RigGeometry::InfluenceMap);
+        std::vector<osg::Vec3f> bindPositions;
+
+        for (int limb = 0; limb < limbs; ++limb)
+        {
+            const osg::Vec3f limbOffset(limb * 15.0f, 0, 0);
+            osg::Group* parent = skeleton;
+            for (int i = 0; i < bonesPerLimb; ++i)
+            {
+                const std::string name = "Bone " + std::to_string(limb) + " " + std::to_string(i);
+                const osg::Vec3f offset = i == 0 ? limbOffset : osg::Vec3f(0, 0, boneLength);
+                osg::ref_ptr<osg::MatrixTransform> bone = makeBone(name, osg::Matrixf::translate(offset));
+                parent->addChild(bone);
+                parent = bone;
+
+                const osg::Vec3f bindPosition = limbOffset + osg::Vec3f(0, 0, boneLength * i);
+                RigGeometry::BoneInfluence influence;
+                influence.mInvBindMatrix = osg::Matrixf::translate(-bindPosition);
+                influence.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(0, 0, boneLength / 2), boneLength);
+                influenceMap->mData.emplace_back(name, influence);
+                bindPositions.push_back(bindPosition);
+            }
+        }
+
+        std::uniform_int_distribution<int> boneIndex(0, limbs * bonesPerLimb - 1);
+        std::uniform_real_distribution<float> offset(-3, 3);
+        std::uniform_real_distribution<float> weight(0.3f, 1);
+        std::vector<osg::Vec3f> positions;
+        for (std::size_t i = 0; i < vertices; ++i)
+        {
+            const int bone = boneIndex(random);
+            const unsigned short vertex = static_cast<unsigned short>(i);
+            positions.push_back(bindPositions[bone] + osg::Vec3f(offset(random), offset(random), offset(random) + boneLength / 2));
+            if ((bone + 1) % bonesPerLimb == 0)
+            {
+                influenceMap->mData[bone].second.mWeights.emplace_back(vertex, 1.0f);
+                continue;
+            }
+            const float first = weight(random);
+            influenceMap->mData[bone].second.mWeights.emplace_back(vertex, first);
+            influenceMap->mData[bone + 1].second.mWeights.emplace_back(vertex, 1 - first);
+        }
+
+        osg::ref_ptr<RigGeometry> rig(new RigGeometry);
+        rig->setSourceGeometry(makeSourceGeometry(positions));
+        rig->setInfluenceMap(influenceMap);
+        skeleton->addChild(rig);
+
+        return skeleton;
+    }
+
+    /// A skinned model given by the OPENMW_TEST_SKINNED_NIF environment variable, e.g. the skins of a vanilla NPC
+    /// body like meshes/b/B_N_Dark Elf_M_Skins.nif extracted from Morrowind.bsa, or a generated one of similar size
+    osg::ref_ptr<osg::Node> getBenchmarkActor()
+    {
+        if (const char* const path = std::getenv("OPENMW_TEST_SKINNED_NIF"))
+        {
+            VFS::Manager vfs(false);
+            vfs.buildIndex();
+            Resource::ImageManager imageManager(&vfs);
+            const Nif::NIFFilePtr file(new Nif::NIFFile(Files::openConstrainedFileStream(path), path));
+            return NifOsg::Loader::load(file, &imageManager);
+        }
+
+        std::mt19937 random(42);
+        return makeActor(random);
+    }
+
+    /// The vertex array the rig is rendered from, to tell its two buffers apart
+    const osg::Vec3* getRenderedVertexArray(const RigGeometry& rig)
+    {
+        struct GetVertexArray : osg::TriangleFunctor<CollectVertices>
+        {
+            const osg::Vec3* get() const { return _vertexArrayPtr; }
+        };
+
+        std::vector<osg::Vec3f> vertices;
+        GetVertexArray functor;
+        functor.mVertices = &vertices;
+        rig.accept(functor);
+        return functor.get();
+    }
+
+    void animate(const std::vector<osg::ref_ptr<osg::MatrixTransform>>& bones,
+                 const std::vector<osg::Matrix>& bindMatrices, int frame)
+    {
+        for (std::size_t i = 0; i < bones.size(); ++i)
+            bones[i]->setMatrix(osg::Matrix::rotate(0.01 * ((frame + i) % 20), osg::Vec3(1, 0, 0)) * bindMatrices[i]);
+    }
+
+    TEST(SceneUtilRigGeometryTest, skin_should_blend_bone_matrices_by_weights)
+    {
+        osg::ref_ptr<Skeleton> skeleton(new Skeleton);
+        osg::ref_ptr<osg::MatrixTransform> first = makeBone("First", osg::Matrixf::translate(2, 0, 0));
+        osg::ref_ptr<osg::MatrixTransform> second = makeBone("Second", osg::Matrixf::translate(0, 4, 0));
+        skeleton->addChild(first);
+        skeleton->addChild(second);
+
+        osg::ref_ptr<RigGeometry::InfluenceMap> influenceMap(new RigGeometry::InfluenceMap);
+        RigGeometry::BoneInfluence influence;
+        influence.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(0, 0, 0), 1);
+        influence.mWeights = {{0, 1.0f}, {1, 0.5f}, {2, 0.25f}};
+        influenceMap->mData.emplace_back("First", influence);
+        influence.mWeights = {{1, 0.5f}, {2, 0.75f}};
+        influenceMap->mData.emplace_back("Second", influence);
+
+        osg::ref_ptr<RigGeometry> rig(new RigGeometry);
+        rig->setSourceGeometry(makeSourceGeometry({osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(0, 0, 1)}));
+        rig->setInfluenceMap(influenceMap);
+        skeleton->addChild(rig);
+
+        update(*skeleton, 1);
+        rig->skin(1);
+
+        const std::vector<osg::Vec3f> expected {osg::Vec3f(2, 0, 0), osg::Vec3f(2, 2, 0), osg::Vec3f(0.5f, 3, 1)};
+        EXPECT_EQ(getVertices(*rig), expected);
+
+        // Moved bones are skinned again
+        second->setMatrix(osg::Matrixf::translate(0, 0, 4));
+        update(*skeleton, 2);
+        rig->skin(2);
+
+        const std::vector<osg::Vec3f> moved {osg::Vec3f(2, 0, 0), osg::Vec3f(2, 0, 2), osg::Vec3f(0.5f, 0, 4)};
+        EXPECT_EQ(getVertices(*rig), moved);
+    }
+
+    TEST(SceneUtilRigGeometryTest, skin_should_ignore_missing_bones)
+    {
+        osg::ref_ptr<Skeleton> skeleton(new Skeleton);
+        skeleton->addChild(makeBone("First", osg::Matrixf::translate(2, 0, 0)));
+
+        osg::ref_ptr<RigGeometry::InfluenceMap> influenceMap(new RigGeometry::InfluenceMap);
+        RigGeometry::BoneInfluence influence;
+        influence.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(0, 0, 0), 1);
+        influence.mWeights = {{0, 1.0f}, {1, 0.5f}};
+        influenceMap->mData.emplace_back("First", influence);
+        influence.mWeights = {{1, 0.5f}, {2, 1.0f}};
+        influenceMap->mData.emplace_back("Missing", influence);
+
+        osg::ref_ptr<RigGeometry> rig(new RigGeometry);
+        rig->setSourceGeometry(makeSourceGeometry({osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(0, 0, 1)}));
+        rig->setInfluenceMap(influenceMap);
+        skeleton->addChild(rig);
+
+        update(*skeleton, 1);
+        rig->skin(1);
+
+        // The weights of the missing bone are left out, without scaling up the other weights
+        const std::vector<osg::Vec3f> expected {osg::Vec3f(2, 0, 0), osg::Vec3f(1.5f, 0, 0), osg::Vec3f(0, 0, 0)};
+        EXPECT_EQ(getVertices(*rig), expected);
+
+        // Only the bone that was found bounds the rig
+        const osg::BoundingBox& box = rig->getBoundingBox();
+        EXPECT_EQ(box._min, osg::Vec3f(1, -1, -1));
+        EXPECT_EQ(box._max, osg::Vec3f(3, 1, 1));
+    }
+
+    TEST(SceneUtilRigGeometryTest, skin_should_keep_current_buffer_when_bones_did_not_move)
+    {
+        osg::ref_ptr<Skeleton> skeleton(new Skeleton);
+        osg::ref_ptr<osg::MatrixTransform> bone = makeBone("Bone", osg::Matrixf::translate(2, 0, 0));
+        skeleton->addChild(bone);
+
+        osg::ref_ptr<RigGeometry::InfluenceMap> influenceMap(new RigGeometry::InfluenceMap);
+        RigGeometry::BoneInfluence influence;
+        influence.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(0, 0, 0), 1);
+        influence.mWeights = {{0, 1.0f}, {1, 1.0f}, {2, 1.0f}};
+        influenceMap->mData.emplace_back("Bone", influence);
+
+        osg::ref_ptr<RigGeometry> rig(new RigGeometry);
+        rig->setSourceGeometry(makeSourceGeometry({osg::Vec3f(0, 0, 0), osg::Vec3f(1, 0, 0), osg::Vec3f(0, 0, 1)}));
+        rig->setInfluenceMap(influenceMap);
+        skeleton->addChild(rig);
+
+        update(*skeleton, 1);
+        rig->skin(1);
+        const osg::Vec3* skinned = getRenderedVertexArray(*rig);
+        const std::vector<osg::Vec3f> expected {osg::Vec3f(2, 0, 0), osg::Vec3f(3, 0, 0), osg::Vec3f(2, 0, 1)};
+        EXPECT_EQ(getVertices(*rig), expected);
+
+        for (unsigned int frame = 2; frame < 4; ++frame)
+        {
+            update(*skeleton, frame);
+            rig->skin(frame);
+            EXPECT_EQ(getRenderedVertexArray(*rig), skinned) << "frame=" << frame;
+            EXPECT_EQ(getVertices(*rig), expected) << "frame=" << frame;
+        }
+
+        // The other buffer is skinned once the bone moves
+        bone->setMatrix(osg::Matrixf::translate(0, 4, 0));
+        update(*skeleton, 4);
+        rig->skin(4);
+        EXPECT_NE(getRenderedVertexArray(*rig), skinned);
+        const std::vector<osg::Vec3f> moved {osg::Vec3f(0, 4, 0), osg::Vec3f(1, 4, 0), osg::Vec3f(0, 4, 1)};
+        EXPECT_EQ(getVertices(*rig), moved);
+    }
+
+    TEST(SceneUtilRigGeometryTest, skinning_batch_should_give_same_vertices_as_skinning_each_rig)
+    {
+        std::mt19937 random(13);
+        osg::ref_ptr<osg::Group> root(new osg::Group);
+        for (int i = 0; i < 20; ++i)
+            root->addChild(makeActor(random));
+
+        CollectRigsAndBones collected;
+        root->accept(collected);
+        std::vector<osg::Matrix> bindMatrices;
+        for (const auto& bone : collected.mBones)
+            bindMatrices.push_back(bone->getMatrix());
+
+        SkinningBatch batch(3);
+        for (unsigned int frame = 1; frame < 5; ++frame)
+        {
+            animate(collected.mBones, bindMatrices, frame);
+            update(*root, frame);
+
+            std::vector<std::vector<osg::Vec3f>> expected;
+            for (const auto& rig : collected.mRigs)
+            {
+                osg::ref_ptr<RigGeometry> copy(new RigGeometry(*rig, osg::CopyOp::SHALLOW_COPY));
+                rig->getParent(0)->addChild(copy);
+                update(*copy->getParent(0), frame);
+                copy->skin(frame);
+                expected.push_back(getVertices(*copy));
+                rig->getParent(0)->removeChild(copy);
+            }
+
+            for (const auto& rig : collected.mRigs)
+                batch.add(rig, frame);
+            batch.skin();
+
+            for (std::size_t i = 0; i < collected.mRigs.size(); ++i)
+                EXPECT_EQ(getVertices(*collected.mRigs[i]), expected[i]) << "frame=" << frame << " rig=" << i;
+        }
+    }
+
+    /// Disabled by default, run it with --gtest_also_run_disabled_tests and read the timings from the
+    /// --gtest_output report.
+    TEST(SceneUtilRigGeometryBenchmark, DISABLED_skin_100_actors)
+    {
+        const osg::ref_ptr<osg::Node> actor = getBenchmarkActor();
+        const int actors = 100;
+        const int frames = 50;
+
+        osg::ref_ptr<osg::Group> root(new osg::Group);
+        for (int i = 0; i < actors; ++i)
+        {
+            SceneUtil::CopyOp copyop;
+            root->addChild(osg::clone(actor.get(), copyop));
+        }
+
+        CollectRigsAndBones collected;
+        root->accept(collected);
+        std::vector<osg::Matrix> bindMatrices;
+        for (const auto& bone : collected.mBones)
+            bindMatrices.push_back(bone->getMatrix());
+
+        const int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        unsigned int traversalNumber = 0;
+        using Us = std::chrono::duration<double, std::micro>;
+
+        const auto skinFrames = [&] (SkinningBatch& batch, bool moveBones)
+        {
+            std::chrono::steady_clock::duration result {};
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                ++traversalNumber;
+                if (moveBones)
+                    animate(collected.mBones, bindMatrices, frame);
+                update(*root, traversalNumber);
+                for (const auto& rig : collected.mRigs)
+                    batch.add(rig, traversalNumber);
+
+                const auto start = std::chrono::steady_clock::now();
+                batch.skin();
+                result += std::chrono::steady_clock::now() - start;
+            }
+            return static_cast<int>(Us(result).count() / frames);
+        };
+
+        SkinningBatch serial(0);
+        skinFrames(serial, true);
+        const int serialTime = skinFrames(serial, true);
+
+        SkinningBatch parallel(threads);
+        const int parallelTime = skinFrames(parallel, true);
+        const int unchangedTime = skinFrames(parallel, false);
+
+        RecordProperty("actors", actors);
+        RecordProperty("rigs", static_cast<int>(collected.mRigs.size()));
+        RecordProperty("threads", threads + 1);
+        RecordProperty("one_thread_us_per_frame", serialTime);
+        RecordProperty("all_threads_us_per_frame", parallelTime);
+        RecordProperty("unchanged_bones_us_per_frame", unchangedTime);
+    }
+}
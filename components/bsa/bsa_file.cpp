@@ -24,13 +24,33 @@
 #include "bsa_file.hpp"
 
 #include <cassert>
+#include <stdexcept>
 
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <components/files/memorystream.hpp>
 
 using namespace std;
 using namespace Bsa;
 
+namespace
+{
+    /// Reads a file straight out of a memory mapped archive, and keeps the mapping alive while it is open
+    struct MappedFileStream : Files::IMemStream
+    {
+        MappedFileStream(std::shared_ptr<boost::iostreams::mapped_file_source> archive, size_t offset, size_t size)
+            : Files::MemBuf(archive->data() + offset, size)
+            , Files::IMemStream(archive->data() + offset, size)
+            , mArchive(std::move(archive))
+        {
+        }
+
+        std::shared_ptr<boost::iostreams::mapped_file_source> mArchive;
+    };
+}
+
 
 /// Error handling
 void BSAFile::fail(const string &msg)
@@ -163,9 +183,35 @@ int BSAFile::getIndex(const char *str) const
 void BSAFile::open(const string &file)
 {
     mFilename = file;
+
+    try
+    {
+        mMappedFile = std::make_shared<boost::iostreams::mapped_file_source>(mFilename);
+        if (!mMappedFile->is_open())
+            mMappedFile.reset();
+    }
+    catch (std::exception&)
+    {
+        // Large archives may not fit into a 32-bit address space, and some filesystems can't be mapped at all
+        mMappedFile.reset();
+    }
+
     readHeader();
 }
 
+Files::IStreamPtr BSAFile::openStream(size_t offset, size_t size) const
+{
+    if (mMappedFile)
+    {
+        if (offset > mMappedFile->size() || size > mMappedFile->size() - offset)
+            throw std::runtime_error("BSA Error: File data outside of the archive\nArchive: " + mFilename);
+
+        return std::make_shared<MappedFileStream>(mMappedFile, offset, size);
+    }
+
+    return Files::openConstrainedFileStream (mFilename.c_str (), offset, size);
+}
+
 Files::IStreamPtr BSAFile::getFile(const char *file)
 {
     assert(file);
@@ -175,10 +221,10 @@ Files::IStreamPtr BSAFile::getFile(const char *file)
 
     const FileStruct &fs = mFiles[i];
 
-    return Files::openConstrainedFileStream (mFilename.c_str (), fs.offset, fs.fileSize);
+    return openStream (fs.offset, fs.fileSize);
 }
 
 Files::IStreamPtr BSAFile::getFile(const FileStruct *file)
 {
-    return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
+    return openStream (file->offset, file->fileSize);
 }
@@ -28,11 +28,19 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include <components/misc/stringops.hpp>
 
 #include <components/files/constrainedfilestream.hpp>
 
+namespace boost
+{
+namespace iostreams
+{
+    class mapped_file_source;
+}
+}
 
 namespace Bsa
 {
@@ -69,6 +77,10 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
+    /// The whole archive, when it could be memory mapped. Shared with the streams returned by getFile(),
+    /// so that they stay valid after the archive is closed.
+    std::shared_ptr<boost::iostreams::mapped_file_source> mMappedFile;
+
     /// Case insensitive string comparison
     struct iltstr
     {
@@ -96,6 +108,10 @@ protected:
     /// @note Thread safe.
     int getIndex(const char *str) const;
 
+    /// Open a stream over the given part of the archive, without copying it if the archive is memory mapped
+    /// @note Thread safe.
+    Files::IStreamPtr openStream(size_t offset, size_t size) const;
+
 public:
     /* -----------------------------------
      * BSA management methods
@@ -109,9 +125,13 @@ public:
     virtual ~BSAFile()
     { }
 
-    /// Open an archive file.
+    /// Open an archive file. The archive is memory mapped if possible, and read through file streams otherwise.
     void open(const std::string &file);
 
+    /// Whether files are served straight out of the memory mapped archive
+    bool isMapped() const
+    { return mMappedFile != nullptr; }
+
     /* -----------------------------------
      * Archive file routines
      * -----------------------------------
@@ -132,6 +152,12 @@ public:
     */
     virtual Files::IStreamPtr getFile(const FileStruct* file);
 
+    /** Prepare a file for being opened soon. Does nothing for archives that store files as they are.
+     * @note Thread safe.
+    */
+    virtual void prefetch(const FileStruct* file)
+    { }
+
     /// Get a list of all files
     /// @note Thread safe.
     const FileList &getList() const
@@ -36,7 +36,30 @@
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/device/array.hpp>
-#include <components/bsa/memorystream.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <components/files/memorystream.hpp>
+
+namespace
+{
+    /// Stream over a decompressed file, keeping it alive while it's being read even if the cache drops it.
+    struct DecompressedFileStream : Files::IMemStream
+    {
+        DecompressedFileStream(std::shared_ptr<const std::vector<char> > data)
+            : Files::MemBuf(data->data(), data->size())
+            , Files::IMemStream(data->data(), data->size())
+            , mData(std::move(data))
+        {
+        }
+
+        std::shared_ptr<const std::vector<char> > mData;
+    };
+
+    // The default 4 KB buffers of boost's zlib filter make inflating about half as fast as zlib itself
+    const std::streamsize sInflateBufferSize = 64 * 1024;
+
+    // How many bytes of decompressed files are kept around for opening them again
+    const std::size_t sCacheBudget = 32 * 1024 * 1024;
+}
 
 namespace Bsa
 {
@@ -99,6 +122,7 @@ void CompressedBSAFile::getBZString(std::string& str, std::istream& filestream)
 
 CompressedBSAFile::CompressedBSAFile()
     : mCompressedByDefault(false), mEmbeddedFileNames(false)
+    , mCacheSize(0)
 { }
 
 CompressedBSAFile::~CompressedBSAFile()
@@ -327,32 +351,101 @@ Files::IStreamPtr CompressedBSAFile::getFile(const char* file)
 
 Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
 {
-    if (fileRecord.isCompressed(mCompressedByDefault)) {
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+    if (fileRecord.isCompressed(mCompressedByDefault))
+        return std::make_shared<DecompressedFileStream>(getDecompressed(fileRecord));
 
-        std::istream* fileStream = streamPtr.get();
+    return openStream(fileRecord.offset, fileRecord.size);
+}
 
-        if (mEmbeddedFileNames) {
-            std::string embeddedFileName;
-            getBZString(embeddedFileName, *fileStream);
+void CompressedBSAFile::prefetch(const FileStruct* file)
+{
+    FileRecord fileRec = getFileRecord(file->name);
+    if (fileRec.isValid() && fileRec.isCompressed(mCompressedByDefault))
+        getDecompressed(fileRec);
+}
+
+CompressedBSAFile::FileData CompressedBSAFile::getDecompressed(const FileRecord& fileRecord)
+{
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        auto found = mCache.find(fileRecord.offset);
+        if (found != mCache.end())
+        {
+            mCacheLru.splice(mCacheLru.begin(), mCacheLru, found->second.mLruPosition);
+            return found->second.mData;
         }
+    }
 
-        uint32_t uncompressedSize = 0u;
-        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uncompressedSize));
+    // Decompress without holding the lock, so that other files can be opened meanwhile
+    FileData data = decompress(fileRecord);
 
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-        inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-        inputStreamBuf.push(*fileStream);
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    auto found = mCache.find(fileRecord.offset);
+    if (found != mCache.end())
+        return found->second.mData; // another thread was faster
 
-        std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(uncompressedSize);
+    if (data->size() > sCacheBudget)
+        return data;
 
-        boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
-        boost::iostreams::copy(inputStreamBuf, sr);
+    while (mCacheSize + data->size() > sCacheBudget)
+    {
+        auto oldest = mCache.find(mCacheLru.back());
+        mCacheSize -= oldest->second.mData->size();
+        mCache.erase(oldest);
+        mCacheLru.pop_back();
+    }
+
+    mCacheLru.push_front(fileRecord.offset);
+    mCache.emplace(fileRecord.offset, CachedFile{data, mCacheLru.begin()});
+    mCacheSize += data->size();
+    return data;
+}
+
+CompressedBSAFile::FileData CompressedBSAFile::decompress(const FileRecord& fileRecord)
+{
+    const std::uint32_t recordSize = fileRecord.getSizeWithoutCompressionFlag();
+
+    // Skip the optional embedded name and the uncompressed size in front of the zlib stream
+    std::uint32_t uncompressedSize = 0u;
+    std::size_t headerSize = 0;
+    {
+        Files::IStreamPtr header = openStream(fileRecord.offset, recordSize);
+        if (mEmbeddedFileNames)
+        {
+            std::string embeddedFileName;
+            getBZString(embeddedFileName, *header);
+        }
+        header->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uncompressedSize));
+        if (!*header)
+            fail("Could not read the header of a compressed file");
+        headerSize = static_cast<std::size_t>(header->tellg());
+    }
 
-        return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+    // Inflate straight out of the mapped archive when possible
+    const char* compressed = nullptr;
+    std::vector<char> compressedCopy;
+    const std::size_t compressedSize = recordSize - headerSize;
+    if (mMappedFile)
+        compressed = mMappedFile->data() + fileRecord.offset + headerSize;
+    else
+    {
+        compressedCopy.resize(compressedSize);
+        Files::IStreamPtr stream = openStream(fileRecord.offset + headerSize, compressedSize);
+        stream->read(compressedCopy.data(), compressedSize);
+        compressed = compressedCopy.data();
     }
 
-    return Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.size);
+    std::shared_ptr<std::vector<char> > data = std::make_shared<std::vector<char> >(uncompressedSize);
+
+    boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
+    inputStreamBuf.push(boost::iostreams::zlib_decompressor(boost::iostreams::zlib_params(), sInflateBufferSize),
+                        sInflateBufferSize);
+    inputStreamBuf.push(boost::iostreams::array_source(compressed, compressedSize));
+
+    boost::iostreams::array_sink sink(data->data(), uncompressedSize);
+    boost::iostreams::copy(inputStreamBuf, sink, sInflateBufferSize);
+
+    return data;
 }
 
 BsaVersion CompressedBSAFile::detectVersion(std::string filePath)
@@ -407,7 +500,7 @@ void CompressedBSAFile::convertCompressedSizesToUncompressed()
             continue;
         }
 
-        Files::IStreamPtr dataBegin = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+        Files::IStreamPtr dataBegin = openStream(fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
 
         if (mEmbeddedFileNames)
         {
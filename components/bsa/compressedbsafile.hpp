@@ -26,6 +26,10 @@
 #ifndef BSA_COMPRESSED_BSA_FILE_H
 #define BSA_COMPRESSED_BSA_FILE_H
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include <components/bsa/bsa_file.hpp>
 
 namespace Bsa
@@ -80,6 +84,25 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         std::uint64_t generateHash(std::string stem, std::string extension) const;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+
+        typedef std::shared_ptr<const std::vector<char> > FileData;
+
+        /// Decompressed files, keyed by their offset in the archive
+        struct CachedFile
+        {
+            FileData mData;
+            std::list<std::uint32_t>::iterator mLruPosition;
+        };
+
+        std::mutex mCacheMutex;
+        std::unordered_map<std::uint32_t, CachedFile> mCache;
+        std::list<std::uint32_t> mCacheLru; // most recently used first
+        size_t mCacheSize;
+
+        /// Returns the decompressed file from the cache, or decompresses it and adds it to the cache.
+        /// @note Thread safe.
+        FileData getDecompressed(const FileRecord& fileRecord);
+        FileData decompress(const FileRecord& fileRecord);
     public:
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
@@ -92,6 +115,10 @@ namespace Bsa
        
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+
+        /// Decompress a file ahead of time, so that opening it later on is cheap.
+        /// @note Thread safe.
+        void prefetch(const FileStruct* fileStruct);
         
     };
 }
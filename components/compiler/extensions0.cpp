@@ -91,6 +91,7 @@ namespace Compiler
             extensions.registerFunction ("cellchanged", 'l', "", opcodeCellChanged);
             extensions.registerInstruction("testcells", "", opcodeTestCells);
             extensions.registerInstruction("testinteriorcells", "", opcodeTestInteriorCells);
+            extensions.registerInstruction("testterrainflight", "", opcodeTestTerrainFlight);
             extensions.registerInstruction ("coc", "S", opcodeCOC);
             extensions.registerInstruction ("centeroncell", "S", opcodeCOC);
             extensions.registerInstruction ("coe", "ll", opcodeCOE);
@@ -7,6 +7,9 @@
 
 #include <osg/Stats>
 
+#include <algorithm>
+#include <iomanip>
+
 namespace
 {
     using DetourNavigator::ChangeType;
@@ -46,19 +49,32 @@ namespace DetourNavigator
         , mRecastMeshManager(recastMeshManager)
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
+        , mQueuedJobs(0)
+        , mProcessingJobs(0)
+        , mQueueLatencySum(0)
+        , mQueueLatencyMax(0)
+        , mQueueLatencyCount(0)
+        , mChanges(0)
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
     {
-        for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
-            mThreads.emplace_back([&] { process(); });
+        if (settings.mEnableNavMeshDiskCache && !settings.mNavMeshDiskCachePath.empty())
+            mNavMeshDiskCache.reset(new NavMeshDiskCache(settings.mNavMeshDiskCachePath, settings));
+
+        const auto threadsCount = std::max<std::size_t>(1, mSettings.get().mAsyncNavMeshUpdaterThreads);
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mQueues.emplace_back(new Queue);
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([this, i] { process(i); });
     }
 
     AsyncNavMeshUpdater::~AsyncNavMeshUpdater()
     {
         mShouldStop = true;
-        std::unique_lock<std::mutex> lock(mMutex);
-        mJobs = decltype(mJobs)();
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            ++mChanges;
+        }
         mHasJob.notify_all();
-        lock.unlock();
         for (auto& thread : mThreads)
             thread.join();
     }
@@ -72,66 +88,98 @@ namespace DetourNavigator
         if (changedTiles.empty())
             return;
 
-        const std::lock_guard<std::mutex> lock(mMutex);
+        const auto now = std::chrono::steady_clock::now();
+        std::size_t pushed = 0;
 
         for (const auto& changedTile : changedTiles)
         {
-            if (mPushed[agentHalfExtents].insert(changedTile.first).second)
-            {
-                Job job;
-
-                job.mAgentHalfExtents = agentHalfExtents;
-                job.mNavMeshCacheItem = navMeshCacheItem;
-                job.mChangedTile = changedTile.first;
-                job.mTryNumber = 0;
-                job.mChangeType = changedTile.second;
-                job.mDistanceToPlayer = getManhattanDistance(changedTile.first, playerTile);
-                job.mDistanceToOrigin = getManhattanDistance(changedTile.first, TilePosition {0, 0});
-
-                mJobs.push(std::move(job));
-            }
+            Job job;
+
+            job.mAgentHalfExtents = agentHalfExtents;
+            job.mNavMeshCacheItem = navMeshCacheItem;
+            job.mChangedTile = changedTile.first;
+            job.mTryNumber = 0;
+            job.mChangeType = changedTile.second;
+            job.mDistanceToPlayer = getManhattanDistance(changedTile.first, playerTile);
+            job.mDistanceToOrigin = getManhattanDistance(changedTile.first, TilePosition {0, 0});
+            job.mPostTime = now;
+
+            if (push(std::move(job)))
+                ++pushed;
         }
 
-        Log(Debug::Debug) << "Posted " << mJobs.size() << " navigator jobs";
+        Log(Debug::Debug) << "Posted " << pushed << " navigator jobs";
 
-        if (!mJobs.empty())
-            mHasJob.notify_all();
+        if (pushed == 0)
+            return;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            ++mChanges;
+        }
+        mHasJob.notify_all();
     }
 
     void AsyncNavMeshUpdater::wait()
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        mDone.wait(lock, [&] { return mJobs.empty(); });
+        mDone.wait(lock, [&] { return mQueuedJobs == 0 && mProcessingJobs == 0; });
     }
 
     void AsyncNavMeshUpdater::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        std::size_t jobs = 0;
+        stats.setAttribute(frameNumber, "NavMesh UpdateJobs", mQueuedJobs.load());
 
+        // Latency of the jobs started since the last report
+        const std::size_t latencyCount = mQueueLatencyCount.exchange(0);
+        const std::uint64_t latencySum = mQueueLatencySum.exchange(0);
+        const std::uint64_t latencyMax = mQueueLatencyMax.exchange(0);
+        if (latencyCount > 0)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            jobs = mJobs.size();
+            stats.setAttribute(frameNumber, "NavMesh QueueLatency", latencySum / 1e6 / latencyCount);
+            stats.setAttribute(frameNumber, "NavMesh QueueLatencyMax", latencyMax / 1e6);
         }
 
-        stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
-
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDiskCache)
+            mNavMeshDiskCache->reportStats(frameNumber, stats);
     }
 
-    void AsyncNavMeshUpdater::process() throw()
+    void AsyncNavMeshUpdater::process(std::size_t threadNumber) throw()
     {
         Log(Debug::Debug) << "Start process navigator jobs";
         while (!mShouldStop)
         {
             try
             {
-                if (auto job = getNextJob())
+                std::size_t changes = 0;
+                {
+                    const std::lock_guard<std::mutex> lock(mMutex);
+                    changes = mChanges;
+                }
+
+                if (auto job = getNextJob(threadNumber))
                 {
-                    const auto processed = processJob(*job);
+                    bool processed = true;
+                    try
+                    {
+                        processed = processJob(*job);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        Log(Debug::Error) << "AsyncNavMeshUpdater::process exception: " << e.what();
+                    }
                     unlockTile(job->mAgentHalfExtents, job->mChangedTile);
                     if (!processed)
                         repost(std::move(*job));
+                    finishJob();
+                    continue;
                 }
+
+                // Nothing to do until more jobs are posted or a tile that has jobs waiting for it is unlocked
+                std::unique_lock<std::mutex> lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || mChanges != changes; });
             }
             catch (const std::exception& e)
             {
@@ -159,7 +207,7 @@ namespace DetourNavigator
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache, mNavMeshDiskCache.get());
 
         const auto finish = std::chrono::steady_clock::now();
 
@@ -179,51 +227,109 @@ namespace DetourNavigator
         return isSuccess(status);
     }
 
-    boost::optional<AsyncNavMeshUpdater::Job> AsyncNavMeshUpdater::getNextJob()
+    boost::optional<AsyncNavMeshUpdater::Job> AsyncNavMeshUpdater::getNextJob(std::size_t threadNumber)
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-
-        const auto threadId = std::this_thread::get_id();
-        auto& threadQueue = mThreadsQueues[threadId];
+        if (mQueuedJobs == 0)
+            return boost::none;
 
-        while (true)
+        // Own queue first, then steal from the others
+        for (std::size_t i = 0; i < mQueues.size(); ++i)
         {
-            const auto hasJob = [&] { return !mJobs.empty() || !threadQueue.mPushed.empty(); };
-
-            if (!mHasJob.wait_for(lock, std::chrono::milliseconds(10), hasJob))
+            if (auto job = takeJob(*mQueues[(threadNumber + i) % mQueues.size()]))
             {
-                mFirstStart.lock()->reset();
-                mDone.notify_all();
-                return boost::none;
+                if (i > 0)
+                    Log(Debug::Debug) << "Took navigator job from thread " << (threadNumber + i) % mQueues.size();
+                return job;
             }
+        }
 
-            Log(Debug::Debug) << "Got " << mJobs.size() << " navigator jobs and "
-                << threadQueue.mJobs.size() << " thread jobs";
+        return boost::none;
+    }
 
-            auto job = threadQueue.mJobs.empty()
-                ? getJob(mJobs, mPushed)
-                : getJob(threadQueue.mJobs, threadQueue.mPushed);
+    boost::optional<AsyncNavMeshUpdater::Job> AsyncNavMeshUpdater::takeJob(Queue& queue)
+    {
+        const std::lock_guard<std::mutex> lock(queue.mMutex);
 
-            const auto owner = lockTile(job.mAgentHalfExtents, job.mChangedTile);
+        for (auto& bucket : queue.mJobs)
+        {
+            for (auto it = bucket.begin(); it != bucket.end(); ++it)
+            {
+                // Jobs for a tile that is being generated by another thread wait until it's done
+                if (!lockTile(it->mAgentHalfExtents, it->mChangedTile))
+                    continue;
 
-            if (owner == threadId)
-                return job;
+                Job job = std::move(*it);
+                bucket.erase(it);
+
+                const auto pushed = queue.mPushed.find(job.mAgentHalfExtents);
+                pushed->second.erase(job.mChangedTile);
+                if (pushed->second.empty())
+                    queue.mPushed.erase(pushed);
+
+                // Counted as processing before it stops being counted as queued, so that wait doesn't return early
+                ++mProcessingJobs;
+                --mQueuedJobs;
 
-            postThreadJob(std::move(job), mThreadsQueues[owner]);
+                const auto latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - job.mPostTime).count());
+                mQueueLatencySum += latency;
+                ++mQueueLatencyCount;
+                auto max = mQueueLatencyMax.load();
+                while (max < latency && !mQueueLatencyMax.compare_exchange_weak(max, latency)) {}
+
+                return job;
+            }
         }
+
+        return boost::none;
     }
 
-    AsyncNavMeshUpdater::Job AsyncNavMeshUpdater::getJob(Jobs& jobs, Pushed& pushed)
+    bool AsyncNavMeshUpdater::push(Job&& job)
     {
-        auto job = jobs.top();
-        jobs.pop();
+        auto& queue = getQueue(job.mChangedTile);
 
-        const auto it = pushed.find(job.mAgentHalfExtents);
-        it->second.erase(job.mChangedTile);
-        if (it->second.empty())
-            pushed.erase(it);
+        const std::lock_guard<std::mutex> lock(queue.mMutex);
 
-        return job;
+        if (!queue.mPushed[job.mAgentHalfExtents].insert(job.mChangedTile).second)
+            return false;
+
+        auto& bucket = queue.mJobs[static_cast<std::size_t>(std::min<int>(job.mDistanceToPlayer, sBucketsCount - 1))];
+        const auto priority = job.getPriority();
+        const auto position = std::find_if(bucket.begin(), bucket.end(),
+            [&] (const Job& v) { return priority < v.getPriority(); });
+        bucket.insert(position, std::move(job));
+
+        ++mQueuedJobs;
+
+        return true;
+    }
+
+    void AsyncNavMeshUpdater::finishJob()
+    {
+        bool done = false;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            --mProcessingJobs;
+            ++mChanges;
+            done = mQueuedJobs == 0 && mProcessingJobs == 0;
+        }
+
+        mHasJob.notify_all();
+
+        if (done)
+        {
+            mFirstStart.lock()->reset();
+            mDone.notify_all();
+        }
+    }
+
+    AsyncNavMeshUpdater::Queue& AsyncNavMeshUpdater::getQueue(const TilePosition& changedTile)
+    {
+        // The jobs for the same tile go to the same queue, so that they are not posted twice
+        const auto hash = static_cast<std::size_t>(static_cast<unsigned>(changedTile.x()) * 73856093u
+                                                   ^ static_cast<unsigned>(changedTile.y()) * 19349663u);
+        return *mQueues[hash % mQueues.size()];
     }
 
     void AsyncNavMeshUpdater::writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const
@@ -262,54 +368,24 @@ namespace DetourNavigator
         if (mShouldStop || job.mTryNumber > 2)
             return;
 
-        const std::lock_guard<std::mutex> lock(mMutex);
-
-        if (mPushed[job.mAgentHalfExtents].insert(job.mChangedTile).second)
-        {
-            ++job.mTryNumber;
-            mJobs.push(std::move(job));
-            mHasJob.notify_all();
-        }
-    }
+        ++job.mTryNumber;
+        job.mPostTime = std::chrono::steady_clock::now();
 
-    void AsyncNavMeshUpdater::postThreadJob(Job&& job, Queue& queue)
-    {
-        if (queue.mPushed[job.mAgentHalfExtents].insert(job.mChangedTile).second)
-        {
-            queue.mJobs.push(std::move(job));
-            mHasJob.notify_all();
-        }
+        // The thread that reposts is still counted as processing, so it is woken up by finishJob
+        push(std::move(job));
     }
 
-    std::thread::id AsyncNavMeshUpdater::lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
+    bool AsyncNavMeshUpdater::lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
     {
-        if (mSettings.get().mAsyncNavMeshUpdaterThreads <= 1)
-            return std::this_thread::get_id();
-
-        auto locked = mProcessingTiles.lock();
-
-        auto agent = locked->find(agentHalfExtents);
-        if (agent == locked->end())
-        {
-            const auto threadId = std::this_thread::get_id();
-            locked->emplace(agentHalfExtents, std::map<TilePosition, std::thread::id>({{changedTile, threadId}}));
-            return threadId;
-        }
-
-        auto tile = agent->second.find(changedTile);
-        if (tile == agent->second.end())
-        {
-            const auto threadId = std::this_thread::get_id();
-            agent->second.emplace(changedTile, threadId);
-            return threadId;
-        }
+        if (mQueues.size() <= 1)
+            return true;
 
-        return tile->second;
+        return mProcessingTiles.lock()->operator[](agentHalfExtents).insert(changedTile).second;
     }
 
     void AsyncNavMeshUpdater::unlockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile)
     {
-        if (mSettings.get().mAsyncNavMeshUpdaterThreads <= 1)
+        if (mQueues.size() <= 1)
             return;
 
         auto locked = mProcessingTiles.lock();
@@ -318,11 +394,7 @@ namespace DetourNavigator
         if (agent == locked->end())
             return;
 
-        auto tile = agent->second.find(changedTile);
-        if (tile == agent->second.end())
-            return;
-
-        agent->second.erase(tile);
+        agent->second.erase(changedTile);
 
         if (agent->second.empty())
             locked->erase(agent);
@@ -6,19 +6,25 @@
 #include "tilecachedrecastmeshmanager.hpp"
 #include "tileposition.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdiskcache.hpp"
 
 #include <osg/Vec3f>
 
 #include <boost/optional.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <set>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -32,6 +38,10 @@ namespace DetourNavigator
         update = 3,
     };
 
+    /// @brief Generates the navmesh tiles of changed tiles on background threads.
+    /// @par Every thread has its own queue with the jobs posted for a part of the tiles. Jobs are bucketed by the
+    /// distance to the player, so the closest tiles are generated first. A thread that runs out of jobs takes them
+    /// from the queues of the other threads. The same tile is never generated by two threads at once.
     class AsyncNavMeshUpdater
     {
     public:
@@ -42,6 +52,7 @@ namespace DetourNavigator
         void post(const osg::Vec3f& agentHalfExtents, const SharedNavMeshCacheItem& mNavMeshCacheItem,
             const TilePosition& playerTile, const std::map<TilePosition, ChangeType>& changedTiles);
 
+        /// Wait until all posted jobs are processed.
         void wait();
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
@@ -56,54 +67,61 @@ namespace DetourNavigator
             ChangeType mChangeType;
             int mDistanceToPlayer;
             int mDistanceToOrigin;
+            std::chrono::steady_clock::time_point mPostTime;
 
             std::tuple<unsigned, ChangeType, int, int> getPriority() const
             {
                 return std::make_tuple(mTryNumber, mChangeType, mDistanceToPlayer, mDistanceToOrigin);
             }
-
-            friend inline bool operator <(const Job& lhs, const Job& rhs)
-            {
-                return lhs.getPriority() > rhs.getPriority();
-            }
         };
 
-        using Jobs = std::priority_queue<Job, std::deque<Job>>;
+        // Distances to the player in tiles, the last bucket takes all the farther ones
+        static const std::size_t sBucketsCount = 32;
+
+        using Jobs = std::array<std::deque<Job>, sBucketsCount>;
         using Pushed = std::map<osg::Vec3f, std::set<TilePosition>>;
 
         struct Queue
         {
+            std::mutex mMutex;
             Jobs mJobs;
             Pushed mPushed;
-
-            Queue() = default;
         };
 
         std::reference_wrapper<const Settings> mSettings;
         std::reference_wrapper<TileCachedRecastMeshManager> mRecastMeshManager;
         std::reference_wrapper<OffMeshConnectionsManager> mOffMeshConnectionsManager;
         std::atomic_bool mShouldStop;
-        mutable std::mutex mMutex;
+        std::atomic<std::size_t> mQueuedJobs;
+        std::atomic<std::size_t> mProcessingJobs;
+        mutable std::atomic<std::uint64_t> mQueueLatencySum;
+        mutable std::atomic<std::uint64_t> mQueueLatencyMax;
+        mutable std::atomic<std::size_t> mQueueLatencyCount;
+        std::mutex mMutex;
         std::condition_variable mHasJob;
         std::condition_variable mDone;
-        Jobs mJobs;
-        std::map<osg::Vec3f, std::set<TilePosition>> mPushed;
+        std::size_t mChanges;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         Misc::ScopeGuarded<boost::optional<std::chrono::steady_clock::time_point>> mFirstStart;
         NavMeshTilesCache mNavMeshTilesCache;
-        Misc::ScopeGuarded<std::map<osg::Vec3f, std::map<TilePosition, std::thread::id>>> mProcessingTiles;
-        std::map<std::thread::id, Queue> mThreadsQueues;
+        std::unique_ptr<NavMeshDiskCache> mNavMeshDiskCache;
+        Misc::ScopeGuarded<std::map<osg::Vec3f, std::set<TilePosition>>> mProcessingTiles;
+        std::vector<std::unique_ptr<Queue>> mQueues;
         std::vector<std::thread> mThreads;
 
-        void process() throw();
+        void process(std::size_t threadNumber) throw();
 
         bool processJob(const Job& job);
 
-        boost::optional<Job> getNextJob();
+        boost::optional<Job> getNextJob(std::size_t threadNumber);
+
+        boost::optional<Job> takeJob(Queue& queue);
+
+        bool push(Job&& job);
 
-        static Job getJob(Jobs& jobs, Pushed& pushed);
+        void finishJob();
 
-        void postThreadJob(Job&& job, Queue& queue);
+        Queue& getQueue(const TilePosition& changedTile);
 
         void writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const;
 
@@ -111,7 +129,7 @@ namespace DetourNavigator
 
         void repost(Job&& job);
 
-        std::thread::id lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
+        bool lockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
 
         void unlockTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile);
     };
@@ -9,6 +9,7 @@
 #include "sharednavmesh.hpp"
 #include "flags.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdiskcache.hpp"
 
 #include <components/misc/convert.hpp>
 
@@ -443,6 +444,32 @@ namespace
 
 
 
+    Bounds getRecastMeshBounds(const RecastMesh& recastMesh, const Settings& settings,
+        const osg::Vec3f& agentHalfExtents)
+    {
+        auto result = recastMesh.getBounds();
+
+        for (const auto& water : recastMesh.getWater())
+        {
+            const auto waterBounds = getWaterBounds(water, settings, agentHalfExtents);
+            result.mMin.y() = std::min(result.mMin.y(), waterBounds.mMin.y());
+            result.mMax.y() = std::max(result.mMax.y(), waterBounds.mMax.y());
+        }
+
+        return result;
+    }
+
+    NavMeshData makeNavMeshTileData(const osg::Vec3f& agentHalfExtents, const RecastMesh& recastMesh,
+        const std::vector<OffMeshConnection>& offMeshConnections, const TilePosition& tile,
+        const Bounds& recastMeshBounds, const Settings& settings)
+    {
+        const auto tileBounds = makeTileBounds(settings, tile);
+        const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
+        const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
+        return makeNavMeshTileData(agentHalfExtents, recastMesh, offMeshConnections, tile,
+            tileBorderMin, tileBorderMax, settings);
+    }
+
     template <class T>
     unsigned long getMinValuableBitsNumber(const T value)
     {
@@ -483,10 +510,23 @@ namespace DetourNavigator
         return navMesh;
     }
 
+    boost::optional<NavMeshData> makeNavMeshTile(const osg::Vec3f& agentHalfExtents, const RecastMesh& recastMesh,
+        const TilePosition& tile, const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings)
+    {
+        const auto recastMeshBounds = getRecastMeshBounds(recastMesh, settings, agentHalfExtents);
+
+        if (isEmpty(recastMeshBounds))
+            return boost::none;
+
+        return makeNavMeshTileData(agentHalfExtents, recastMesh, offMeshConnections, tile, recastMeshBounds,
+            settings);
+    }
+
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache)
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache,
+        NavMeshDiskCache* navMeshDiskCache)
     {
         Log(Debug::Debug) << std::fixed << std::setprecision(2) <<
             "Update NavMesh with multiple tiles:" <<
@@ -506,14 +546,7 @@ namespace DetourNavigator
             return navMeshCacheItem->lock()->removeTile(changedTile);
         }
 
-        auto recastMeshBounds = recastMesh->getBounds();
-
-        for (const auto& water : recastMesh->getWater())
-        {
-            const auto waterBounds = getWaterBounds(water, settings, agentHalfExtents);
-            recastMeshBounds.mMin.y() = std::min(recastMeshBounds.mMin.y(), waterBounds.mMin.y());
-            recastMeshBounds.mMax.y() = std::max(recastMeshBounds.mMax.y(), waterBounds.mMax.y());
-        }
+        const auto recastMeshBounds = getRecastMeshBounds(*recastMesh, settings, agentHalfExtents);
 
         if (isEmpty(recastMeshBounds))
         {
@@ -531,12 +564,24 @@ namespace DetourNavigator
 
         if (!cachedNavMeshData)
         {
-            const auto tileBounds = makeTileBounds(settings, changedTile);
-            const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
-            const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
+            boost::optional<NavMeshData> storedNavMeshData;
+            if (navMeshDiskCache)
+                storedNavMeshData = navMeshDiskCache->read(agentHalfExtents, changedTile, *recastMesh, offMeshConnections);
 
-            auto navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
-                tileBorderMin, tileBorderMax, settings);
+            NavMeshData navMeshData;
+            if (storedNavMeshData)
+            {
+                navMeshData = std::move(*storedNavMeshData);
+            }
+            else
+            {
+                navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
+                    recastMeshBounds, settings);
+
+                if (navMeshDiskCache)
+                    navMeshDiskCache->write(agentHalfExtents, changedTile, *recastMesh, offMeshConnections,
+                                            navMeshData.mValue.get(), navMeshData.mSize);
+            }
 
             if (!navMeshData.mValue)
             {
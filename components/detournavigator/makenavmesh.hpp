@@ -11,6 +11,8 @@
 
 #include <osg/Vec3f>
 
+#include <boost/optional.hpp>
+
 #include <memory>
 
 class dtNavMesh;
@@ -18,6 +20,7 @@ class dtNavMesh;
 namespace DetourNavigator
 {
     class RecastMesh;
+    class NavMeshDiskCache;
     struct Settings;
 
     inline float getLength(const osg::Vec2i& value)
@@ -38,10 +41,17 @@ namespace DetourNavigator
 
     NavMeshPtr makeEmptyNavMesh(const Settings& settings);
 
+    /// Generates a tile the same way updateNavMesh does, without a navmesh to add it to.
+    /// @return None if there is nothing to generate the tile from, otherwise the tile data,
+    /// which is null if the tile has no navigable area.
+    boost::optional<NavMeshData> makeNavMeshTile(const osg::Vec3f& agentHalfExtents, const RecastMesh& recastMesh,
+        const TilePosition& tile, const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings);
+
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache);
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache,
+        NavMeshDiskCache* navMeshDiskCache);
 }
 
 #endif
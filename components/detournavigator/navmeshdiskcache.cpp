@@ -0,0 +1,402 @@
+#include "navmeshdiskcache.hpp"
+#include "recastmesh.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <DetourAlloc.h>
+
+#include <osg/Stats>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    const char sMagic[8] = {'O', 'M', 'W', 'N', 'A', 'V', 'M', '\0'};
+
+    const char sExtension[] = ".navmesh";
+
+    // Increase when the way tiles are generated changes, to throw out old tiles
+    const std::uint32_t sFormatVersion = 1;
+
+    /// Two independent 64 bit hashes of the same bytes. One names the file, the other one is stored in it
+    /// to tell apart different input that happens to get the same file name.
+    struct Hash
+    {
+        // FNV-1a
+        std::uint64_t mFirst = 14695981039346656037ull;
+        std::uint64_t mSecond = 0;
+        std::uint64_t mSize = 0;
+
+        void add(const void* data, std::size_t size)
+        {
+            const auto bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                mFirst = (mFirst ^ bytes[i]) * 1099511628211ull;
+                mSecond = (((mSecond << 5) | (mSecond >> 59)) ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+            }
+            mSize += size;
+        }
+
+        template <class T>
+        void add(const T& value)
+        {
+            static_assert(std::is_arithmetic<T>::value, "Only values without padding can be hashed");
+            add(&value, sizeof(value));
+        }
+
+        template <class T>
+        void add(const std::vector<T>& values)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only values without padding can be hashed");
+            add(static_cast<std::uint64_t>(values.size()));
+            add(values.data(), values.size() * sizeof(T));
+        }
+
+        void add(const osg::Vec3f& value)
+        {
+            add(value.x());
+            add(value.y());
+            add(value.z());
+        }
+
+        void add(const btVector3& value)
+        {
+            add(static_cast<float>(value.x()));
+            add(static_cast<float>(value.y()));
+            add(static_cast<float>(value.z()));
+        }
+    };
+
+    std::uint64_t hashSettings(const Settings& settings)
+    {
+        Hash hash;
+        hash.add(settings.mCellHeight);
+        hash.add(settings.mCellSize);
+        hash.add(settings.mDetailSampleDist);
+        hash.add(settings.mDetailSampleMaxError);
+        hash.add(settings.mMaxClimb);
+        hash.add(settings.mMaxSimplificationError);
+        hash.add(settings.mMaxSlope);
+        hash.add(settings.mRecastScaleFactor);
+        hash.add(settings.mSwimHeightScale);
+        hash.add(settings.mBorderSize);
+        hash.add(settings.mMaxEdgeLen);
+        hash.add(settings.mMaxPolys);
+        hash.add(settings.mMaxVertsPerPoly);
+        hash.add(settings.mRegionMergeSize);
+        hash.add(settings.mRegionMinSize);
+        hash.add(settings.mTileSize);
+        return hash.mFirst;
+    }
+
+    template <class T>
+    bool readValue(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    template <class T>
+    void writeValue(std::ostream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+namespace DetourNavigator
+{
+    NavMeshDiskCache::NavMeshDiskCache(const std::string& path, const Settings& settings)
+        : mPath(path)
+        , mSettingsHash(hashSettings(settings))
+        , mTmpFileId((static_cast<std::uint64_t>(std::random_device()()) << 32) | std::random_device()())
+        , mMaxSize(settings.mMaxNavMeshDiskCacheSize)
+        , mSize(0)
+        , mHits(0)
+        , mMisses(0)
+        // The size of the cache is collected by the writer thread first, wait() waits for that as well
+        , mWriting(true)
+        , mShouldStop(false)
+    {
+        boost::system::error_code error;
+        boost::filesystem::create_directories(mPath, error);
+        if (error)
+            Log(Debug::Warning) << "Failed to create navmesh cache directory " << mPath << ": " << error.message();
+
+        mThread = std::thread([this] { process(); });
+    }
+
+    NavMeshDiskCache::~NavMeshDiskCache()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasItems.notify_all();
+        mThread.join();
+    }
+
+    boost::optional<NavMeshData> NavMeshDiskCache::read(const osg::Vec3f& agentHalfExtents,
+        const TilePosition& tilePosition, const RecastMesh& recastMesh,
+        const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        const Key key = makeKey(agentHalfExtents, tilePosition, recastMesh, offMeshConnections);
+        const boost::filesystem::path path = getFilePath(key);
+
+        boost::filesystem::ifstream stream(path, std::ios_base::binary);
+
+        char magic[sizeof(sMagic)];
+        std::uint32_t version = 0;
+        std::uint64_t settingsHash = 0;
+        std::uint64_t checkHash = 0;
+        std::uint64_t size = 0;
+        int dataSize = 0;
+        if (!stream.is_open() || !stream.read(magic, sizeof(magic))
+                || std::char_traits<char>::compare(magic, sMagic, sizeof(sMagic)) != 0
+                || !readValue(stream, version) || version != sFormatVersion
+                || !readValue(stream, settingsHash) || settingsHash != mSettingsHash
+                || !readValue(stream, checkHash) || checkHash != key.mCheckHash
+                || !readValue(stream, size) || size != key.mSize
+                || !readValue(stream, dataSize) || dataSize < 0)
+        {
+            ++mMisses;
+            return boost::none;
+        }
+
+        NavMeshData result(nullptr, 0);
+        if (dataSize > 0)
+        {
+            result = NavMeshData(static_cast<unsigned char*>(dtAlloc(dataSize, DT_ALLOC_PERM)), dataSize);
+            if (!result.mValue || !stream.read(reinterpret_cast<char*>(result.mValue.get()), dataSize))
+            {
+                ++mMisses;
+                return boost::none;
+            }
+        }
+
+        stream.close();
+
+        // The modification time tells prune() which tiles were used last
+        boost::system::error_code error;
+        boost::filesystem::last_write_time(path, std::time(nullptr), error);
+
+        ++mHits;
+        return boost::optional<NavMeshData>(std::move(result));
+    }
+
+    void NavMeshDiskCache::write(const osg::Vec3f& agentHalfExtents, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+        const unsigned char* data, int size)
+    {
+        Item item;
+        item.mKey = makeKey(agentHalfExtents, tilePosition, recastMesh, offMeshConnections);
+        if (data)
+            item.mData.assign(data, data + size);
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mItems.push_back(std::move(item));
+        }
+        mHasItems.notify_all();
+    }
+
+    void NavMeshDiskCache::wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [&] { return mItems.empty() && !mWriting; });
+    }
+
+    void NavMeshDiskCache::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        std::size_t queued = 0;
+
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            queued = mItems.size();
+        }
+
+        stats.setAttribute(frameNumber, "NavMesh DiskHits", mHits.load());
+        stats.setAttribute(frameNumber, "NavMesh DiskMisses", mMisses.load());
+        stats.setAttribute(frameNumber, "NavMesh DiskWrites", queued);
+        stats.setAttribute(frameNumber, "NavMesh DiskSize", mSize.load());
+    }
+
+    NavMeshDiskCache::Key NavMeshDiskCache::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& tilePosition,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections)
+    {
+        Hash hash;
+        hash.add(agentHalfExtents);
+        hash.add(tilePosition.x());
+        hash.add(tilePosition.y());
+        hash.add(recastMesh.getIndices());
+        hash.add(recastMesh.getVertices());
+        hash.add(recastMesh.getAreaTypes());
+        // Hashed field by field, because of the padding between them
+        hash.add(static_cast<std::uint64_t>(recastMesh.getWater().size()));
+        for (const auto& water : recastMesh.getWater())
+        {
+            hash.add(water.mCellSize);
+            hash.add(water.mTransform.getOrigin());
+            for (int i = 0; i < 3; ++i)
+                hash.add(water.mTransform.getBasis()[i]);
+        }
+        hash.add(static_cast<std::uint64_t>(offMeshConnections.size()));
+        for (const auto& connection : offMeshConnections)
+        {
+            hash.add(connection.mStart);
+            hash.add(connection.mEnd);
+        }
+        return Key {hash.mFirst, hash.mSecond, hash.mSize};
+    }
+
+    boost::filesystem::path NavMeshDiskCache::getFilePath(const Key& key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(key.mFileHash), sExtension);
+        return mPath / name;
+    }
+
+    void NavMeshDiskCache::process()
+    {
+        prune();
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWriting = false;
+        mDone.notify_all();
+
+        while (true)
+        {
+            mHasItems.wait(lock, [&] { return mShouldStop || !mItems.empty(); });
+            if (mItems.empty())
+                return;
+
+            const Item item = std::move(mItems.front());
+            mItems.pop_front();
+            mWriting = true;
+
+            lock.unlock();
+            writeItem(item);
+            lock.lock();
+
+            mWriting = false;
+            if (mItems.empty())
+                mDone.notify_all();
+        }
+    }
+
+    void NavMeshDiskCache::writeItem(const Item& item)
+    {
+        const boost::filesystem::path path = getFilePath(item.mKey);
+        try
+        {
+            // The game and the navmesh tool may write the same tile, so each one writes its own file
+            // and renames it into place
+            std::ostringstream tmpName;
+            tmpName << path.string() << '.' << std::hex << mTmpFileId << ".tmp";
+            const boost::filesystem::path tmpPath(tmpName.str());
+            {
+                boost::filesystem::ofstream file(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+                file.write(sMagic, sizeof(sMagic));
+                writeValue(file, sFormatVersion);
+                writeValue(file, mSettingsHash);
+                writeValue(file, item.mKey.mCheckHash);
+                writeValue(file, item.mKey.mSize);
+                writeValue(file, static_cast<int>(item.mData.size()));
+                file.write(reinterpret_cast<const char*>(item.mData.data()), item.mData.size());
+                if (!file)
+                    throw std::runtime_error("Failed to write " + tmpPath.string());
+            }
+
+            // The tile may replace an older one with the same file name
+            boost::system::error_code error;
+            const std::uint64_t replacedSize = boost::filesystem::file_size(path, error);
+            const std::uint64_t size = boost::filesystem::file_size(tmpPath);
+
+            boost::filesystem::rename(tmpPath, path);
+
+            mSize += size - (error ? 0 : replacedSize);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write navmesh tile " << path << ": " << e.what();
+        }
+
+        if (mMaxSize != 0 && mSize > mMaxSize)
+            prune();
+    }
+
+    void NavMeshDiskCache::prune()
+    {
+        struct File
+        {
+            std::time_t mModified;
+            std::uint64_t mSize;
+            boost::filesystem::path mPath;
+        };
+
+        std::vector<File> files;
+        std::uint64_t totalSize = 0;
+
+        try
+        {
+            for (boost::filesystem::directory_iterator it(mPath), end; it != end; ++it)
+            {
+                if (it->path().extension() != sExtension || !boost::filesystem::is_regular_file(it->status()))
+                    continue;
+
+                boost::system::error_code error;
+                const std::uint64_t size = boost::filesystem::file_size(it->path(), error);
+                if (error)
+                    continue;
+                const std::time_t modified = boost::filesystem::last_write_time(it->path(), error);
+                if (error)
+                    continue;
+
+                files.push_back(File {modified, size, it->path()});
+                totalSize += size;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to list navmesh cache directory " << mPath << ": " << e.what();
+        }
+
+        if (mMaxSize != 0 && totalSize > mMaxSize)
+        {
+            std::sort(files.begin(), files.end(),
+                [] (const File& lhs, const File& rhs) { return lhs.mModified < rhs.mModified; });
+
+            // Remove more than needed, so that the directory isn't listed again after every written tile
+            const std::uint64_t targetSize = mMaxSize / 4 * 3;
+            std::size_t removed = 0;
+
+            for (const File& file : files)
+            {
+                if (totalSize <= targetSize)
+                    break;
+
+                boost::system::error_code error;
+                boost::filesystem::remove(file.mPath, error);
+                if (error)
+                    continue;
+
+                totalSize -= file.mSize;
+                ++removed;
+            }
+
+            Log(Debug::Verbose) << "Removed " << removed << " least recently used navmesh tiles from " << mPath;
+        }
+
+        mSize = totalSize;
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDISKCACHE_H
+
+#include "navmeshdata.hpp"
+#include "offmeshconnection.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct Settings;
+
+    /// @brief Keeps generated navmesh tiles on disk, so that they don't have to be generated again
+    /// in the next session.
+    /// @par A tile is identified by the agent, its position and the recast mesh and off mesh connections
+    /// it was generated from. Each tile is stored in its own file, named after a hash of all of these,
+    /// and together with the settings it was generated with.
+    /// @par When the files take more than the maximum disk cache size, the least recently read or written
+    /// ones are removed, using their modification time.
+    /// @note Thread safe. Tiles are written by a background thread.
+    class NavMeshDiskCache
+    {
+    public:
+        /// @param path The directory to keep the tiles in. It is created if needed.
+        NavMeshDiskCache(const std::string& path, const Settings& settings);
+
+        /// Writes all tiles that are still queued.
+        ~NavMeshDiskCache();
+
+        /// @return The stored tile, whose data is null if the tile has no navigable area,
+        /// or none if the tile is not stored or was generated from other input or with other settings.
+        /// A stored tile is marked as used, so that it is removed last.
+        boost::optional<NavMeshData> read(const osg::Vec3f& agentHalfExtents, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+
+        /// Queue a tile to be written.
+        /// @param data The tile data, or nullptr if the tile has no navigable area.
+        void write(const osg::Vec3f& agentHalfExtents, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+            const unsigned char* data, int size);
+
+        /// Wait until all queued tiles have been written.
+        void wait();
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Key
+        {
+            std::uint64_t mFileHash;
+            std::uint64_t mCheckHash;
+            std::uint64_t mSize;
+        };
+
+        struct Item
+        {
+            Key mKey;
+            std::vector<unsigned char> mData;
+        };
+
+        static Key makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections);
+
+        boost::filesystem::path getFilePath(const Key& key) const;
+
+        void process();
+
+        void writeItem(const Item& item);
+
+        /// Sums up the size of the stored tiles and removes the least recently used ones if they take
+        /// more than the maximum size.
+        void prune();
+
+        boost::filesystem::path mPath;
+        std::uint64_t mSettingsHash;
+        std::uint64_t mTmpFileId;
+        std::uint64_t mMaxSize;
+        std::atomic<std::uint64_t> mSize;
+        mutable std::atomic<std::size_t> mHits;
+        mutable std::atomic<std::size_t> mMisses;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasItems;
+        std::condition_variable mDone;
+        std::deque<Item> mItems;
+        bool mWriting;
+        bool mShouldStop;
+        std::thread mThread;
+    };
+}
+
+#endif
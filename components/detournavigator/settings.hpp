@@ -3,6 +3,7 @@
 
 #include <boost/optional.hpp>
 
+#include <cstdint>
 #include <string>
 
 namespace DetourNavigator
@@ -13,6 +14,7 @@ namespace DetourNavigator
         bool mEnableWriteNavMeshToFile = false;
         bool mEnableRecastMeshFileNameRevision = false;
         bool mEnableNavMeshFileNameRevision = false;
+        bool mEnableNavMeshDiskCache = false;
         float mCellHeight = 0;
         float mCellSize = 0;
         float mDetailSampleDist = 0;
@@ -33,11 +35,13 @@ namespace DetourNavigator
         int mTileSize = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::uint64_t mMaxNavMeshDiskCacheSize = 0;
         std::size_t mMaxPolygonPathSize = 0;
         std::size_t mMaxSmoothPathSize = 0;
         std::size_t mTrianglesPerChunk = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
+        std::string mNavMeshDiskCachePath;
     };
 
     boost::optional<Settings> makeSettingsFromSettingsManager();
@@ -1,7 +1,10 @@
 #include "esmreader.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 namespace ESM
 {
 
@@ -15,7 +18,7 @@ using namespace Misc;
 ESM_Context ESMReader::getContext()
 {
     // Update the file position before returning
-    mCtx.filePos = mEsm->tellg();
+    mCtx.filePos = getFileOffset();
     return mCtx;
 }
 
@@ -25,6 +28,8 @@ ESMReader::ESMReader()
     , mBuffer(50*1024)
     , mGlobalReaderList(nullptr)
     , mEncoder(nullptr)
+    , mMappedData(nullptr)
+    , mMappedPos(0)
     , mFileSize(0)
 {
     clearCtx();
@@ -45,12 +50,18 @@ void ESMReader::restoreContext(const ESM_Context &rc)
     mCtx = rc;
 
     // Make sure we seek to the right place
-    mEsm->seekg(mCtx.filePos);
+    if (mMappedData)
+        mMappedPos = mCtx.filePos;
+    else
+        mEsm->seekg(mCtx.filePos);
 }
 
 void ESMReader::close()
 {
     mEsm.reset();
+    mMappedFile.reset();
+    mMappedData = nullptr;
+    mMappedPos = 0;
     clearCtx();
     mHeader.blank();
 }
@@ -76,15 +87,38 @@ void ESMReader::openRaw(Files::IStreamPtr _esm, const std::string& name)
     mEsm->seekg(0, mEsm->beg);
 }
 
-void ESMReader::openRaw(const std::string& filename)
+bool ESMReader::openMapped(const std::string& filename)
 {
-    openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
+    std::shared_ptr<boost::iostreams::mapped_file_source> file;
+    try
+    {
+        file = std::make_shared<boost::iostreams::mapped_file_source>(filename);
+    }
+    catch (std::exception&)
+    {
+        // Empty files can't be mapped, and neither can anything on some filesystems
+        return false;
+    }
+
+    if (!file->is_open())
+        return false;
+
+    close();
+    mMappedFile = file;
+    mMappedData = file->data();
+    mCtx.filename = filename;
+    mCtx.leftFile = mFileSize = file->size();
+    return true;
 }
 
-void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+void ESMReader::openRaw(const std::string& filename)
 {
-    openRaw(_esm, name);
+    if (!openMapped(filename))
+        openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
+}
 
+void ESMReader::readHeader()
+{
     if (getRecName() != "TES3")
         fail("Not a valid Morrowind file");
 
@@ -93,9 +127,16 @@ void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
     mHeader.load (*this);
 }
 
+void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+{
+    openRaw(_esm, name);
+    readHeader();
+}
+
 void ESMReader::open(const std::string &file)
 {
-    open (Files::openConstrainedFileStream (file.c_str ()), file);
+    openRaw(file);
+    readHeader();
 }
 
 int64_t ESMReader::getHNLong(const char *name)
@@ -127,7 +168,7 @@ std::string ESMReader::getHString()
     // them. For some reason, they break the rules, and contain a byte
     // (value 0) even if the header says there is no data. If
     // Morrowind accepts it, so should we.
-    if (mCtx.leftSub == 0 && !mEsm->peek())
+    if (mCtx.leftSub == 0 && !peekByte())
     {
         // Skip the following zero byte
         mCtx.leftRec--;
@@ -320,8 +361,32 @@ void ESMReader::getRecHeader(uint32_t &flags)
  *
  *************************************************************************/
 
+const char *ESMReader::getMapped(int size)
+{
+    if (size < 0 || mMappedPos + size > mFileSize)
+        fail("Read error: unexpected end of file");
+
+    const char *data = mMappedData + mMappedPos;
+    mMappedPos += size;
+    return data;
+}
+
+int ESMReader::peekByte()
+{
+    if (mMappedData)
+        return mMappedPos < mFileSize ? mMappedData[mMappedPos] : std::char_traits<char>::eof();
+
+    return mEsm->peek();
+}
+
 void ESMReader::getExact(void*x, int size)
 {
+    if (mMappedData)
+    {
+        std::memcpy(x, getMapped(size), size);
+        return;
+    }
+
     try
     {
         mEsm->read((char*)x, size);
@@ -334,6 +399,22 @@ void ESMReader::getExact(void*x, int size)
 
 std::string ESMReader::getString(int size)
 {
+    // Mapped strings can be converted in place, unless the encoder would need a terminator
+    // that isn't part of the subrecord
+    if (mMappedData)
+    {
+        const char *ptr = getMapped(size);
+        int length = strnlen(ptr, size);
+
+        if (!mEncoder)
+            return std::string (ptr, length);
+
+        if (length < size)
+            return mEncoder->getUtf8(ptr, length);
+
+        mMappedPos -= size;
+    }
+
     size_t s = size;
     if (mBuffer.size() <= s)
         // Add some extra padding to reduce the chance of having to resize
@@ -366,8 +447,8 @@ void ESMReader::fail(const std::string &msg)
     ss << "\n  File: " << mCtx.filename;
     ss << "\n  Record: " << mCtx.recName.toString();
     ss << "\n  Subrecord: " << mCtx.subName.toString();
-    if (mEsm.get())
-        ss << "\n  Offset: 0x" << hex << mEsm->tellg();
+    if (mEsm.get() || mMappedData)
+        ss << "\n  Offset: 0x" << hex << getFileOffset();
     throw std::runtime_error(ss.str());
 }
 
@@ -378,11 +459,20 @@ void ESMReader::setEncoder(ToUTF8::Utf8Encoder* encoder)
 
 size_t ESMReader::getFileOffset()
 {
+    if (mMappedData)
+        return mMappedPos;
+
     return mEsm->tellg();
 }
 
 void ESMReader::skip(int bytes)
 {
+    if (mMappedData)
+    {
+        getMapped(bytes);
+        return;
+    }
+
     mEsm->seekg(getFileOffset()+bytes);
 }
 
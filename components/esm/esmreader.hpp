@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cassert>
+#include <memory>
 #include <vector>
 #include <sstream>
 
@@ -15,6 +16,14 @@
 #include "esmcommon.hpp"
 #include "loadtes3.hpp"
 
+namespace boost
+{
+namespace iostreams
+{
+    class mapped_file_source;
+}
+}
+
 namespace ESM {
 
 class ESMReader
@@ -68,10 +77,15 @@ public:
   /// currently open file first, if any.
   void open(Files::IStreamPtr _esm, const std::string &name);
 
+  /// Load ES file by name, parses the header. The file is memory mapped when
+  /// possible and read as a stream otherwise.
   void open(const std::string &file);
 
   void openRaw(const std::string &filename);
 
+  /// Whether the open file is memory mapped rather than read as a stream
+  bool isMapped() const { return mMappedData != nullptr; }
+
   /// Get the current position in the file. Make sure that the file has been opened!
   size_t getFileOffset();
 
@@ -270,8 +284,22 @@ public:
 private:
   void clearCtx();
 
+  void readHeader();
+
+  bool openMapped(const std::string &filename);
+
+  // Returns the next 'size' bytes of the mapped file without copying them
+  const char *getMapped(int size);
+
+  int peekByte();
+
   Files::IStreamPtr mEsm;
 
+  // Set instead of mEsm when the file is memory mapped
+  std::shared_ptr<boost::iostreams::mapped_file_source> mMappedFile;
+  const char *mMappedData;
+  size_t mMappedPos;
+
   ESM_Context mCtx;
 
   unsigned int mRecordFlags;
@@ -0,0 +1,64 @@
+#include "normals.hpp"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ESMTERRAIN_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ESMTerrain
+{
+
+    // The components of land normals are small integers, so the squared length is exact and both
+    // paths give the same results.
+
+    void normalize(int count, float* x, float* y, float* z)
+    {
+        const int done = normalizeSse2(count, x, y, z);
+        normalizeScalar(count - done, x + done, y + done, z + done);
+    }
+
+    int normalizeSse2(int count, float* x, float* y, float* z)
+    {
+        int i = 0;
+#ifdef ESMTERRAIN_USE_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 vx = _mm_loadu_ps(x + i);
+            const __m128 vy = _mm_loadu_ps(y + i);
+            const __m128 vz = _mm_loadu_ps(z + i);
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+            const __m128 positive = _mm_cmpgt_ps(length, zero);
+            const __m128 inverse = _mm_or_ps(_mm_and_ps(positive, _mm_div_ps(one, length)), _mm_andnot_ps(positive, one));
+            _mm_storeu_ps(x + i, _mm_mul_ps(vx, inverse));
+            _mm_storeu_ps(y + i, _mm_mul_ps(vy, inverse));
+            _mm_storeu_ps(z + i, _mm_mul_ps(vz, inverse));
+        }
+#else
+        (void)count;
+        (void)x;
+        (void)y;
+        (void)z;
+#endif
+        return i;
+    }
+
+    void normalizeScalar(int count, float* x, float* y, float* z)
+    {
+        for (int i=0; i<count; ++i)
+        {
+            const float length = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+            if (length > 0.f)
+            {
+                const float inverse = 1.f / length;
+                x[i] *= inverse;
+                y[i] *= inverse;
+                z[i] *= inverse;
+            }
+        }
+    }
+
+}
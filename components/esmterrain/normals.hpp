@@ -0,0 +1,20 @@
+#ifndef COMPONENTS_ESM_TERRAIN_NORMALS_H
+#define COMPONENTS_ESM_TERRAIN_NORMALS_H
+
+namespace ESMTerrain
+{
+
+    /// Normalize \a count vectors, given as separate arrays of their components, in place. Same as
+    /// osg::Vec3f::normalize, which leaves zero length vectors alone. Uses SSE2 where it is available.
+    void normalize(int count, float* x, float* y, float* z);
+
+    /// The SSE2 part of normalize(), which handles whole groups of 4 vectors.
+    /// @return The number of vectors normalized, which is 0 where SSE2 is not available.
+    int normalizeSse2(int count, float* x, float* y, float* z);
+
+    /// The scalar part of normalize(), which handles the vectors normalizeSse2() leaves over.
+    void normalizeScalar(int count, float* x, float* y, float* z);
+
+}
+
+#endif
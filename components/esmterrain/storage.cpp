@@ -1,5 +1,7 @@
 #include "storage.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
 
 #include <OpenThreads/ScopedLock>
@@ -12,6 +14,8 @@
 #include <components/misc/stringops.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "normals.hpp"
+
 namespace ESMTerrain
 {
 
@@ -97,31 +101,96 @@ namespace ESMTerrain
         return false;
     }
 
-    void Storage::fixNormal (osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache)
+    /// The land of a cell and its eight neighbours, for the vertices on the cell borders. Neighbours are only
+    /// looked up when a border vertex needs them, since that may mean loading them.
+    class LandNeighbours
     {
+    public:
+        LandNeighbours(int cellX, int cellY, const LandObject* land)
+            : mCellX(cellX)
+            , mCellY(cellY)
+        {
+            for (int y=0; y<3; ++y)
+            {
+                for (int x=0; x<3; ++x)
+                {
+                    mLand[y][x] = nullptr;
+                    mResolved[y][x] = false;
+                }
+            }
+            mLand[1][1] = land;
+            mResolved[1][1] = true;
+        }
+
+        int mCellX;
+        int mCellY;
+        const LandObject* mLand[3][3];
+        bool mResolved[3][3];
+    };
+
+    namespace
+    {
+        // The row kernels below convert a whole row of a cell at once, rather than one vertex at a time.
+
+        void copyHeights(const float* heights, int increment, int count, float* out)
+        {
+            for (int i=0; i<count; ++i)
+                out[i] = heights[i * increment];
+        }
+
+        void normalizeNormals(const ESM::Land::VNML* normals, int increment, int count, float* outX, float* outY, float* outZ)
+        {
+            const int stride = 3 * increment;
+            for (int i=0; i<count; ++i)
+            {
+                outX[i] = normals[i * stride];
+                outY[i] = normals[i * stride + 1];
+                outZ[i] = normals[i * stride + 2];
+            }
+
+            normalize(count, outX, outY, outZ);
+        }
+    }
+
+    const ESM::Land::LandData* Storage::getNeighbourData(LandNeighbours& neighbours, int& col, int& row, int flags, LandCache& cache)
+    {
+        int x = 1;
+        int y = 1;
         while (col >= ESM::Land::LAND_SIZE-1)
         {
-            ++cellY;
+            ++y;
             col -= ESM::Land::LAND_SIZE-1;
         }
         while (row >= ESM::Land::LAND_SIZE-1)
         {
-            ++cellX;
+            ++x;
             row -= ESM::Land::LAND_SIZE-1;
         }
         while (col < 0)
         {
-            --cellY;
+            --y;
             col += ESM::Land::LAND_SIZE-1;
         }
         while (row < 0)
         {
-            --cellX;
+            --x;
             row += ESM::Land::LAND_SIZE-1;
         }
+        assert(x >= 0 && x < 3 && y >= 0 && y < 3);
 
-        const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : 0;
+        if (!neighbours.mResolved[y][x])
+        {
+            neighbours.mLand[y][x] = getLand(neighbours.mCellX + x - 1, neighbours.mCellY + y - 1, cache);
+            neighbours.mResolved[y][x] = true;
+        }
+
+        const LandObject* land = neighbours.mLand[y][x];
+        return land ? land->getData(flags) : nullptr;
+    }
+
+    void Storage::fixNormal (osg::Vec3f& normal, LandNeighbours& neighbours, int col, int row, LandCache& cache)
+    {
+        const ESM::Land::LandData* data = getNeighbourData(neighbours, col, row, ESM::Land::DATA_VNML, cache);
         if (data)
         {
             normal.x() = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3];
@@ -133,32 +202,20 @@ namespace ESMTerrain
             normal = osg::Vec3f(0,0,1);
     }
 
-    void Storage::averageNormal(osg::Vec3f &normal, int cellX, int cellY, int col, int row, LandCache& cache)
+    void Storage::averageNormal(osg::Vec3f &normal, LandNeighbours& neighbours, int col, int row, LandCache& cache)
     {
         osg::Vec3f n1,n2,n3,n4;
-        fixNormal(n1, cellX, cellY, col+1, row, cache);
-        fixNormal(n2, cellX, cellY, col-1, row, cache);
-        fixNormal(n3, cellX, cellY, col, row+1, cache);
-        fixNormal(n4, cellX, cellY, col, row-1, cache);
+        fixNormal(n1, neighbours, col+1, row, cache);
+        fixNormal(n2, neighbours, col-1, row, cache);
+        fixNormal(n3, neighbours, col, row+1, cache);
+        fixNormal(n4, neighbours, col, row-1, cache);
         normal = (n1+n2+n3+n4);
         normal.normalize();
     }
 
-    void Storage::fixColour (osg::Vec4ub& color, int cellX, int cellY, int col, int row, LandCache& cache)
+    void Storage::fixColour (osg::Vec4ub& color, LandNeighbours& neighbours, int col, int row, LandCache& cache)
     {
-        if (col == ESM::Land::LAND_SIZE-1)
-        {
-            ++cellY;
-            col = 0;
-        }
-        if (row == ESM::Land::LAND_SIZE-1)
-        {
-            ++cellX;
-            row = 0;
-        }
-
-        const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : 0;
+        const ESM::Land::LandData* data = getNeighbourData(neighbours, col, row, ESM::Land::DATA_VCLR, cache);
         if (data)
         {
             color.r() = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3];
@@ -192,20 +249,28 @@ namespace ESMTerrain
         normals->resize(numVerts*numVerts);
         colours->resize(numVerts*numVerts);
 
-        osg::Vec3f normal;
-        osg::Vec4ub color;
+        // The position of a vertex in the chunk only depends on its index along each axis
+        std::vector<float> vertexOffsets(numVerts);
+        for (size_t i=0; i<numVerts; ++i)
+            vertexOffsets[i] = (i / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits;
 
-        float vertY = 0;
-        float vertX = 0;
+        // One row of a cell at a time
+        float heights[ESM::Land::LAND_SIZE];
+        float normalX[ESM::Land::LAND_SIZE];
+        float normalY[ESM::Land::LAND_SIZE];
+        float normalZ[ESM::Land::LAND_SIZE];
+
+        size_t vertY = 0;
+        size_t vertX = 0;
 
         LandCache cache;
 
         bool alteration = useAlteration();
 
-        float vertY_ = 0; // of current cell corner
+        size_t vertY_ = 0; // of current cell corner
         for (int cellY = startCellY; cellY < startCellY + std::ceil(size); ++cellY)
         {
-            float vertX_ = 0; // of current cell corner
+            size_t vertX_ = 0; // of current cell corner
             for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
             {
                 const LandObject* land = getLand(cellX, cellY, cache);
@@ -219,6 +284,8 @@ namespace ESMTerrain
                     colourData = land->getData(ESM::Land::DATA_VCLR);
                 }
 
+                LandNeighbours neighbours(cellX, cellY, land);
+
                 int rowStart = 0;
                 int colStart = 0;
                 // Skip the first row / column unless we're at a chunk edge,
@@ -235,76 +302,94 @@ namespace ESMTerrain
                 int rowEnd = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1), static_cast<int>(ESM::Land::LAND_SIZE));
                 int colEnd = std::min(static_cast<int>(colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1), static_cast<int>(ESM::Land::LAND_SIZE));
 
+                const int step = static_cast<int>(increment);
+                const int count = rowEnd > rowStart ? (rowEnd - rowStart + step - 1) / step : 0;
+                const int lastRow = rowStart + (count - 1) * step;
+
+                // Normals apparently don't connect seamlessly between cells, and some corner normals appear to
+                // be complete garbage (z < 0). Unlike normals, colors mostly connect seamlessly between cells,
+                // but not always...
+                auto fixBorderVertex = [&] (int col, int row, size_t index)
+                {
+                    const bool border = col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1;
+                    osg::Vec3f& normal = (*normals)[index];
+                    if (border)
+                        fixNormal(normal, neighbours, col, row, cache);
+                    if ((row == 0 || row == ESM::Land::LAND_SIZE-1) && (col == 0 || col == ESM::Land::LAND_SIZE-1))
+                        averageNormal(normal, neighbours, col, row, cache);
+                    assert(normal.z() > 0);
+
+                    if (border)
+                        fixColour((*colours)[index], neighbours, col, row, cache);
+                };
+
                 vertY = vertY_;
                 for (int col=colStart; col<colEnd; col += increment)
                 {
-                    vertX = vertX_;
-                    for (int row=rowStart; row<rowEnd; row += increment)
-                    {
-                        int srcArrayIndex = col*ESM::Land::LAND_SIZE*3+row*3;
-
-                        assert(row >= 0 && row < ESM::Land::LAND_SIZE);
-                        assert(col >= 0 && col < ESM::Land::LAND_SIZE);
-
-                        assert (vertX < numVerts);
-                        assert (vertY < numVerts);
-
-                        float height = defaultHeight;
-                        if (heightData)
-                            height = heightData->mHeights[col*ESM::Land::LAND_SIZE + row];
-                        if (alteration)
-                            height += getAlteredHeight(col, row);
-                        (*positions)[static_cast<unsigned int>(vertX*numVerts + vertY)]
-                            = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
-                                         (vertY / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
-                                         height);
+                    assert(col >= 0 && col < ESM::Land::LAND_SIZE);
+                    assert(vertY < numVerts);
 
-                        if (normalData)
-                        {
-                            for (int i=0; i<3; ++i)
-                                normal[i] = normalData->mNormals[srcArrayIndex+i];
-
-                            normal.normalize();
-                        }
-                        else
-                            normal = osg::Vec3f(0,0,1);
+                    const int srcIndex = col*ESM::Land::LAND_SIZE + rowStart;
 
-                        // Normals apparently don't connect seamlessly between cells
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixNormal(normal, cellX, cellY, col, row, cache);
+                    if (heightData)
+                        copyHeights(&heightData->mHeights[srcIndex], step, count, heights);
+                    else
+                        std::fill(heights, heights + count, defaultHeight);
 
-                        // some corner normals appear to be complete garbage (z < 0)
-                        if ((row == 0 || row == ESM::Land::LAND_SIZE-1) && (col == 0 || col == ESM::Land::LAND_SIZE-1))
-                            averageNormal(normal, cellX, cellY, col, row, cache);
-
-                        assert(normal.z() > 0);
+                    if (normalData)
+                        normalizeNormals(&normalData->mNormals[srcIndex*3], step, count, normalX, normalY, normalZ);
+                    else
+                    {
+                        std::fill(normalX, normalX + count, 0.f);
+                        std::fill(normalY, normalY + count, 0.f);
+                        std::fill(normalZ, normalZ + count, 1.f);
+                    }
 
-                        (*normals)[static_cast<unsigned int>(vertX*numVerts + vertY)] = normal;
+                    const unsigned char* colourRow = colourData ? &colourData->mColours[srcIndex*3] : nullptr;
 
-                        if (colourData)
+                    vertX = vertX_;
+                    assert(vertX + count <= numVerts);
+                    for (int i=0; i<count; ++i)
+                    {
+                        const size_t index = (vertX + i) * numVerts + vertY;
+                        (*positions)[index] = osg::Vec3f(vertexOffsets[vertX + i], vertexOffsets[vertY], heights[i]);
+                        (*normals)[index] = osg::Vec3f(normalX[i], normalY[i], normalZ[i]);
+                        if (colourRow)
                         {
-                            for (int i=0; i<3; ++i)
-                                color[i] = colourData->mColours[srcArrayIndex+i];
+                            const unsigned char* colour = &colourRow[i * 3 * step];
+                            (*colours)[index] = osg::Vec4ub(colour[0], colour[1], colour[2], 255);
                         }
                         else
+                            (*colours)[index] = osg::Vec4ub(255, 255, 255, 255);
+                    }
+
+                    if (alteration)
+                    {
+                        for (int i=0; i<count; ++i)
                         {
-                            color.r() = 255;
-                            color.g() = 255;
-                            color.b() = 255;
-                        }
-                        if (alteration)
+                            const int row = rowStart + i * step;
+                            const size_t index = (vertX + i) * numVerts + vertY;
+                            (*positions)[index].z() += getAlteredHeight(col, row);
+                            osg::Vec4ub& color = (*colours)[index];
                             adjustColor(col, row, heightData, color); //Does nothing by default, override in OpenMW-CS
+                            color.a() = 255;
+                        }
+                    }
 
-                        // Unlike normals, colors mostly connect seamlessly between cells, but not always...
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixColour(color, cellX, cellY, col, row, cache);
-
-                        color.a() = 255;
-
-                        (*colours)[static_cast<unsigned int>(vertX*numVerts + vertY)] = color;
-
-                        ++vertX;
+                    if (col == ESM::Land::LAND_SIZE-1)
+                    {
+                        for (int i=0; i<count; ++i)
+                            fixBorderVertex(col, rowStart + i * step, (vertX + i) * numVerts + vertY);
+                    }
+                    else if (count > 0)
+                    {
+                        if (col == 0 && rowStart == 0)
+                            fixBorderVertex(col, rowStart, vertX * numVerts + vertY);
+                        if (lastRow == ESM::Land::LAND_SIZE-1)
+                            fixBorderVertex(col, lastRow, (vertX + count - 1) * numVerts + vertY);
                     }
+
+                    vertX += count;
                     ++vertY;
                 }
                 vertX_ = vertX;
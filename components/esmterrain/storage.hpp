@@ -19,6 +19,7 @@ namespace ESMTerrain
 {
 
     class LandCache;
+    class LandNeighbours;
 
     /// @brief Wrapper around Land Data with reference counting. The wrapper needs to be held as long as the data is still in use
     class LandObject : public osg::Object
@@ -119,9 +120,13 @@ namespace ESMTerrain
     private:
         const VFS::Manager* mVFS;
 
-        inline void fixNormal (osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache);
-        inline void fixColour (osg::Vec4ub& colour, int cellX, int cellY, int col, int row, LandCache& cache);
-        inline void averageNormal (osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache);
+        /// Get the data of the cell containing the given vertex, which may be a neighbour of the cell in @a neighbours.
+        /// @a col and @a row are changed to the vertex position in that cell.
+        inline const ESM::Land::LandData* getNeighbourData (LandNeighbours& neighbours, int& col, int& row, int flags, LandCache& cache);
+
+        inline void fixNormal (osg::Vec3f& normal, LandNeighbours& neighbours, int col, int row, LandCache& cache);
+        inline void fixColour (osg::Vec4ub& colour, LandNeighbours& neighbours, int col, int row, LandCache& cache);
+        inline void averageNormal (osg::Vec3f& normal, LandNeighbours& neighbours, int col, int row, LandCache& cache);
 
         inline const LandObject* getLand(int cellX, int cellY, LandCache& cache);
 
@@ -31,6 +31,10 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /// The part of the buffer that has not been read yet, for parsing it in place
+        const char* getCurrent() const { return gptr(); }
+        const char* getEnd() const { return egptr(); }
+
     protected:
         char* bufferStart;
         char* bufferEnd;
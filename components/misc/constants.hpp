@@ -30,6 +30,13 @@ const std::string NightDayLabel = "NightDaySwitch";
 // A label to mark visual switches for herbalism feature
 const std::string HerbalismLabel = "HerbalismSwitch";
 
+// Skeleton and animations of NPCs and the player. Actors in exterior cells use the half extents
+// of its collision box for pathfinding, which openmw-navmeshtool generates the tiles for.
+const std::string BaseAnimModel = "meshes\\base_anim.nif";
+
+// Skeleton and animations of NPCs and the player of beast races
+const std::string BaseAnimKnaModel = "meshes\\base_animkna.nif";
+
 }
 
 #endif
@@ -172,6 +172,29 @@ public:
         }
     };
 
+    struct CiEqual
+    {
+        bool operator()(const std::string& left, const std::string& right) const
+        {
+            return ciEqual(left, right);
+        }
+    };
+
+    /// Case-insensitive FNV-1a hash, for unordered containers that are looked up without lower-casing the key first
+    struct CiHash
+    {
+        std::size_t operator()(const std::string& str) const
+        {
+            std::size_t hash = 2166136261u;
+            for (char c : str)
+            {
+                hash ^= static_cast<unsigned char>(toLower(c));
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    };
+
 
     /// Performs a binary search on a sorted container for a string that 'key' starts with
     template<typename Iterator, typename T>
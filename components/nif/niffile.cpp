@@ -1,8 +1,8 @@
 #include "niffile.hpp"
 #include "effect.hpp"
 
-#include <map>
 #include <sstream>
+#include <unordered_map>
 
 namespace Nif
 {
@@ -41,9 +41,9 @@ static std::pair<std::string,RecordFactoryEntry> makeEntry(std::string recName,
 }
 
 ///These are all the record types we know how to read.
-static std::map<std::string,RecordFactoryEntry> makeFactory()
+static std::unordered_map<std::string,RecordFactoryEntry> makeFactory()
 {
-    std::map<std::string,RecordFactoryEntry> newFactory;
+    std::unordered_map<std::string,RecordFactoryEntry> newFactory;
     newFactory.insert(makeEntry("NiNode",                     &construct <NiNode>                      , RC_NiNode                        ));
     newFactory.insert(makeEntry("NiSwitchNode",               &construct <NiSwitchNode>                , RC_NiSwitchNode                  ));
     newFactory.insert(makeEntry("NiLODNode",                  &construct <NiLODNode>                   , RC_NiLODNode                     ));
@@ -116,8 +116,8 @@ static std::map<std::string,RecordFactoryEntry> makeFactory()
 }
 
 
-///Make the factory map used for parsing the file
-static const std::map<std::string,RecordFactoryEntry> factories = makeFactory();
+///Make the factory map used for parsing the file, hashed since it is looked up once for every record
+static const std::unordered_map<std::string,RecordFactoryEntry> factories = makeFactory();
 
 std::string NIFFile::printVersion(unsigned int version)
 {
@@ -162,7 +162,7 @@ void NIFFile::parse(Files::IStreamPtr stream)
             fail(error.str());
         }
 
-        std::map<std::string,RecordFactoryEntry>::const_iterator entry = factories.find(rec);
+        std::unordered_map<std::string,RecordFactoryEntry>::const_iterator entry = factories.find(rec);
 
         if (entry != factories.end())
         {
@@ -2,12 +2,38 @@
 //For error reporting
 #include "niffile.hpp"
 
+#include <components/files/memorystream.hpp>
+
 namespace Nif
 {
+    NIFStream::NIFStream(NIFFile * file, Files::IStreamPtr inp)
+        : inp(inp)
+        , file(file)
+    {
+        if (const Files::MemBuf* buffer = dynamic_cast<const Files::MemBuf*>(inp->rdbuf()))
+        {
+            mCurrent = buffer->getCurrent();
+            mEnd = buffer->getEnd();
+            return;
+        }
+
+        char chunk[64 * 1024];
+        while (inp->read(chunk, sizeof(chunk)) || inp->gcount() > 0)
+            mOwnedData.insert(mOwnedData.end(), chunk, chunk + inp->gcount());
+
+        mCurrent = mOwnedData.data();
+        mEnd = mCurrent + mOwnedData.size();
+    }
+
+    void NIFStream::failEndOfFile() const
+    {
+        file->fail("Unexpected end of file");
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float,uint32_t>(inp, (float*)&f);
+        readLittleEndianBufferOfType<4, float,uint32_t>(take(4 * sizeof(float)), (float*)&f);
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
@@ -3,7 +3,9 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <stdint.h>
 #include <stdexcept>
 #include <vector>
@@ -21,16 +23,15 @@ namespace Nif
 
 class NIFFile;
 
-/* 
+/*
     readLittleEndianBufferOfType: This template should only be used with non POD data types
 */
-template <uint32_t numInstances, typename T, typename IntegerT> inline void readLittleEndianBufferOfType(Files::IStreamPtr &pIStream, T* dest)
+template <uint32_t numInstances, typename T, typename IntegerT> inline void readLittleEndianBufferOfType(const char* source, T* dest)
 {
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    std::memcpy(dest, source, numInstances * sizeof(T));
 #else
-    uint8_t* destByteBuffer = (uint8_t*)dest;
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    const uint8_t* sourceByteBuffer = (const uint8_t*)source;
     /*
         Due to the loop iterations being known at compile time,
         this nested loop will most likely be unrolled
@@ -44,7 +45,7 @@ template <uint32_t numInstances, typename T, typename IntegerT> inline void read
     {
         u = { 0 };
         for (uint32_t byte = 0; byte < sizeof(T); byte++)
-            u.i |= (((IntegerT)destByteBuffer[i * sizeof(T) + byte]) << (byte * 8));
+            u.i |= (((IntegerT)sourceByteBuffer[i * sizeof(T) + byte]) << (byte * 8));
         dest[i] = u.t;
     }
 #endif
@@ -53,13 +54,12 @@ template <uint32_t numInstances, typename T, typename IntegerT> inline void read
 /*
     readLittleEndianDynamicBufferOfType: This template should only be used with non POD data types
 */
-template <typename T, typename IntegerT> inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr &pIStream, T* dest, uint32_t numInstances)
+template <typename T, typename IntegerT> inline void readLittleEndianDynamicBufferOfType(const char* source, T* dest, uint32_t numInstances)
 {
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    std::memcpy(dest, source, numInstances * sizeof(T));
 #else
-    uint8_t* destByteBuffer = (uint8_t*)dest;
-    pIStream->read((char*)dest, numInstances * sizeof(T));
+    const uint8_t* sourceByteBuffer = (const uint8_t*)source;
     union {
         IntegerT i;
         T t;
@@ -68,86 +68,107 @@ template <typename T, typename IntegerT> inline void readLittleEndianDynamicBuff
     {
         u.i = 0;
         for (uint32_t byte = 0; byte < sizeof(T); byte++)
-            u.i |= ((IntegerT)destByteBuffer[i * sizeof(T) + byte]) << (byte * 8);
+            u.i |= ((IntegerT)sourceByteBuffer[i * sizeof(T) + byte]) << (byte * 8);
         dest[i] = u.t;
     }
 #endif
 }
-template<typename type, typename IntegerT> type inline readLittleEndianType(Files::IStreamPtr &pIStream)
+template<typename type, typename IntegerT> type inline readLittleEndianType(const char* source)
 {
     type val;
-    readLittleEndianBufferOfType<1,type,IntegerT>(pIStream, (type*)&val);
+    readLittleEndianBufferOfType<1,type,IntegerT>(source, (type*)&val);
     return val;
 }
 
 class NIFStream
 {
-    /// Input stream
+    /// Input stream, kept alive while its buffer is being parsed
     Files::IStreamPtr inp;
 
+    /// Copy of the input, unless the input already is an in-memory stream
+    std::vector<char> mOwnedData;
+
+    /// The part of the input that has not been parsed yet
+    const char* mCurrent;
+    const char* mEnd;
+
+    [[noreturn]] void failEndOfFile() const;
+
+    /// Get the next size bytes of the input, and move past them.
+    const char* take(size_t size)
+    {
+        if (size > static_cast<size_t>(mEnd - mCurrent))
+            failEndOfFile();
+        const char* data = mCurrent;
+        mCurrent += size;
+        return data;
+    }
+
 public:
 
     NIFFile * const file;
 
-    NIFStream (NIFFile * file, Files::IStreamPtr inp): inp (inp), file (file) {}
+    /// Parses memory streams (e.g. files from memory mapped or compressed archives) in place, and reads other
+    /// streams into a buffer first.
+    NIFStream (NIFFile * file, Files::IStreamPtr inp);
 
-    void skip(size_t size) { inp->ignore(size); }
+    void skip(size_t size) { take(size); }
 
     char getChar()
     {
-        return readLittleEndianType<char,char>(inp);
+        return readLittleEndianType<char,char>(take(sizeof(char)));
     }
 
     short getShort()
     {
-        return readLittleEndianType<short,short>(inp);
+        return readLittleEndianType<short,short>(take(sizeof(short)));
     }
 
     unsigned short getUShort()
     {
-        return readLittleEndianType<unsigned short,unsigned short>(inp);
+        return readLittleEndianType<unsigned short,unsigned short>(take(sizeof(unsigned short)));
     }
 
     int getInt()
     {
-        return readLittleEndianType<int,int>(inp);
+        return readLittleEndianType<int,int>(take(sizeof(int)));
     }
 
     unsigned int getUInt()
     {
-        return readLittleEndianType<unsigned int,unsigned int>(inp);
+        return readLittleEndianType<unsigned int,unsigned int>(take(sizeof(unsigned int)));
     }
 
     float getFloat()
     {
-        return readLittleEndianType<float,uint32_t>(inp);
+        return readLittleEndianType<float,uint32_t>(take(sizeof(float)));
     }
 
     osg::Vec2f getVector2()
     {
         osg::Vec2f vec;
-        readLittleEndianBufferOfType<2,float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<2,float,uint32_t>(take(2 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     osg::Vec3f getVector3()
     {
         osg::Vec3f vec;
-        readLittleEndianBufferOfType<3, float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<3, float,uint32_t>(take(3 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     osg::Vec4f getVector4()
     {
         osg::Vec4f vec;
-        readLittleEndianBufferOfType<4, float,uint32_t>(inp, (float*)&vec._v[0]);
+        readLittleEndianBufferOfType<4, float,uint32_t>(take(4 * sizeof(float)), (float*)&vec._v[0]);
         return vec;
     }
 
     Matrix3 getMatrix3()
     {
         Matrix3 mat;
-        readLittleEndianBufferOfType<9, float,uint32_t>(inp, (float*)&mat.mValues);
+        readLittleEndianBufferOfType<9, float,uint32_t>(take(9 * sizeof(float)), (float*)&mat.mValues);
         return mat;
     }
 
@@ -172,77 +193,84 @@ public:
     ///Read in a string of the given length
     std::string getSizedString(size_t length)
     {
-        std::vector<char> str(length + 1, 0);
-
-        inp->read(str.data(), length);
+        const char* str = take(length);
 
-        return str.data();
+        // Like a C string, the string ends at the first null character
+        return std::string(str, std::find(str, str + length, '\0'));
     }
     ///Read in a string of the length specified in the file
     std::string getSizedString()
     {
-        size_t size = readLittleEndianType<uint32_t,uint32_t>(inp);
+        size_t size = readLittleEndianType<uint32_t,uint32_t>(take(sizeof(uint32_t)));
         return getSizedString(size);
     }
 
     ///Specific to Bethesda headers, uses a byte for length
     std::string getExportString()
     {
-        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t,uint8_t>(inp));
+        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t,uint8_t>(take(sizeof(uint8_t))));
         return getSizedString(size);
     }
 
     ///This is special since the version string doesn't start with a number, and ends with "\n"
     std::string getVersionString()
     {
-        std::string result;
-        std::getline(*inp, result);
+        const char* end = std::find(mCurrent, mEnd, '\n');
+        std::string result(mCurrent, end);
+        mCurrent = end == mEnd ? end : end + 1;
         return result;
     }
 
     void getUShorts(std::vector<unsigned short> &vec, size_t size)
     {
+        const char* data = take(size * sizeof(unsigned short));
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned short,unsigned short>(inp, vec.data(), size);
+        readLittleEndianDynamicBufferOfType<unsigned short,unsigned short>(data, vec.data(), size);
     }
 
     void getFloats(std::vector<float> &vec, size_t size)
     {
+        const char* data = take(size * sizeof(float));
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, vec.data(), size);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(data, vec.data(), size);
     }
 
     void getInts(std::vector<int> &vec, size_t size)
     {
+        const char* data = take(size * sizeof(int));
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<int,int>(inp, vec.data(), size);
+        readLittleEndianDynamicBufferOfType<int,int>(data, vec.data(), size);
     }
 
     void getUInts(std::vector<unsigned int> &vec, size_t size)
     {
+        const char* data = take(size * sizeof(unsigned int));
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned int,unsigned int>(inp, vec.data(), size);
+        readLittleEndianDynamicBufferOfType<unsigned int,unsigned int>(data, vec.data(), size);
     }
 
     void getVector2s(std::vector<osg::Vec2f> &vec, size_t size)
     {
+        const char* data = take(size * 2 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec2f is 2 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp,(float*)vec.data(), size*2);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(data, (float*)vec.data(), size*2);
     }
 
     void getVector3s(std::vector<osg::Vec3f> &vec, size_t size)
     {
+        const char* data = take(size * 3 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec3f is 3 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, (float*)vec.data(), size*3);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(data, (float*)vec.data(), size*3);
     }
 
     void getVector4s(std::vector<osg::Vec4f> &vec, size_t size)
     {
+        const char* data = take(size * 4 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec4f is 4 floats exactly */
-        readLittleEndianDynamicBufferOfType<float,uint32_t>(inp, (float*)vec.data(), size*4);
+        readLittleEndianDynamicBufferOfType<float,uint32_t>(data, (float*)vec.data(), size*4);
     }
 
     void getQuaternions(std::vector<osg::Quat> &quat, size_t size)
@@ -283,6 +283,10 @@ namespace mwmp
         mwmp::Item usedItem;
         bool usingItemMagic;
         char itemUseDrawState;
+
+        // Reported periodically by the client, so the server can tell how well it can handle actor authority
+        float averageFrameTime = 0;
+        unsigned int localActorCount = 0;
     };
 }
 
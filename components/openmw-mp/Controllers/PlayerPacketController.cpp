@@ -29,6 +29,7 @@
 #include "../Packets/Player/PacketPlayerLevel.hpp"
 #include "../Packets/Player/PacketPlayerMiscellaneous.hpp"
 #include "../Packets/Player/PacketPlayerMomentum.hpp"
+#include "../Packets/Player/PacketPlayerPerformance.hpp"
 #include "../Packets/Player/PacketPlayerPosition.hpp"
 #include "../Packets/Player/PacketPlayerQuickKeys.hpp"
 #include "../Packets/Player/PacketPlayerReputation.hpp"
@@ -47,6 +48,7 @@ template <typename T>
 inline void AddPacket(mwmp::PlayerPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
+    packet->setProperties(mwmp::getPacketProperties(packet->GetPacketID()));
     typedef mwmp::PlayerPacketController::packets_t::value_type value_t;
     packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
 }
@@ -85,6 +87,7 @@ mwmp::PlayerPacketController::PlayerPacketController(RakNet::RakPeerInterface *p
     AddPacket<PacketPlayerLevel>(&packets, peer);
     AddPacket<PacketPlayerMiscellaneous>(&packets, peer);
     AddPacket<PacketPlayerMomentum>(&packets, peer);
+    AddPacket<PacketPlayerPerformance>(&packets, peer);
     AddPacket<PacketPlayerPosition>(&packets, peer);
     AddPacket<PacketPlayerQuickKeys>(&packets, peer);
     AddPacket<PacketPlayerReputation>(&packets, peer);
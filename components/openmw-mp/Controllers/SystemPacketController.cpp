@@ -6,6 +6,7 @@ template <typename T>
 inline void AddPacket(mwmp::SystemPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
+    packet->setProperties(mwmp::getPacketProperties(packet->GetPacketID()));
     typedef mwmp::SystemPacketController::packets_t::value_type value_t;
     packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
 }
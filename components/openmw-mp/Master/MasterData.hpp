@@ -1,18 +1,21 @@
 #ifndef NEWMASTERPROTO_MASTERDATA_HPP
 #define NEWMASTERPROTO_MASTERDATA_HPP
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 #include <map>
 #include <list>
 #include <MessageIdentifiers.h>
+#include <RakNetTypes.h>
 
 enum MASTER_PACKETS
 {
     ID_MASTER_QUERY = ID_USER_PACKET_ENUM,
     ID_MASTER_UPDATE,
-    ID_MASTER_ANNOUNCE
+    ID_MASTER_ANNOUNCE,
+    ID_MASTER_QUERY_DELTA
 };
 
 struct ServerRule
@@ -25,6 +28,12 @@ struct ServerRule
 
     std::string str;
     double val;
+
+    bool operator==(const ServerRule &rhs) const
+    {
+        return type == rhs.type && (type == Type::string ? str == rhs.str : val == rhs.val);
+    }
+    bool operator!=(const ServerRule &rhs) const { return !(*this == rhs); }
 };
 
 struct Plugin
@@ -32,8 +41,31 @@ struct Plugin
     std::string name;
     unsigned hash;
     Plugin(std::string name = "", unsigned hash = 0): name(std::move(name)), hash(hash) {};
+
+    bool operator==(const Plugin &rhs) const { return hash == rhs.hash && name == rhs.name; }
+    bool operator!=(const Plugin &rhs) const { return !(*this == rhs); }
 };
 
+// FNV-1a over the names and checksums of a plugin list, used to share identical lists between servers
+inline unsigned hashPlugins(const std::vector<Plugin> &plugins)
+{
+    unsigned result = 2166136261u;
+    auto mix = [&result](unsigned char byte) {
+        result ^= byte;
+        result *= 16777619u;
+    };
+
+    for (const auto &plugin : plugins)
+    {
+        for (char ch : plugin.name)
+            mix(static_cast<unsigned char>(ch));
+        mix(0);
+        for (int i = 0; i < 4; ++i)
+            mix(static_cast<unsigned char>(plugin.hash >> (i * 8)));
+    }
+    return result;
+}
+
 struct QueryData
 {
     QueryData()
@@ -69,6 +101,11 @@ struct QueryData
     void SetPassword(int value) { rules["passw"].val = value; };
     int GetPassword() const { return rules.at("passw").val; }
 
+    bool operator==(const QueryData &rhs) const
+    {
+        return rules == rhs.rules && players == rhs.players && plugins == rhs.plugins;
+    }
+    bool operator!=(const QueryData &rhs) const { return !(*this == rhs); }
 
     std::vector<std::string> players;
     std::map<std::string, ServerRule> rules;
@@ -81,4 +118,13 @@ struct QueryData
     const static int maxStringLength = 256;
 };
 
+struct QueryDelta
+{
+    uint32_t revision = 0; // revision of the master's server list after applying this delta
+    bool reset = false; // the requested revision is unknown to the master, drop all known servers first
+    std::vector<std::pair<RakNet::SystemAddress, QueryData>> changed; // added or updated servers
+    std::vector<RakNet::SystemAddress> removed;
+    const static int maxPluginLists = 1024;
+};
+
 #endif //NEWMASTERPROTO_MASTERDATA_HPP
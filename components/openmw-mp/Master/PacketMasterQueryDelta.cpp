@@ -0,0 +1,156 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <iostream>
+#include "PacketMasterQueryDelta.hpp"
+#include "ProxyMasterPacket.hpp"
+
+using namespace mwmp;
+using namespace std;
+using namespace RakNet;
+
+PacketMasterQueryDelta::PacketMasterQueryDelta(RakNet::RakPeerInterface *peer) : BasePacket(peer)
+{
+    packetID = ID_MASTER_QUERY_DELTA;
+    orderChannel = CHANNEL_MASTER;
+    reliability = RELIABLE_ORDERED_WITH_ACK_RECEIPT;
+}
+
+void PacketMasterQueryDelta::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    bs = newBitstream;
+    if (send)
+        bs->Write(packetID);
+
+    RW(delta->revision, send);
+    RW(delta->reset, send);
+
+    // Servers running the same plugins share one list, referenced by its index in the packet
+    vector<vector<Plugin>> pluginLists;
+    vector<int32_t> pluginListIndices;
+
+    if (send)
+    {
+        multimap<unsigned, int32_t> listsByHash;
+        pluginListIndices.reserve(delta->changed.size());
+        for (auto &&server : delta->changed)
+        {
+            const vector<Plugin> &plugins = server.second.plugins;
+            const unsigned hash = hashPlugins(plugins);
+            int32_t index = -1;
+
+            // Different lists may share a hash, so only reuse a list with the same contents
+            auto range = listsByHash.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (pluginLists[it->second] == plugins)
+                {
+                    index = it->second;
+                    break;
+                }
+            }
+
+            if (index == -1)
+            {
+                if (pluginLists.size() < static_cast<size_t>(QueryDelta::maxPluginLists))
+                {
+                    index = static_cast<int32_t>(pluginLists.size());
+                    pluginLists.push_back(plugins);
+                    listsByHash.emplace(hash, index);
+                }
+                else
+                    std::cerr << "Too many plugin lists in PacketMasterQueryDelta::Packet, sending a server without its plugins" << std::endl;
+            }
+
+            pluginListIndices.push_back(index);
+        }
+    }
+
+    int32_t pluginListsCount = static_cast<int32_t>(pluginLists.size());
+    RW(pluginListsCount, send);
+
+    if (pluginListsCount < 0 || pluginListsCount > QueryDelta::maxPluginLists)
+    {
+        std::cerr << "Too many plugin lists. Aborting PacketMasterQueryDelta::Packet" << std::endl;
+        return;
+    }
+
+    if (!send)
+        pluginLists.resize(pluginListsCount);
+
+    for (auto &&plugins : pluginLists)
+        ProxyMasterPacket::addPlugins(this, plugins, send);
+
+    int32_t changedCount = delta->changed.size();
+    RW(changedCount, send);
+
+    if (!send)
+        delta->changed.clear();
+
+    for (int32_t i = 0; i < changedCount; ++i)
+    {
+        string addr;
+        uint16_t port = 0;
+        QueryData server;
+        int32_t pluginList = -1;
+
+        if (send)
+        {
+            addr = delta->changed[i].first.ToString(false);
+            port = delta->changed[i].first.GetPort();
+            server = delta->changed[i].second;
+            pluginList = pluginListIndices[i];
+        }
+
+        RW(addr, send);
+        RW(port, send);
+        ProxyMasterPacket::addServerState(this, server, send);
+        RW(pluginList, send);
+
+        if (addr.empty())
+        {
+            std::cerr << "Address empty. Aborting PacketMasterQueryDelta::Packet" << std::endl;
+            return;
+        }
+
+        if (!send)
+        {
+            if (pluginList >= 0 && pluginList < pluginListsCount)
+                server.plugins = pluginLists[pluginList];
+            delta->changed.emplace_back(SystemAddress(addr.c_str(), port), move(server));
+        }
+    }
+
+    int32_t removedCount = delta->removed.size();
+    RW(removedCount, send);
+
+    if (!send)
+        delta->removed.clear();
+
+    for (int32_t i = 0; i < removedCount; ++i)
+    {
+        string addr;
+        uint16_t port = 0;
+
+        if (send)
+        {
+            addr = delta->removed[i].ToString(false);
+            port = delta->removed[i].GetPort();
+        }
+
+        RW(addr, send);
+        RW(port, send);
+
+        if (addr.empty())
+        {
+            std::cerr << "Address empty. Aborting PacketMasterQueryDelta::Packet" << std::endl;
+            return;
+        }
+
+        if (!send)
+            delta->removed.emplace_back(addr.c_str(), port);
+    }
+}
+
+void PacketMasterQueryDelta::SetDelta(QueryDelta *queryDelta)
+{
+    delta = queryDelta;
+}
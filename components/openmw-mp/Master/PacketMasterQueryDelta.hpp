@@ -0,0 +1,27 @@
+#ifndef OPENMW_PACKETMASTERQUERYDELTA_HPP
+#define OPENMW_PACKETMASTERQUERYDELTA_HPP
+
+#include "../Packets/BasePacket.hpp"
+#include "MasterData.hpp"
+
+namespace mwmp
+{
+    class ProxyMasterPacket;
+
+    // Sends only the servers added, changed or removed since the revision the client last saw.
+    // Plugin lists are written once into a table and referenced by their hash from every server using them.
+    class PacketMasterQueryDelta : public BasePacket
+    {
+        friend class ProxyMasterPacket;
+    public:
+        explicit PacketMasterQueryDelta(RakNet::RakPeerInterface *peer);
+
+        void Packet(RakNet::BitStream *newBitstream, bool send) override;
+
+        void SetDelta(QueryDelta *queryDelta);
+    private:
+        QueryDelta *delta;
+    };
+}
+
+#endif //OPENMW_PACKETMASTERQUERYDELTA_HPP
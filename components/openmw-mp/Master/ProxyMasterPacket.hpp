@@ -21,6 +21,14 @@ namespace mwmp
     public:
         template<class Packet>
         static void addServer(Packet *packet, QueryData &server, bool send)
+        {
+            addServerState(packet, server, send);
+            addPlugins(packet, server.plugins, send);
+        }
+
+        // Rules and players of a server, without its plugin list
+        template<class Packet>
+        static void addServerState(Packet *packet, QueryData &server, bool send)
         {
             using namespace std;
 
@@ -78,9 +86,12 @@ namespace mwmp
 
             for(auto &&player : server.players)
                 packet->RW(player, send, false, QueryData::maxStringLength);
+        }
 
-
-            int32_t pluginsCount = server.plugins.size();
+        template<class Packet>
+        static void addPlugins(Packet *packet, std::vector<Plugin> &plugins, bool send)
+        {
+            int32_t pluginsCount = plugins.size();
             packet->RW(pluginsCount, send);
 
             if (pluginsCount > QueryData::maxPlugins)
@@ -88,11 +99,11 @@ namespace mwmp
 
             if (!send)
             {
-                server.plugins.clear();
-                server.plugins.resize(pluginsCount);
+                plugins.clear();
+                plugins.resize(pluginsCount);
             }
 
-            for (auto &&plugin : server.plugins)
+            for (auto &&plugin : plugins)
             {
                 packet->RW(plugin.name, send, false, QueryData::maxStringLength);
                 packet->RW(plugin.hash, send);
@@ -0,0 +1,154 @@
+#include "NetworkMessages.hpp"
+
+#include <vector>
+
+namespace
+{
+    struct PacketPropertiesEntry
+    {
+        GameMessages packetID;
+        mwmp::PacketProperties properties;
+    };
+
+    // Packets on the same ordering channel wait for each other whenever one of them is lost, so
+    // packets that are large or rarely sent are kept away from the ones that have to arrive quickly
+    const PacketPropertiesEntry packetPropertiesTable[] =
+    {
+        {ID_USER_MYID,                   {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_USER_DISCONNECTED,           {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_CHAT_MESSAGE,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_SYSTEM_HANDSHAKE,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_LOADED,                      {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_GUI_MESSAGEBOX,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_GAME_SETTINGS,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_GAME_PREINIT,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_WORLD_KILL_COUNT,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+        {ID_CELL_RESET,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_SYSTEM}},
+
+        // Performance reports are complete snapshots, so an old one is never worth waiting for
+        {ID_PLAYER_PERFORMANCE,          {LOW_PRIORITY,       UNRELIABLE_SEQUENCED, CHANNEL_PLAYER_MOVEMENT}},
+
+        // Positions and cell changes share a channel, so that RakNet sequences the unreliable movement updates of
+        // getMovementPacketProperties() against the cell changes: an update sent before a cell change is dropped
+        // if it arrives after it, and one sent after it waits for it. The reliable positions place players, such
+        // as when the server teleports them or when a player stops moving.
+        {ID_PLAYER_POSITION,             {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_MOVEMENT}},
+        {ID_PLAYER_CELL_CHANGE,          {IMMEDIATE_PRIORITY, RELIABLE_ORDERED,     CHANNEL_PLAYER_MOVEMENT}},
+        {ID_PLAYER_CELL_STATE,           {IMMEDIATE_PRIORITY, RELIABLE_ORDERED,     CHANNEL_PLAYER_MOVEMENT}},
+        {ID_PLAYER_MOMENTUM,             {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_BASEINFO,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_BEHAVIOR,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_CHARGEN,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_SPELLS_ACTIVE,        {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ANIM_FLAGS,           {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ANIM_PLAY,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ATTACK,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ATTRIBUTE,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_BOUNTY,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_CHARCLASS,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_DEATH,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_DISPOSITION,          {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_EQUIPMENT,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_FACTION,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_INPUT,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_JAIL,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_LEVEL,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_MISCELLANEOUS,        {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_REPUTATION,           {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_RESURRECT,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_REST,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_SHAPESHIFT,           {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_SKILL,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_SPEECH,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_STATS_DYNAMIC,        {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ITEM_USE,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_CAST,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+        {ID_PLAYER_ALLY,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_PLAYER}},
+
+        // Lists that can grow large, kept together because quick keys refer to items and spells
+        {ID_PLAYER_INVENTORY,            {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+        {ID_PLAYER_SPELLBOOK,            {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+        {ID_PLAYER_QUICKKEYS,            {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+        {ID_PLAYER_JOURNAL,              {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+        {ID_PLAYER_TOPIC,                {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+        {ID_PLAYER_BOOK,                 {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_PLAYER_INVENTORY}},
+
+        // Actor positions only include the actors that moved, so they can't replace each other
+        // and stay reliable, but no longer wait behind actor lists and AI packets
+        {ID_ACTOR_POSITION,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR_MOVEMENT}},
+
+        {ID_ACTOR_LIST,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_AUTHORITY,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_TEST,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_AI,                    {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_ANIM_FLAGS,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_ANIM_PLAY,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_ATTACK,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_CELL_CHANGE,           {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_DEATH,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_EQUIPMENT,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_CAST,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_SPEECH,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_STATS_DYNAMIC,         {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+        {ID_ACTOR_SPELLS_ACTIVE,         {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_ACTOR}},
+
+        {ID_OBJECT_ACTIVATE,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_ANIM_PLAY,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_ATTACH,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_SOUND,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_DELETE,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_LOCK,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_MOVE,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_PLACE,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_HIT,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_ROTATE,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_SCALE,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_SPAWN,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_STATE,                {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_TRAP,                 {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_OBJECT_RESTOCK,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_CONSOLE_COMMAND,             {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_CONTAINER,                   {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_DOOR_DESTINATION,            {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_DOOR_STATE,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_MUSIC_PLAY,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_VIDEO_PLAY,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_CLIENT_SCRIPT_LOCAL,         {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_SCRIPT_LOCAL_FLOAT,          {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_SCRIPT_MEMBER_SHORT,         {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+        {ID_SCRIPT_MEMBER_FLOAT,         {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_OBJECT}},
+
+        {ID_CLIENT_SCRIPT_GLOBAL,        {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_CLIENT_SCRIPT_SETTINGS,      {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_RECORD_DYNAMIC,              {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_COLLISION_OVERRIDE,    {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_DESTINATION_OVERRIDE,  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_REGION_AUTHORITY,      {IMMEDIATE_PRIORITY, RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_MAP,                   {MEDIUM_PRIORITY,    RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_TIME,                  {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}},
+        {ID_WORLD_WEATHER,               {HIGH_PRIORITY,      RELIABLE_ORDERED,     CHANNEL_WORLDSTATE}}
+    };
+
+    std::vector<mwmp::PacketProperties> buildPacketProperties()
+    {
+        std::vector<mwmp::PacketProperties> properties(256, {HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_SYSTEM});
+
+        for (const auto &entry : packetPropertiesTable)
+            properties[entry.packetID] = entry.properties;
+
+        return properties;
+    }
+}
+
+const mwmp::PacketProperties &mwmp::getPacketProperties(unsigned char packetID)
+{
+    static const std::vector<PacketProperties> properties = buildPacketProperties();
+    return properties[packetID];
+}
+
+const mwmp::PacketProperties &mwmp::getMovementPacketProperties()
+{
+    // Each update is a complete snapshot of a player's position, so an old one is never worth waiting for
+    static const PacketProperties properties = {MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, CHANNEL_PLAYER_MOVEMENT};
+    return properties;
+}
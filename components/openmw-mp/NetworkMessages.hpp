@@ -2,6 +2,7 @@
 #define OPENMW_NETWORKMESSAGES_HPP
 
 #include <MessageIdentifiers.h>
+#include <PacketPriority.h>
 
 enum GameMessages
 {
@@ -112,6 +113,7 @@ enum GameMessages
     ID_PLAYER_ALLY,
     ID_WORLD_DESTINATION_OVERRIDE,
     ID_ACTOR_SPELLS_ACTIVE,
+    ID_PLAYER_PERFORMANCE,
     ID_PLACEHOLDER
 };
 
@@ -122,8 +124,32 @@ enum OrderingChannel
     CHANNEL_PLAYER,
     CHANNEL_OBJECT,
     CHANNEL_MASTER,
-    CHANNEL_WORLDSTATE
+    CHANNEL_WORLDSTATE,
+    CHANNEL_PLAYER_MOVEMENT,
+    CHANNEL_ACTOR_MOVEMENT,
+    CHANNEL_PLAYER_INVENTORY
 };
 
+namespace mwmp
+{
+    struct PacketProperties
+    {
+        PacketPriority priority;
+        PacketReliability reliability;
+        OrderingChannel orderChannel;
+    };
+
+    // Looks up how a game packet is sent in the table in NetworkMessages.cpp, which gives every
+    // family of packets its own ordering channel so that large inventory or record packets being
+    // resent cannot hold back movement, and sends frequent state snapshots as sequenced packets
+    // that a newer snapshot is allowed to replace
+    const PacketProperties &getPacketProperties(unsigned char packetID);
+
+    // Used instead of the ID_PLAYER_POSITION entry for the movement updates players send about themselves,
+    // and for the server relaying them, so that a lost update is replaced by the next one instead of
+    // being resent ahead of it
+    const PacketProperties &getMovementPacketProperties();
+}
+
 
 #endif //OPENMW_NETWORKMESSAGES_HPP
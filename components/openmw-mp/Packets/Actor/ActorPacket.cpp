@@ -1,6 +1,7 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <PacketPriority.h>
 #include <RakPeer.h>
+#include <components/openmw-mp/Utils.hpp>
 #include "ActorPacket.hpp"
 
 using namespace mwmp;
@@ -8,9 +9,6 @@ using namespace mwmp;
 ActorPacket::ActorPacket(RakNet::RakPeerInterface *peer) : BasePacket(peer)
 {
     packetID = 0;
-    priority = HIGH_PRIORITY;
-    reliability = RELIABLE_ORDERED;
-    orderChannel = CHANNEL_ACTOR;
     this->peer = peer;
 }
 
@@ -30,20 +28,12 @@ void ActorPacket::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseActor actor;
-
-    for (unsigned int i = 0; i < actorList->count; i++)
+    for (auto &&actor : actorList->baseActors)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
-
         RW(actor.refNum, send);
         RW(actor.mpNum, send);
 
         Actor(actor, send);
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
 
@@ -56,8 +46,6 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
 
     if (send)
         actorList->count = (unsigned int)(actorList->baseActors.size());
-    else
-        actorList->baseActors.clear();
 
     RW(actorList->count, send);
 
@@ -67,6 +55,10 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
         return false;
     }
 
+    // Actors are read in place, reusing the ones left over from previous packets
+    if (!send)
+        Utils::resetVector(actorList->baseActors, actorList->count);
+
     return true;
 }
 
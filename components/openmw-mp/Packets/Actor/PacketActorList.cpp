@@ -15,13 +15,8 @@ void PacketActorList::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(actorList->action, send);
 
-    BaseActor actor;
-
-    for (unsigned int i = 0; i < actorList->count; i++)
+    for (auto &&actor : actorList->baseActors)
     {
-        if (send)
-            actor = actorList->baseActors.at(i);
-
         RW(actor.refId, send);
         RW(actor.refNum, send);
         RW(actor.mpNum, send);
@@ -31,8 +26,5 @@ void PacketActorList::Packet(RakNet::BitStream *newBitstream, bool send)
             actorList->isValid = false;
             return;
         }
-
-        if (!send)
-            actorList->baseActors.push_back(actor);
     }
 }
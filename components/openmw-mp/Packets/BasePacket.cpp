@@ -71,6 +71,13 @@ void BasePacket::Read()
     Packet(bsRead, false);
 }
 
+void BasePacket::setProperties(const PacketProperties &properties)
+{
+    priority = properties.priority;
+    reliability = properties.reliability;
+    orderChannel = properties.orderChannel;
+}
+
 void BasePacket::setGUID(RakNet::RakNetGUID newGuid)
 {
     guid = newGuid;
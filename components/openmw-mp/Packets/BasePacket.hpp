@@ -6,6 +6,8 @@
 #include <BitStream.h>
 #include <PacketPriority.h>
 
+#include <components/openmw-mp/NetworkMessages.hpp>
+
 
 namespace mwmp
 {
@@ -21,6 +23,8 @@ namespace mwmp
         virtual uint32_t Send(RakNet::AddressOrGUID destination);
         virtual void Read();
 
+        void setProperties(const PacketProperties &properties);
+
         void setGUID(RakNet::RakNetGUID newGuid);
         RakNet::RakNetGUID getGUID();
 
@@ -1,6 +1,7 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <PacketPriority.h>
 #include <RakPeer.h>
+#include <components/openmw-mp/Utils.hpp>
 #include "ObjectPacket.hpp"
 
 using namespace mwmp;
@@ -9,9 +10,6 @@ ObjectPacket::ObjectPacket(RakNet::RakPeerInterface *peer) : BasePacket(peer)
 {
     hasCellData = false;
     packetID = 0;
-    priority = HIGH_PRIORITY;
-    reliability = RELIABLE_ORDERED;
-    orderChannel = CHANNEL_OBJECT;
     this->peer = peer;
 }
 
@@ -31,17 +29,8 @@ void ObjectPacket::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
-    {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
-
+    for (auto &&baseObject : objectList->baseObjects)
         Object(baseObject, send);
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
-    }
 }
 
 bool ObjectPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
@@ -57,8 +46,6 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
 
     if (send)
         objectList->baseObjectCount = (unsigned int)(objectList->baseObjects.size());
-    else
-        objectList->baseObjects.clear();
 
     RW(objectList->baseObjectCount, send);
 
@@ -68,6 +55,10 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
         return false;
     }
 
+    // Objects are read in place, reusing the ones left over from previous packets
+    if (!send)
+        Utils::resetVector(objectList->baseObjects, objectList->baseObjectCount);
+
     if (hasCellData)
     {
         RW(objectList->cell.mData, send, true);
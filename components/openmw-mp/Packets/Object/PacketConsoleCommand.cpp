@@ -16,20 +16,13 @@ void PacketConsoleCommand::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(objectList->consoleCommand, send, true);
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    for (auto &&baseObject : objectList->baseObjects)
     {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
-
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
             RW(baseObject.guid, send);
         else
             Object(baseObject, send);
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
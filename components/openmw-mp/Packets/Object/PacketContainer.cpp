@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
 #include "PacketContainer.hpp"
 
 using namespace mwmp;
@@ -18,16 +19,10 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(objectList->action, send);
     RW(objectList->containerSubAction, send);
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    for (auto &&baseObject : objectList->baseObjects)
     {
         if (send)
-        {
-            baseObject = objectList->baseObjects.at(i);
             baseObject.containerItemCount = (unsigned int) (baseObject.containerItems.size());
-        }
-        else
-            baseObject.containerItems.clear();
 
         Object(baseObject, send);
 
@@ -39,24 +34,17 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
             return;
         }
 
-        ContainerItem containerItem;
+        if (!send)
+            Utils::resetVector(baseObject.containerItems, baseObject.containerItemCount);
 
-        for (unsigned int j = 0; j < baseObject.containerItemCount; j++)
+        for (auto &&containerItem : baseObject.containerItems)
         {
-            if (send)
-                containerItem = baseObject.containerItems.at(j);
-
             RW(containerItem.refId, send, true);
             RW(containerItem.count, send);
             RW(containerItem.charge, send);
             RW(containerItem.enchantmentCharge, send);
             RW(containerItem.soul, send, true);
             RW(containerItem.actionCount, send);
-
-            if (!send)
-                baseObject.containerItems.push_back(containerItem);
         }
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
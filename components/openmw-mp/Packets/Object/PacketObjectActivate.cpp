@@ -14,12 +14,8 @@ void PacketObjectActivate::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    for (auto &&baseObject : objectList->baseObjects)
     {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
-
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
@@ -41,8 +37,5 @@ void PacketObjectActivate::Packet(RakNet::BitStream *newBitstream, bool send)
 
             RW(baseObject.activatingActor.name, send);
         }
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
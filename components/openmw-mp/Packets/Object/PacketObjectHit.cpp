@@ -14,12 +14,8 @@ void PacketObjectHit::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    for (auto &&baseObject : objectList->baseObjects)
     {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
-
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
@@ -50,8 +46,5 @@ void PacketObjectHit::Packet(RakNet::BitStream *newBitstream, bool send)
             RW(baseObject.hitAttack.block, send);
             RW(baseObject.hitAttack.knockdown, send);
         }
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
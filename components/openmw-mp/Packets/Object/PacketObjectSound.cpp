@@ -14,12 +14,8 @@ void PacketObjectSound::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    BaseObject baseObject;
-    for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
+    for (auto &&baseObject : objectList->baseObjects)
     {
-        if (send)
-            baseObject = objectList->baseObjects.at(i);
-
         RW(baseObject.isPlayer, send);
 
         if (baseObject.isPlayer)
@@ -30,8 +26,5 @@ void PacketObjectSound::Packet(RakNet::BitStream *newBitstream, bool send)
         RW(baseObject.soundId, send, true);
         RW(baseObject.volume, send);
         RW(baseObject.pitch, send);
-
-        if (!send)
-            objectList->baseObjects.push_back(baseObject);
     }
 }
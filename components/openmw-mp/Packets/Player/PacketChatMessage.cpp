@@ -4,7 +4,6 @@
 mwmp::PacketChatMessage::PacketChatMessage(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
 {
     packetID = ID_CHAT_MESSAGE;
-    orderChannel = CHANNEL_SYSTEM;
 }
 
 void mwmp::PacketChatMessage::Packet(RakNet::BitStream *newBitstream, bool send)
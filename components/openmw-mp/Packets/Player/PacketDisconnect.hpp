@@ -12,7 +12,6 @@ namespace mwmp
         PacketDisconnect(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
         {
             packetID = ID_USER_DISCONNECTED;
-            orderChannel = CHANNEL_SYSTEM;
         }
     };
 }
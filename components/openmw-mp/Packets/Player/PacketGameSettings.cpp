@@ -6,7 +6,6 @@ using namespace mwmp;
 PacketGameSettings::PacketGameSettings(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
 {
     packetID = ID_GAME_SETTINGS;
-    orderChannel = CHANNEL_SYSTEM;
 }
 
 void PacketGameSettings::Packet(RakNet::BitStream *newBitstream, bool send)
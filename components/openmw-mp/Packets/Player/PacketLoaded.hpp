@@ -11,7 +11,6 @@ namespace mwmp
         PacketLoaded(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
         {
             packetID = ID_LOADED;
-            orderChannel = CHANNEL_SYSTEM;
         }
     };
 }
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerAlly.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 mwmp::PacketPlayerAlly::PacketPlayerAlly(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
 {
@@ -18,10 +19,7 @@ void mwmp::PacketPlayerAlly::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->alliedPlayers.clear();
-        player->alliedPlayers.resize(count);
-    }
+        Utils::resetVector(player->alliedPlayers, count);
 
     for (auto &&teamPlayerGuid : player->alliedPlayers)
     {
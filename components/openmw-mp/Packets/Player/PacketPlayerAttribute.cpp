@@ -1,6 +1,7 @@
 #include "PacketPlayerAttribute.hpp"
 
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
@@ -30,10 +31,7 @@ void PacketPlayerAttribute::Packet(RakNet::BitStream *newBitstream, bool send)
         RW(count, send);
 
         if (!send)
-        {
-            player->attributeIndexChanges.clear();
-            player->attributeIndexChanges.resize(count);
-        }
+            Utils::resetVector(player->attributeIndexChanges, count);
 
         for (auto &&attributeIndex : player->attributeIndexChanges)
         {
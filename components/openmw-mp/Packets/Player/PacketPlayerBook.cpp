@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerBook.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -21,10 +22,7 @@ void PacketPlayerBook::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->bookChanges.clear();
-        player->bookChanges.resize(count);
-    }
+        Utils::resetVector(player->bookChanges, count);
 
     for (auto &&book : player->bookChanges)
     {
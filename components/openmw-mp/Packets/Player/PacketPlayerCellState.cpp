@@ -1,12 +1,11 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerCellState.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 
 mwmp::PacketPlayerCellState::PacketPlayerCellState(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
 {
     packetID = ID_PLAYER_CELL_STATE;
-    priority = IMMEDIATE_PRIORITY;
-    reliability = RELIABLE_ORDERED;
 }
 
 void mwmp::PacketPlayerCellState::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -21,10 +20,7 @@ void mwmp::PacketPlayerCellState::Packet(RakNet::BitStream *newBitstream, bool s
     RW(count, send);
 
     if (!send)
-    {
-        player->cellStateChanges.clear();
-        player->cellStateChanges.resize(count);
-    }
+        Utils::resetVector(player->cellStateChanges, count);
 
     for (auto &&cellState : player->cellStateChanges)
     {
@@ -1,6 +1,7 @@
 #include "PacketPlayerEquipment.hpp"
 
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
@@ -31,10 +32,7 @@ void PacketPlayerEquipment::Packet(RakNet::BitStream *newBitstream, bool send)
         RW(count, send);
 
         if (!send)
-        {
-            player->equipmentIndexChanges.clear();
-            player->equipmentIndexChanges.resize(count);
-        }
+            Utils::resetVector(player->equipmentIndexChanges, count);
 
         for (auto &&equipmentIndex : player->equipmentIndexChanges)
         {
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerFaction.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -23,10 +24,7 @@ void PacketPlayerFaction::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->factionChanges.factions.clear();
-        player->factionChanges.factions.resize(count);
-    }
+        Utils::resetVector(player->factionChanges.factions, count);
 
     for (auto &&faction : player->factionChanges.factions)
     {
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerInventory.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -23,10 +24,7 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->inventoryChanges.items.clear();
-        player->inventoryChanges.items.resize(count);
-    }
+        Utils::resetVector(player->inventoryChanges.items, count);
 
     for (auto &&item : player->inventoryChanges.items)
     {
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerJournal.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -21,10 +22,7 @@ void PacketPlayerJournal::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->journalChanges.clear();
-        player->journalChanges.resize(count);
-    }
+        Utils::resetVector(player->journalChanges, count);
 
     for (auto &&journalItem : player->journalChanges)
     {
@@ -0,0 +1,17 @@
+#include "PacketPlayerPerformance.hpp"
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+using namespace mwmp;
+
+PacketPlayerPerformance::PacketPlayerPerformance(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
+{
+    packetID = ID_PLAYER_PERFORMANCE;
+}
+
+void PacketPlayerPerformance::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    PlayerPacket::Packet(newBitstream, send);
+
+    RW(player->averageFrameTime, send);
+    RW(player->localActorCount, send);
+}
@@ -0,0 +1,17 @@
+#ifndef OPENMW_PACKETPLAYERPERFORMANCE_HPP
+#define OPENMW_PACKETPLAYERPERFORMANCE_HPP
+
+#include <components/openmw-mp/Packets/Player/PlayerPacket.hpp>
+
+namespace mwmp
+{
+    class PacketPlayerPerformance : public PlayerPacket
+    {
+    public:
+        PacketPlayerPerformance(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+    };
+}
+
+#endif //OPENMW_PACKETPLAYERPERFORMANCE_HPP
@@ -7,8 +7,6 @@ using namespace mwmp;
 PacketPlayerPosition::PacketPlayerPosition(RakNet::RakPeerInterface *peer) : PlayerPacket(peer)
 {
     packetID = ID_PLAYER_POSITION;
-    priority = MEDIUM_PRIORITY;
-    //reliability = UNRELIABLE_SEQUENCED;
 }
 
 void PacketPlayerPosition::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerQuickKeys.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -21,10 +22,7 @@ void PacketPlayerQuickKeys::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->quickKeyChanges.clear();
-        player->quickKeyChanges.resize(count);
-    }
+        Utils::resetVector(player->quickKeyChanges, count);
 
     for (auto &&quickKey : player->quickKeyChanges)
     {
@@ -2,6 +2,7 @@
 
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/esm/creaturestats.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
@@ -30,10 +31,7 @@ void PacketPlayerSkill::Packet(RakNet::BitStream *newBitstream, bool send)
         RW(count, send);
 
         if (!send)
-        {
-            player->skillIndexChanges.clear();
-            player->skillIndexChanges.resize(count);
-        }
+            Utils::resetVector(player->skillIndexChanges, count);
 
         for (auto &&skillId : player->skillIndexChanges)
         {
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerSpellbook.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -23,10 +24,7 @@ void PacketPlayerSpellbook::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->spellbookChanges.spells.clear();
-        player->spellbookChanges.spells.resize(count);
-    }
+        Utils::resetVector(player->spellbookChanges.spells, count);
 
     for (auto &&spell : player->spellbookChanges.spells)
     {
@@ -1,6 +1,7 @@
 #include "PacketPlayerStatsDynamic.hpp"
 
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
@@ -29,10 +30,7 @@ void PacketPlayerStatsDynamic::Packet(RakNet::BitStream *newBitstream, bool send
         RW(count, send);
 
         if (!send)
-        {
-            player->statsDynamicIndexChanges.clear();
-            player->statsDynamicIndexChanges.resize(count);
-        }
+            Utils::resetVector(player->statsDynamicIndexChanges, count);
 
         for (auto &&statsDynamicIndex : player->statsDynamicIndexChanges)
         {
@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include "PacketPlayerTopic.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -21,10 +22,7 @@ void PacketPlayerTopic::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(count, send);
 
     if (!send)
-    {
-        player->topicChanges.clear();
-        player->topicChanges.resize(count);
-    }
+        Utils::resetVector(player->topicChanges, count);
 
     for (auto &&topic : player->topicChanges)
     {
@@ -6,7 +6,6 @@ using namespace mwmp;
 PacketSystemHandshake::PacketSystemHandshake(RakNet::RakPeerInterface *peer) : SystemPacket(peer)
 {
     packetID = ID_SYSTEM_HANDSHAKE;
-    orderChannel = CHANNEL_SYSTEM;
 }
 
 void PacketSystemHandshake::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -8,9 +8,6 @@ using namespace mwmp;
 SystemPacket::SystemPacket(RakNet::RakPeerInterface *peer) : BasePacket(peer)
 {
     packetID = 0;
-    priority = HIGH_PRIORITY;
-    reliability = RELIABLE_ORDERED;
-    orderChannel = CHANNEL_SYSTEM;
     this->peer = peer;
 }
 
@@ -1,12 +1,12 @@
 #include "PacketCellReset.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
 PacketCellReset::PacketCellReset(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_CELL_RESET;
-    orderChannel = CHANNEL_SYSTEM;
 }
 
 void PacketCellReset::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -21,10 +21,7 @@ void PacketCellReset::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(cellCount, send);
 
     if (!send)
-    {
-        worldstate->cellsToReset.clear();
-        worldstate->cellsToReset.resize(cellCount);
-    }
+        Utils::resetVector(worldstate->cellsToReset, cellCount);
 
     for (auto &&cellToReset : worldstate->cellsToReset)
     {
@@ -1,12 +1,12 @@
 #include "PacketClientScriptGlobal.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
 PacketClientScriptGlobal::PacketClientScriptGlobal(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_CLIENT_SCRIPT_GLOBAL;
-    orderChannel = CHANNEL_WORLDSTATE;
 }
 
 void PacketClientScriptGlobal::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -21,10 +21,7 @@ void PacketClientScriptGlobal::Packet(RakNet::BitStream *newBitstream, bool send
     RW(clientGlobalsCount, send);
 
     if (!send)
-    {
-        worldstate->clientGlobals.clear();
-        worldstate->clientGlobals.resize(clientGlobalsCount);
-    }
+        Utils::resetVector(worldstate->clientGlobals, clientGlobalsCount);
 
     for (auto &&clientGlobal : worldstate->clientGlobals)
     {
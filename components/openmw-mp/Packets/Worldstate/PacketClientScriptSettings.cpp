@@ -1,12 +1,12 @@
 #include "PacketClientScriptSettings.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
 PacketClientScriptSettings::PacketClientScriptSettings(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_CLIENT_SCRIPT_SETTINGS;
-    orderChannel = CHANNEL_WORLDSTATE;
 }
 
 void PacketClientScriptSettings::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -21,10 +21,7 @@ void PacketClientScriptSettings::Packet(RakNet::BitStream *newBitstream, bool se
     RW(clientScriptsCount, send);
 
     if (!send)
-    {
-        worldstate->synchronizedClientScriptIds.clear();
-        worldstate->synchronizedClientScriptIds.resize(clientScriptsCount);
-    }
+        Utils::resetVector(worldstate->synchronizedClientScriptIds, clientScriptsCount);
 
     for (auto &&clientScriptId : worldstate->synchronizedClientScriptIds)
     {
@@ -39,10 +36,7 @@ void PacketClientScriptSettings::Packet(RakNet::BitStream *newBitstream, bool se
     RW(clientGlobalsCount, send);
 
     if (!send)
-    {
-        worldstate->synchronizedClientGlobalIds.clear();
-        worldstate->synchronizedClientGlobalIds.resize(clientGlobalsCount);
-    }
+        Utils::resetVector(worldstate->synchronizedClientGlobalIds, clientGlobalsCount);
 
     for (auto &&clientGlobalId : worldstate->synchronizedClientGlobalIds)
     {
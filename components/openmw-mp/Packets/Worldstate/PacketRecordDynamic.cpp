@@ -9,7 +9,6 @@ using namespace mwmp;
 PacketRecordDynamic::PacketRecordDynamic(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_RECORD_DYNAMIC;
-    orderChannel = CHANNEL_WORLDSTATE;
 }
 
 void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -891,10 +890,7 @@ void PacketRecordDynamic::ProcessEffects(ESM::EffectList &effectList, bool send)
     }
 
     if (!send)
-    {
-        effectList.mList.clear();
-        effectList.mList.resize(effectCount);
-    }
+        Utils::resetVector(effectList.mList, effectCount);
 
     for (auto &&effect : effectList.mList)
     {
@@ -924,10 +920,7 @@ void PacketRecordDynamic::ProcessBodyParts(ESM::PartReferenceList &partList, boo
     }
 
     if (!send)
-    {
-        partList.mParts.clear();
-        partList.mParts.resize(partCount);
-    }
+        Utils::resetVector(partList.mParts, partCount);
 
     for (auto &&part : partList.mParts)
     {
@@ -955,8 +948,7 @@ void PacketRecordDynamic::ProcessInventoryList(std::vector<mwmp::Item> &inventor
 
     if (!send)
     {
-        inventory.clear();
-        inventory.resize(itemCount);
+        Utils::resetVector(inventory, itemCount);
         inventoryList.mList.clear();
     }
 
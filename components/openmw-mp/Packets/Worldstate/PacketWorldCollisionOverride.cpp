@@ -1,12 +1,12 @@
 #include "PacketWorldCollisionOverride.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
 PacketWorldCollisionOverride::PacketWorldCollisionOverride(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_WORLD_COLLISION_OVERRIDE;
-    orderChannel = CHANNEL_WORLDSTATE;
 }
 
 void PacketWorldCollisionOverride::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -26,10 +26,7 @@ void PacketWorldCollisionOverride::Packet(RakNet::BitStream *newBitstream, bool
     RW(enforcedCollisionCount, send);
 
     if (!send)
-    {
-        worldstate->enforcedCollisionRefIds.clear();
-        worldstate->enforcedCollisionRefIds.resize(enforcedCollisionCount);
-    }
+        Utils::resetVector(worldstate->enforcedCollisionRefIds, enforcedCollisionCount);
 
     for (auto &&enforcedCollisionRefId : worldstate->enforcedCollisionRefIds)
     {
@@ -1,12 +1,12 @@
 #include "PacketWorldKillCount.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace mwmp;
 
 PacketWorldKillCount::PacketWorldKillCount(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_WORLD_KILL_COUNT;
-    orderChannel = CHANNEL_SYSTEM;
 }
 
 void PacketWorldKillCount::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -21,10 +21,7 @@ void PacketWorldKillCount::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(killChangesCount, send);
 
     if (!send)
-    {
-        worldstate->killChanges.clear();
-        worldstate->killChanges.resize(killChangesCount);
-    }
+        Utils::resetVector(worldstate->killChanges, killChangesCount);
 
     for (auto &&killChange : worldstate->killChanges)
     {
@@ -1,6 +1,7 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include "PacketWorldMap.hpp"
+#include <components/openmw-mp/Utils.hpp>
 
 using namespace std;
 using namespace mwmp;
@@ -22,10 +23,7 @@ void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(changesCount, send);
 
     if (!send)
-    {
-        worldstate->mapTiles.clear();
-        worldstate->mapTiles.resize(changesCount);
-    }
+        Utils::resetVector(worldstate->mapTiles, changesCount);
 
     for (auto &&mapTile : worldstate->mapTiles)
     {
@@ -48,10 +46,7 @@ void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
         }
 
         if (!send)
-        {
-            mapTile.imageData.clear();
-            mapTile.imageData.resize(imageDataSize);
-        }
+            Utils::resetVector(mapTile.imageData, imageDataSize);
 
         for (auto &&imageChar : mapTile.imageData)
         {
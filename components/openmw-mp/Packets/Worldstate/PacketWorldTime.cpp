@@ -6,7 +6,6 @@ using namespace mwmp;
 PacketWorldTime::PacketWorldTime(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_WORLD_TIME;
-    orderChannel = CHANNEL_WORLDSTATE;
 }
 
 void PacketWorldTime::Packet(RakNet::BitStream *newBitstream, bool send)
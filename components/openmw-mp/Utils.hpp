@@ -39,10 +39,38 @@ namespace Utils
         return static_cast<uint32_t>(vectorChecked.size());
     }
 
+    // Reset a reused element to its default state. Strings and vectors are cleared rather than replaced, so that
+    // they keep their memory
+    inline void resetElement(std::string &element)
+    {
+        element.clear();
+    }
+
+    template <class Type>
+    void resetElement(std::vector<Type> &element)
+    {
+        element.clear();
+    }
+
+    // Other types get a copy of a default element. Unlike assigning a new element, copy assignment reuses the memory
+    // of the strings and vectors they hold, and every member is reset, including ones added later
+    template <class Type>
+    void resetElement(Type &element)
+    {
+        static const Type defaultElement = Type();
+        element = defaultElement;
+    }
+
+    // Resize a vector to newSize default elements, resetting the elements it already has in place
+    // instead of destroying them, so packets read into the same payload keep their allocated memory
     template <class Type>
     void resetVector(std::vector<Type> &vectorInput, uint32_t newSize)
     {
-        vectorInput.clear();
+        uint32_t reusedSize = std::min(getVectorSize(vectorInput), newSize);
+
+        for (uint32_t i = 0; i < reusedSize; i++)
+            resetElement(vectorInput[i]);
+
         vectorInput.resize(newSize);
     }
 
@@ -1,6 +1,7 @@
 #include "scenemanager.hpp"
 
 #include <cstdlib>
+#include <sstream>
 
 #include <osg/Node>
 #include <osg/UserDataContainer>
@@ -33,6 +34,7 @@
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
 #include "multiobjectcache.hpp"
+#include "templatecache.hpp"
 
 namespace
 {
@@ -477,56 +479,102 @@ namespace Resource
         else
         {
             osg::ref_ptr<osg::Node> loaded;
-            try
+
+            bool cacheable = false;
+            std::uint64_t sourceHash = 0;
+            std::string cacheKey;
+            if (mTemplateCache)
             {
-                Files::IStreamPtr file = mVFS->get(normalized);
+                try
+                {
+                    sourceHash = TemplateCache::hashSource(*mVFS->get(normalized));
+                    cacheable = true;
+                }
+                catch (std::exception&)
+                {
+                    // the error is reported when loading it below
+                }
 
-                loaded = load(file, normalized, mImageManager, mNifFileManager);
+                if (cacheable)
+                {
+                    cacheKey = getTemplateCacheKey(normalized);
+                    loaded = mTemplateCache->read(cacheKey, sourceHash, createReadOptions(), cacheable);
+                }
             }
-            catch (std::exception& e)
+
+            if (loaded)
+            {
+                // The cached template has already been optimized. Filtering and shaders are still applied here,
+                // as filter settings may have changed, and so that shader programs are shared with other templates.
+                SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+                loaded->accept(setFilterSettingsVisitor);
+                SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+                loaded->accept(setFilterSettingsControllerVisitor);
+
+                recreateShaders(loaded);
+
+                mSharedStateMutex.lock();
+                mSharedStateManager->share(loaded.get());
+                mSharedStateMutex.unlock();
+            }
+            else
             {
-                static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
+                try
+                {
+                    Files::IStreamPtr file = mVFS->get(normalized);
 
-                for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
+                    loaded = load(file, normalized, mImageManager, mNifFileManager);
+                }
+                catch (std::exception& e)
                 {
-                    normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
-                    if (mVFS->exists(normalized))
+                    static const char * const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2" };
+
+                    cacheable = false;
+
+                    for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
                     {
-                        Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
-                        Files::IStreamPtr file = mVFS->get(normalized);
-                        loaded = load(file, normalized, mImageManager, mNifFileManager);
-                        break;
+                        normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
+                        if (mVFS->exists(normalized))
+                        {
+                            Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error." << sMeshTypes[i] << " instead";
+                            Files::IStreamPtr file = mVFS->get(normalized);
+                            loaded = load(file, normalized, mImageManager, mNifFileManager);
+                            break;
+                        }
                     }
+
+                    if (!loaded)
+                        throw;
                 }
 
-                if (!loaded)
-                    throw;
-            }
+                // set filtering settings
+                SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+                loaded->accept(setFilterSettingsVisitor);
+                SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+                loaded->accept(setFilterSettingsControllerVisitor);
 
-            // set filtering settings
-            SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsVisitor);
-            SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsControllerVisitor);
+                osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
+                loaded->accept(*shaderVisitor);
 
-            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor (createShaderVisitor());
-            loaded->accept(*shaderVisitor);
+                // share state
+                // do this before optimizing so the optimizer will be able to combine nodes more aggressively
+                // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
+                mSharedStateMutex.lock();
+                mSharedStateManager->share(loaded.get());
+                mSharedStateMutex.unlock();
 
-            // share state
-            // do this before optimizing so the optimizer will be able to combine nodes more aggressively
-            // note, because StateSets will be shared at this point, StateSets can not be modified inside the optimizer
-            mSharedStateMutex.lock();
-            mSharedStateManager->share(loaded.get());
-            mSharedStateMutex.unlock();
+                if (canOptimize(normalized))
+                {
+                    SceneUtil::Optimizer optimizer;
+                    optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
-            if (canOptimize(normalized))
-            {
-                SceneUtil::Optimizer optimizer;
-                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+                    static const unsigned int options = getOptimizationOptions();
 
-                static const unsigned int options = getOptimizationOptions();
+                    optimizer.optimize(loaded, options);
+                }
 
-                optimizer.optimize(loaded, options);
+                if (cacheable)
+                    mTemplateCache->write(cacheKey, sourceHash, *loaded, createReadOptions());
             }
 
             if (mIncrementalCompileOperation)
@@ -539,6 +587,33 @@ namespace Resource
         }
     }
 
+    osg::ref_ptr<osgDB::Options> SceneManager::createReadOptions() const
+    {
+        osg::ref_ptr<osgDB::Options> options (new osgDB::Options);
+        // Read images referenced by cached templates through the ImageManager, so that they are shared with other templates
+        options->setReadFileCallback(new ImageReadCallback(mImageManager));
+        return options;
+    }
+
+    std::string SceneManager::getTemplateCacheKey(const std::string &normalizedName) const
+    {
+        static const unsigned int options = getOptimizationOptions();
+
+        std::ostringstream key;
+        key << normalizedName
+            << "\noptimize " << options
+            << "\nmarkers " << NifOsg::Loader::getShowMarkers()
+            << "\nshaders " << mForceShaders << ' ' << mClampLighting
+            << "\nnormal maps " << mAutoUseNormalMaps << ' ' << mNormalMapPattern << ' ' << mNormalHeightMapPattern
+            << "\nspecular maps " << mAutoUseSpecularMaps << ' ' << mSpecularMapPattern;
+        return key.str();
+    }
+
+    void SceneManager::setTemplateCachePath(const std::string &path)
+    {
+        mTemplateCache.reset(new TemplateCache(path));
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::cacheInstance(const std::string &name)
     {
         std::string normalized = name;
@@ -16,6 +16,7 @@ namespace Resource
     class ImageManager;
     class NifFileManager;
     class SharedStateManager;
+    class TemplateCache;
 }
 
 namespace osgUtil
@@ -26,6 +27,7 @@ namespace osgUtil
 namespace osgDB
 {
     class SharedStateManager;
+    class Options;
 }
 
 namespace Shader
@@ -136,6 +138,10 @@ namespace Resource
         /// otherwise should be disabled to reduce memory usage.
         void setUnRefImageDataAfterApply(bool unref);
 
+        /// Keep converted and optimized templates in the given directory, and load them from there when their source file hasn't changed.
+        /// @see TemplateCache
+        void setTemplateCachePath(const std::string& path);
+
         /// @see ResourceManager::updateCache
         void updateCache(double referenceTime) override;
 
@@ -147,6 +153,11 @@ namespace Resource
 
         Shader::ShaderVisitor* createShaderVisitor();
 
+        osg::ref_ptr<osgDB::Options> createReadOptions() const;
+
+        /// The template's name, and all settings that affect how it is converted
+        std::string getTemplateCacheKey(const std::string& normalizedName) const;
+
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
         bool mForceShaders;
         bool mClampLighting;
@@ -171,6 +182,8 @@ namespace Resource
 
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
 
+        std::unique_ptr<TemplateCache> mTemplateCache;
+
         unsigned int mParticleSystemMask;
 
         SceneManager(const SceneManager&);
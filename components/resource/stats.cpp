@@ -292,11 +292,34 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Composite",
             "",
             "UnrefQueue",
+            "Skinning Batch",
             "",
             "NavMesh UpdateJobs",
+            "NavMesh QueueLatency",
+            "NavMesh QueueLatencyMax",
             "NavMesh CacheSize",
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
+            "NavMesh DiskHits",
+            "NavMesh DiskMisses",
+            "NavMesh DiskWrites",
+            "NavMesh DiskSize",
+            "",
+            "AI Decisions",
+            "AI Deferred",
+            "AI DecisionTime",
+            "AI Wander",
+            "AI Travel",
+            "AI Escort",
+            "AI Follow",
+            "AI Activate",
+            "AI Combat",
+            "AI Pursue",
+            "AI AvoidDoor",
+            "AI Face",
+            "AI Breathe",
+            "AI InternalTravel",
+            "AI Cast",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
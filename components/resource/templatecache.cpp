@@ -0,0 +1,287 @@
+#include "templatecache.hpp"
+
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <osg/Geometry>
+#include <osg/Node>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+
+#include <osgDB/ObjectWrapper>
+#include <osgDB/Registry>
+
+#include <components/debug/debuglog.hpp>
+#include <components/nifosg/userdata.hpp>
+
+namespace
+{
+    const char sMagic[8] = {'O', 'M', 'W', 'T', 'M', 'P', 'L', '\0'};
+
+    // Increase when the way templates are created changes, to throw out old cache files
+    const std::uint32_t sFormatVersion = 1;
+
+    template <class Cls>
+    osg::Object* createInstanceFunc() { return new Cls; }
+
+    bool checkNodeUserData(const NifOsg::NodeUserData&)
+    {
+        return true;
+    }
+
+    bool readNodeUserData(osgDB::InputStream& stream, NifOsg::NodeUserData& data)
+    {
+        stream >> data.mIndex >> data.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                stream >> data.mRotationScale.mValues[i][j];
+        return true;
+    }
+
+    bool writeNodeUserData(osgDB::OutputStream& stream, const NifOsg::NodeUserData& data)
+    {
+        stream << data.mIndex << data.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                stream << data.mRotationScale.mValues[i][j];
+        stream << std::endl;
+        return true;
+    }
+
+    /// NodeUserData is attached to every node loaded from a NIF file, so templates can only be cached if it can be stored.
+    class NodeUserDataSerializer : public osgDB::ObjectWrapper
+    {
+    public:
+        NodeUserDataSerializer()
+            : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::NodeUserData>, "NifOsg::NodeUserData", "osg::Object NifOsg::NodeUserData")
+        {
+            addSerializer(new osgDB::UserSerializer<NifOsg::NodeUserData>("Data", &checkNodeUserData, &readNodeUserData, &writeNodeUserData),
+                          osgDB::BaseSerializer::RW_USER);
+        }
+    };
+
+    void describeCallbacks(const osg::Callback* callback, std::ostream& out)
+    {
+        for (; callback; callback = callback->getNestedCallback())
+            out << ' ' << typeid(*callback).name();
+    }
+
+    void describeStateSet(const osg::StateSet* stateset, std::ostream& out)
+    {
+        if (!stateset)
+            return;
+
+        out << " {";
+        for (const auto& attribute : stateset->getAttributeList())
+            out << ' ' << typeid(*attribute.second.first).name();
+        for (const osg::StateSet::AttributeList& unit : stateset->getTextureAttributeList())
+        {
+            for (const auto& attribute : unit)
+            {
+                out << ' ' << typeid(*attribute.second.first).name();
+
+                // Images are stored by file name, so images without one (e.g. embedded in a NIF) are lost
+                if (const osg::Texture* texture = attribute.second.first->asTexture())
+                {
+                    for (unsigned int i = 0; i < texture->getNumImages(); ++i)
+                        out << (texture->getImage(i) ? " image" : " no image");
+                }
+            }
+        }
+        out << " }";
+    }
+
+    /// Write the actual types of all objects in the graph, so that objects that were read back as a base class
+    /// (e.g. a custom osg::Group subclass without its own serializer) or not at all can be told apart.
+    void describe(const osg::Node& node, std::ostream& out)
+    {
+        out << typeid(node).name();
+        describeCallbacks(node.getUpdateCallback(), out);
+        describeCallbacks(node.getCullCallback(), out);
+        describeCallbacks(node.getEventCallback(), out);
+        describeStateSet(node.getStateSet(), out);
+
+        if (const osg::UserDataContainer* container = node.getUserDataContainer())
+        {
+            for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+                out << ' ' << typeid(*container->getUserObject(i)).name();
+        }
+
+        if (const osg::Geometry* geometry = dynamic_cast<const osg::Geometry*>(&node))
+        {
+            out << " vertices " << (geometry->getVertexArray() ? geometry->getVertexArray()->getNumElements() : 0)
+                << " primitives " << geometry->getNumPrimitiveSets();
+        }
+
+        out << '\n';
+
+        if (const osg::Group* group = node.asGroup())
+        {
+            out << "(\n";
+            for (unsigned int i = 0; i < group->getNumChildren(); ++i)
+                describe(*group->getChild(i), out);
+            out << ")\n";
+        }
+    }
+
+    std::string describe(const osg::Node& node)
+    {
+        std::ostringstream stream;
+        describe(node, stream);
+        return stream.str();
+    }
+
+    osgDB::ReaderWriter* getReaderWriter()
+    {
+        osgDB::ReaderWriter* readerWriter = osgDB::Registry::instance()->getReaderWriterForExtension("osgb");
+        if (!readerWriter)
+            throw std::runtime_error("No readerwriter for 'osgb' found");
+        return readerWriter;
+    }
+}
+
+namespace Resource
+{
+
+    TemplateCache::TemplateCache(const std::string& path)
+        : mPath(path)
+    {
+        boost::filesystem::create_directories(mPath);
+
+        static const bool registered = [] {
+            osgDB::Registry::instance()->getObjectWrapperManager()->addWrapper(new NodeUserDataSerializer);
+            return true;
+        } ();
+        (void)registered;
+    }
+
+    std::uint64_t TemplateCache::hashSource(std::istream& stream)
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ull;
+        char buffer[64 * 1024];
+        while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+        {
+            for (std::streamsize i = 0; i < stream.gcount(); ++i)
+            {
+                hash ^= static_cast<unsigned char>(buffer[i]);
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    boost::filesystem::path TemplateCache::getFilePath(const std::string& key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.osgb", static_cast<unsigned long long>(std::hash<std::string>()(key)));
+        return mPath / name;
+    }
+
+    osg::ref_ptr<osg::Node> TemplateCache::read(const std::string& key, std::uint64_t sourceHash, const osgDB::Options* options, bool& cacheable) const
+    {
+        try
+        {
+            boost::filesystem::ifstream stream(getFilePath(key), std::ios_base::binary);
+            if (!stream.is_open())
+                return nullptr;
+
+            char magic[sizeof(sMagic)];
+            std::uint32_t version = 0;
+            std::uint64_t storedSourceHash = 0;
+            std::uint32_t keySize = 0;
+            stream.read(magic, sizeof(magic));
+            stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+            stream.read(reinterpret_cast<char*>(&storedSourceHash), sizeof(storedSourceHash));
+            stream.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+            if (!stream || std::char_traits<char>::compare(magic, sMagic, sizeof(sMagic)) != 0
+                    || version != sFormatVersion || storedSourceHash != sourceHash || keySize != key.size())
+                return nullptr;
+
+            std::string storedKey(keySize, '\0');
+            char storedCacheable = 0;
+            stream.read(&storedKey[0], keySize);
+            stream.read(&storedCacheable, 1);
+            if (!stream || storedKey != key)
+                return nullptr;
+
+            if (!storedCacheable)
+            {
+                cacheable = false;
+                return nullptr;
+            }
+
+            osgDB::ReaderWriter::ReadResult result = getReaderWriter()->readNode(stream, options);
+            if (!result.success())
+            {
+                Log(Debug::Warning) << "Failed to read cached template " << getFilePath(key) << ": " << result.message();
+                return nullptr;
+            }
+            return result.getNode();
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read cached template " << getFilePath(key) << ": " << e.what();
+            return nullptr;
+        }
+    }
+
+    void TemplateCache::write(const std::string& key, std::uint64_t sourceHash, const osg::Node& node, const osgDB::Options* options) const
+    {
+        const boost::filesystem::path path = getFilePath(key);
+        try
+        {
+            osg::ref_ptr<osgDB::Options> writeOptions (new osgDB::Options);
+            writeOptions->setPluginStringData("fileType", "Binary");
+            // Images are read through the resource system again, rather than being stored with every template using them
+            writeOptions->setOptionString("WriteImageHint=UseExternal");
+
+            osgDB::ReaderWriter* readerWriter = getReaderWriter();
+
+            std::stringstream stream;
+            osgDB::ReaderWriter::WriteResult writeResult = readerWriter->writeNode(node, stream, writeOptions);
+            const std::string data = stream.str();
+            bool cacheable = writeResult.success();
+
+            if (cacheable)
+            {
+                std::istringstream readBack(data);
+                osgDB::ReaderWriter::ReadResult readResult = readerWriter->readNode(readBack, options);
+                cacheable = readResult.success() && readResult.getNode() && describe(*readResult.getNode()) == describe(node);
+            }
+
+            // Other threads may be writing the same template, so each one writes its own file and renames it into place
+            std::ostringstream tmpName;
+            tmpName << path.string() << '.' << std::this_thread::get_id() << ".tmp";
+            const boost::filesystem::path tmpPath (tmpName.str());
+            {
+                boost::filesystem::ofstream file(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+                file.write(sMagic, sizeof(sMagic));
+                file.write(reinterpret_cast<const char*>(&sFormatVersion), sizeof(sFormatVersion));
+                file.write(reinterpret_cast<const char*>(&sourceHash), sizeof(sourceHash));
+                const std::uint32_t keySize = static_cast<std::uint32_t>(key.size());
+                file.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+                file.write(key.data(), key.size());
+                const char storedCacheable = cacheable ? 1 : 0;
+                file.write(&storedCacheable, 1);
+                if (cacheable)
+                    file.write(data.data(), data.size());
+                if (!file)
+                    throw std::runtime_error("Failed to write " + tmpPath.string());
+            }
+            boost::filesystem::rename(tmpPath, path);
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write cached template " << path << ": " << e.what();
+        }
+    }
+
+}
@@ -0,0 +1,59 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_TEMPLATECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_TEMPLATECACHE_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+#include <osg/ref_ptr>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+}
+
+namespace Resource
+{
+
+    /// @brief Keeps converted and optimized scene templates on disk in OSG's binary format, so that they
+    /// don't have to be converted again on the next start.
+    /// @par Templates that contain objects OSG can not write and read back (e.g. animation controllers)
+    /// are not stored. Instead, this is remembered so that they are not tried again.
+    /// @note Thread safe.
+    class TemplateCache
+    {
+    public:
+        /// @param path The directory to keep the cache files in. It is created if needed.
+        TemplateCache(const std::string& path);
+
+        /// Hash the contents of a source file, to detect when it has changed.
+        static std::uint64_t hashSource(std::istream& stream);
+
+        /// Read the template stored for the given key.
+        /// @param key Identifies the template, i.e. its file name and all settings that affect its contents.
+        /// @param sourceHash Hash of the source file, see hashSource().
+        /// @param options Options for reading the scene, e.g. for reading the images through the resource system.
+        /// @param cacheable Set to false if the template was found not to be cacheable before.
+        /// @return The template, or nullptr if it is not in the cache or the source file has changed.
+        osg::ref_ptr<osg::Node> read(const std::string& key, std::uint64_t sourceHash, const osgDB::Options* options, bool& cacheable) const;
+
+        /// Store the template for the given key, or remember that it is not cacheable.
+        /// @param options Options for reading the scene, used to check that it can be read back.
+        void write(const std::string& key, std::uint64_t sourceHash, const osg::Node& node, const osgDB::Options* options) const;
+
+    private:
+        boost::filesystem::path getFilePath(const std::string& key) const;
+
+        boost::filesystem::path mPath;
+    };
+
+}
+
+#endif
@@ -5,14 +5,14 @@
 #include <components/debug/debuglog.hpp>
 
 #include "skeleton.hpp"
+#include "skinningbatch.hpp"
 #include "util.hpp"
 
 namespace
 {
-    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    inline void accumulateMatrix(const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
     {
-        osg::Matrixf m = invBindMatrix * matrix;
-        float* ptr = m.ptr();
+        const float* ptr = matrix.ptr();
         float* ptrresult = result.ptr();
         ptrresult[0] += ptr[0] * weight;
         ptrresult[1] += ptr[1] * weight;
@@ -30,14 +30,33 @@ namespace
         ptrresult[13] += ptr[13] * weight;
         ptrresult[14] += ptr[14] * weight;
     }
+
+    // Skinning matrices are affine, so unlike osg::Matrixf::preMult there is no perspective divide
+    inline osg::Vec3f transformPoint(const float* m, const osg::Vec3f& v)
+    {
+        return osg::Vec3f(m[0] * v.x() + m[4] * v.y() + m[8] * v.z() + m[12],
+                          m[1] * v.x() + m[5] * v.y() + m[9] * v.z() + m[13],
+                          m[2] * v.x() + m[6] * v.y() + m[10] * v.z() + m[14]);
+    }
+
+    inline osg::Vec3f transformVector(const float* m, float x, float y, float z)
+    {
+        return osg::Vec3f(m[0] * x + m[4] * y + m[8] * z,
+                          m[1] * x + m[5] * y + m[9] * z,
+                          m[2] * x + m[6] * y + m[10] * z);
+    }
 }
 
 namespace SceneUtil
 {
 
 RigGeometry::RigGeometry()
-    : mSkeleton(nullptr)
+    : mCurrentGeometry(0)
+    , mSkeleton(nullptr)
     , mLastFrameNumber(0)
+    , mLastCullFrameNumber(0)
+    , mSkinnedRevision(0)
+    , mNeedToSkin(true)
     , mBoundsFirstFrame(true)
 {
     setNumChildrenRequiringUpdateTraversal(1);
@@ -46,11 +65,15 @@ RigGeometry::RigGeometry()
 
 RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     : Drawable(copy, copyop)
+    , mCurrentGeometry(0)
     , mSkeleton(nullptr)
     , mInfluenceMap(copy.mInfluenceMap)
     , mBone2VertexVector(copy.mBone2VertexVector)
     , mBoneSphereVector(copy.mBoneSphereVector)
     , mLastFrameNumber(0)
+    , mLastCullFrameNumber(0)
+    , mSkinnedRevision(0)
+    , mNeedToSkin(true)
     , mBoundsFirstFrame(true)
 {
     setSourceGeometry(copy.mSourceGeometry);
@@ -60,6 +83,7 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
 void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
 {
     mSourceGeometry = sourceGeometry;
+    mNeedToSkin = true;
 
     for (unsigned int i=0; i<2; ++i)
     {
@@ -142,31 +166,12 @@ bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
         const std::string& boneName = bonePair.first;
         Bone* bone = mSkeleton->getBone(boneName);
         if (!bone)
-        {
-            mBoneNodesVector.push_back(nullptr);
             Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-            continue;
-        }
 
         mBoneNodesVector.push_back(bone);
     }
-
-    for (auto& pair : mBone2VertexVector->mData)
-    {
-        for (auto &weight : pair.first)
-        {
-            const std::string& boneName = weight.first.first;
-            Bone* bone = mSkeleton->getBone(boneName);
-            if (!bone)
-            {
-                mBoneNodesVector.push_back(nullptr);
-                Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-                continue;
-            }
-
-            mBoneNodesVector.push_back(bone);
-        }
-    }
+    mSkinningMatrices.resize(mBoneNodesVector.size());
+    mNeedToSkin = true;
 
     return true;
 }
@@ -182,65 +187,92 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     }
 
     unsigned int traversalNumber = nv->getTraversalNumber();
-    if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+    mLastCullFrameNumber = traversalNumber;
+    if (mLastFrameNumber != traversalNumber && (mLastFrameNumber == 0 || mSkeleton->getActive()))
     {
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
-        return;
+        mSkeleton->updateBoneMatrices(traversalNumber);
+        skin(traversalNumber);
     }
+
+    osg::Geometry& geom = *mGeometry[mCurrentGeometry];
+    nv->pushOntoNodePath(&geom);
+    nv->apply(geom);
+    nv->popFromNodePath();
+}
+
+bool RigGeometry::needsSkinning() const
+{
+    return mNeedToSkin || mSkinnedRevision != mSkeleton->getBoneMatricesRevision();
+}
+
+void RigGeometry::skin(unsigned int traversalNumber)
+{
     mLastFrameNumber = traversalNumber;
-    osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+    if (!needsSkinning())
+        return;
+    mNeedToSkin = false;
+    mSkinnedRevision = mSkeleton->getBoneMatricesRevision();
 
-    mSkeleton->updateBoneMatrices(traversalNumber);
+    // The other buffer may still be drawn for the previous frame
+    mCurrentGeometry ^= 1;
+    osg::Geometry& geom = *mGeometry[mCurrentGeometry];
+
+    // Each bone once, rather than once for every combination of weights it is part of
+    for (std::size_t i = 0; i < mBoneNodesVector.size(); ++i)
+    {
+        if (const Bone* bone = mBoneNodesVector[i])
+            mSkinningMatrices[i] = mInfluenceMap->mData[i].second.mInvBindMatrix * bone->mMatrixInSkeletonSpace;
+    }
 
-    // skinning
-    const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+    const osg::Vec3Array& positionSrc = static_cast<const osg::Vec3Array&>(*mSourceGeometry->getVertexArray());
+    const osg::Vec3Array* normalSrc = static_cast<const osg::Vec3Array*>(mSourceGeometry->getNormalArray());
     const osg::Vec4Array* tangentSrc = mSourceTangents;
 
-    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+    osg::Vec3Array& positionDst = static_cast<osg::Vec3Array&>(*geom.getVertexArray());
     osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
     osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-    int index = mBoneSphereVector->mData.size();
-    for (auto &pair : mBone2VertexVector->mData)
+    for (const auto& pair : mBone2VertexVector->mData)
     {
         osg::Matrixf resultMat (0, 0, 0, 0,
                                 0, 0, 0, 0,
                                 0, 0, 0, 0,
                                 0, 0, 0, 1);
 
-        for (auto &weight : pair.first)
+        for (const BoneWeight& weight : pair.first)
         {
-            Bone* bone = mBoneNodesVector[index];
-            if (bone == nullptr)
-                continue;
-
-            accumulateMatrix(weight.first.second, bone->mMatrixInSkeletonSpace, weight.second, resultMat);
-            index++;
+            if (mBoneNodesVector[weight.first] != nullptr)
+                accumulateMatrix(mSkinningMatrices[weight.first], weight.second, resultMat);
         }
 
         if (mGeomToSkelMatrix)
             resultMat *= (*mGeomToSkelMatrix);
 
-        for (auto &vertex : pair.second)
+        // One loop per array, so that the loops are free of branches
+        const float* m = resultMat.ptr();
+        for (unsigned short vertex : pair.second)
+            positionDst[vertex] = transformPoint(m, positionSrc[vertex]);
+
+        if (normalDst)
         {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-            if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+            for (unsigned short vertex : pair.second)
+            {
+                const osg::Vec3f& normal = (*normalSrc)[vertex];
+                (*normalDst)[vertex] = transformVector(m, normal.x(), normal.y(), normal.z());
+            }
+        }
 
-            if (tangentDst)
+        if (tangentDst)
+        {
+            for (unsigned short vertex : pair.second)
             {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
+                const osg::Vec4f& tangent = (*tangentSrc)[vertex];
+                (*tangentDst)[vertex] = osg::Vec4f(transformVector(m, tangent.x(), tangent.y(), tangent.z()), tangent.w());
             }
         }
     }
 
-    positionDst->dirty();
+    positionDst.dirty();
     if (normalDst)
         normalDst->dirty();
     if (tangentDst)
@@ -249,10 +281,6 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
 #if OSG_MIN_VERSION_REQUIRED(3, 5, 6)
     geom.dirtyGLObjects();
 #endif
-
-    nv->pushOntoNodePath(&geom);
-    nv->apply(geom);
-    nv->popFromNodePath();
 }
 
 void RigGeometry::updateBounds(osg::NodeVisitor *nv)
@@ -273,14 +301,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 
     osg::BoundingBox box;
 
-    int index = 0;
+    std::size_t index = 0;
     for (auto& boundPair : mBoneSphereVector->mData)
     {
-        Bone* bone = mBoneNodesVector[index];
+        Bone* bone = mBoneNodesVector[index++];
         if (bone == nullptr)
             continue;
 
-        index++;
         osg::BoundingSpheref bs = boundPair.second;
         if (mGeomToSkelMatrix)
             transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
@@ -305,6 +332,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
             geom.dirtyBound();
         }
     }
+
+    // Skin ahead of the cull traversal, together with the other rigs that were rendered in the previous frame
+    if (mLastCullFrameNumber + 1 == nv->getTraversalNumber() && needsSkinning())
+    {
+        if (SkinningBatch* batch = dynamic_cast<SkinningBatch*>(nv->getUserData()))
+            batch->add(this, nv->getTraversalNumber());
+    }
 }
 
 void RigGeometry::updateGeomToSkelMatrix(const osg::NodePath& nodePath)
@@ -329,30 +363,35 @@ void RigGeometry::updateGeomToSkelMatrix(const osg::NodePath& nodePath)
             }
         }
     }
-    if (geomToSkelMatrix && !geomToSkelMatrix->isIdentity())
+    if (geomToSkelMatrix && !geomToSkelMatrix->isIdentity()
+            && (!mGeomToSkelMatrix || *mGeomToSkelMatrix != *geomToSkelMatrix))
+    {
         mGeomToSkelMatrix = geomToSkelMatrix;
+        mNeedToSkin = true;
+    }
 }
 
 void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
 {
     mInfluenceMap = influenceMap;
+    mNeedToSkin = true;
 
     typedef std::map<unsigned short, std::vector<BoneWeight> > Vertex2BoneMap;
     Vertex2BoneMap vertex2BoneMap;
     mBoneSphereVector = new BoneSphereVector;
     mBoneSphereVector->mData.reserve(mInfluenceMap->mData.size());
     mBone2VertexVector = new Bone2VertexVector;
-    for (auto& influencePair : mInfluenceMap->mData)
+    for (std::size_t i = 0; i < mInfluenceMap->mData.size(); ++i)
     {
-        const std::string& boneName = influencePair.first;
-        const BoneInfluence& bi = influencePair.second;
+        const std::string& boneName = mInfluenceMap->mData[i].first;
+        const BoneInfluence& bi = mInfluenceMap->mData[i].second;
         mBoneSphereVector->mData.emplace_back(boneName, bi.mBoundSphere);
 
         for (auto& weightPair: bi.mWeights)
         {
             std::vector<BoneWeight>& vec = vertex2BoneMap[weightPair.first];
 
-            vec.emplace_back(std::make_pair(boneName, bi.mInvBindMatrix), weightPair.second);
+            vec.emplace_back(static_cast<unsigned short>(i), weightPair.second);
         }
     }
 
@@ -385,12 +424,7 @@ void RigGeometry::accept(osg::NodeVisitor &nv)
 
 void RigGeometry::accept(osg::PrimitiveFunctor& func) const
 {
-    getGeometry(mLastFrameNumber)->accept(func);
-}
-
-osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
-{
-    return mGeometry[frame%2].get();
+    mGeometry[mCurrentGeometry]->accept(func);
 }
 
 
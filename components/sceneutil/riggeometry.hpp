@@ -14,6 +14,8 @@ namespace SceneUtil
     /// Note though that the RigGeometry ignores any transforms below the Skeleton, so the attachment point is not that important.
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread safe way while
     /// not compromising rendering performance. This is crucial when using osg's default threading model of DrawThreadPerContext.
+    /// @note Skinning is skipped when neither the bones nor the transform to the skeleton changed since the last time, the last
+    /// skinned buffer is then rendered again.
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -46,6 +48,11 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry();
 
+        /// Skin the vertices for the frame \a traversalNumber, unless the bones did not move since the last time.
+        /// @note Called by the cull traversal, or before it by a SkinningBatch. Must follow the update traversal, which
+        /// initializes the skeleton and the bone matrices.
+        void skin(unsigned int traversalNumber);
+
         virtual void accept(osg::NodeVisitor &nv);
         virtual bool supports(const osg::PrimitiveFunctor&) const { return true; }
         virtual void accept(osg::PrimitiveFunctor&) const;
@@ -68,8 +75,11 @@ namespace SceneUtil
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
 
+        bool needsSkinning() const;
+
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // The buffer skinned last, the other one is written by the next skinning
+        unsigned int mCurrentGeometry;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
@@ -79,9 +89,8 @@ namespace SceneUtil
 
         osg::ref_ptr<InfluenceMap> mInfluenceMap;
 
-        typedef std::pair<std::string, osg::Matrixf> BoneBindMatrixPair;
-
-        typedef std::pair<BoneBindMatrixPair, float> BoneWeight;
+        // <index in the influence map, weight>
+        typedef std::pair<unsigned short, float> BoneWeight;
 
         typedef std::vector<unsigned short> VertexList;
 
@@ -98,9 +107,15 @@ namespace SceneUtil
             std::vector<std::pair<std::string, osg::BoundingSpheref>> mData;
         };
         osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
+        // One per entry of the influence map, nullptr if the bone was not found
         std::vector<Bone*> mBoneNodesVector;
+        // Inverse bind matrix times bone matrix, one per entry of the influence map
+        std::vector<osg::Matrixf> mSkinningMatrices;
 
         unsigned int mLastFrameNumber;
+        unsigned int mLastCullFrameNumber;
+        unsigned int mSkinnedRevision;
+        bool mNeedToSkin;
         bool mBoundsFirstFrame;
 
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
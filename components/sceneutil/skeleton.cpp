@@ -6,6 +6,15 @@
 #include <components/debug/debuglog.hpp>
 #include <components/misc/stringops.hpp>
 
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // Skeletons may be created by the preloading threads
+    std::atomic<unsigned int> sNextUpdateOffset(0);
+}
+
 namespace SceneUtil
 {
 
@@ -35,7 +44,10 @@ private:
 Skeleton::Skeleton()
     : mBoneCacheInit(false)
     , mNeedToUpdateBoneMatrices(true)
+    , mBoneMatricesRevision(0)
     , mActive(Active)
+    , mUpdateInterval(1)
+    , mUpdateOffset(sNextUpdateOffset++)
     , mLastFrameNumber(0)
     , mLastCullFrameNumber(0)
 {
@@ -46,7 +58,10 @@ Skeleton::Skeleton(const Skeleton &copy, const osg::CopyOp &copyop)
     : osg::Group(copy, copyop)
     , mBoneCacheInit(false)
     , mNeedToUpdateBoneMatrices(true)
+    , mBoneMatricesRevision(0)
     , mActive(copy.mActive)
+    , mUpdateInterval(copy.mUpdateInterval)
+    , mUpdateOffset(sNextUpdateOffset++)
     , mLastFrameNumber(0)
     , mLastCullFrameNumber(0)
 {
@@ -116,14 +131,22 @@ void Skeleton::updateBoneMatrices(unsigned int traversalNumber)
     {
         if (mRootBone.get())
         {
+            bool changed = false;
             for (unsigned int i=0; i<mRootBone->mChildren.size(); ++i)
-                mRootBone->mChildren[i]->update(nullptr);
+                changed |= mRootBone->mChildren[i]->update(nullptr);
+            if (changed)
+                ++mBoneMatricesRevision;
         }
 
         mNeedToUpdateBoneMatrices = false;
     }
 }
 
+unsigned int Skeleton::getBoneMatricesRevision() const
+{
+    return mBoneMatricesRevision;
+}
+
 void Skeleton::setActive(ActiveType active)
 {
     mActive = active;
@@ -134,6 +157,11 @@ bool Skeleton::getActive() const
     return mActive != Inactive;
 }
 
+void Skeleton::setUpdateInterval(unsigned int interval)
+{
+    mUpdateInterval = std::max(1u, interval);
+}
+
 void Skeleton::markDirty()
 {
     mLastFrameNumber = 0;
@@ -149,6 +177,8 @@ void Skeleton::traverse(osg::NodeVisitor& nv)
             return;
         if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber+3 <= nv.getTraversalNumber())
             return;
+        if (mUpdateInterval > 1 && mLastFrameNumber != 0 && (nv.getTraversalNumber() + mUpdateOffset) % mUpdateInterval != 0)
+            return;
     }
     else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
         mLastCullFrameNumber = nv.getTraversalNumber();
@@ -178,22 +208,25 @@ Bone::~Bone()
     mChildren.clear();
 }
 
-void Bone::update(const osg::Matrixf* parentMatrixInSkeletonSpace)
+bool Bone::update(const osg::Matrixf* parentMatrixInSkeletonSpace)
 {
     if (!mNode)
     {
         Log(Debug::Error) << "Error: Bone without node";
-        return;
+        return false;
     }
+    const osg::Matrixf previous = mMatrixInSkeletonSpace;
     if (parentMatrixInSkeletonSpace)
         mMatrixInSkeletonSpace = mNode->getMatrix() * (*parentMatrixInSkeletonSpace);
     else
         mMatrixInSkeletonSpace = mNode->getMatrix();
 
+    bool changed = mMatrixInSkeletonSpace != previous;
     for (unsigned int i=0; i<mChildren.size(); ++i)
     {
-        mChildren[i]->update(&mMatrixInSkeletonSpace);
+        changed |= mChildren[i]->update(&mMatrixInSkeletonSpace);
     }
+    return changed;
 }
 
 }
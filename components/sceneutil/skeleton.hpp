@@ -23,7 +23,8 @@ namespace SceneUtil
         std::vector<Bone*> mChildren;
 
         /// Update the skeleton-space matrix of this bone and all its children.
-        void update(const osg::Matrixf* parentMatrixInSkeletonSpace);
+        /// @return Whether any of the matrices changed
+        bool update(const osg::Matrixf* parentMatrixInSkeletonSpace);
 
     private:
         Bone(const Bone&);
@@ -47,6 +48,9 @@ namespace SceneUtil
         /// Request an update of bone matrices. May be a no-op if already updated in this frame.
         void updateBoneMatrices(unsigned int traversalNumber);
 
+        /// Incremented whenever updateBoneMatrices changes a bone matrix, so that rigs can skip skinning when the bones did not move.
+        unsigned int getBoneMatricesRevision() const;
+
         enum ActiveType
         {
             Inactive=0,
@@ -60,6 +64,10 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Only run the update traversal, i.e. animate the bones, every \a interval frames. Used to animate distant actors
+        /// at a lower rate. The frames are staggered between skeletons, so that they do not all update in the same frame.
+        void setUpdateInterval(unsigned int interval);
+
         void traverse(osg::NodeVisitor& nv);
 
         void markDirty();
@@ -77,9 +85,13 @@ namespace SceneUtil
         bool mBoneCacheInit;
 
         bool mNeedToUpdateBoneMatrices;
+        unsigned int mBoneMatricesRevision;
 
         ActiveType mActive;
 
+        unsigned int mUpdateInterval;
+        unsigned int mUpdateOffset;
+
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
     };
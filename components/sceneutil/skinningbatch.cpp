@@ -0,0 +1,101 @@
+#include "skinningbatch.hpp"
+
+#include <osg/Stats>
+
+#include <algorithm>
+
+#include "riggeometry.hpp"
+#include "workqueue.hpp"
+
+namespace
+{
+    // Few rigs are skinned faster than work items are handed over to the threads
+    const std::size_t sMinRigsPerThread = 4;
+
+    using RigIterator = std::vector<osg::ref_ptr<SceneUtil::RigGeometry>>::const_iterator;
+
+    void skinRigs(RigIterator begin, RigIterator end, unsigned int traversalNumber)
+    {
+        for (auto it = begin; it != end; ++it)
+            (*it)->skin(traversalNumber);
+    }
+
+    class SkinWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        SkinWorkItem(RigIterator begin, RigIterator end, unsigned int traversalNumber)
+            : mBegin(begin)
+            , mEnd(end)
+            , mTraversalNumber(traversalNumber)
+        {
+        }
+
+        virtual void doWork()
+        {
+            skinRigs(mBegin, mEnd, mTraversalNumber);
+        }
+
+    private:
+        RigIterator mBegin;
+        RigIterator mEnd;
+        unsigned int mTraversalNumber;
+    };
+}
+
+namespace SceneUtil
+{
+    SkinningBatch::SkinningBatch(int numThreads)
+        : mWorkQueue(new WorkQueue(numThreads))
+        , mNumThreads(numThreads)
+        , mTraversalNumber(0)
+        , mNumSkinned(0)
+    {
+    }
+
+    SkinningBatch::~SkinningBatch()
+    {
+    }
+
+    void SkinningBatch::add(RigGeometry* rig, unsigned int traversalNumber)
+    {
+        // Update traversals without rendering, e.g. on the loading screen, leave rigs that must not be skinned later on
+        if (traversalNumber != mTraversalNumber)
+        {
+            mRigs.clear();
+            mTraversalNumber = traversalNumber;
+        }
+        mRigs.push_back(rig);
+    }
+
+    void SkinningBatch::skin()
+    {
+        mNumSkinned = mRigs.size();
+        if (mRigs.empty())
+            return;
+
+        const std::size_t numChunks = std::min(static_cast<std::size_t>(mNumThreads) + 1,
+                                               (mRigs.size() + sMinRigsPerThread - 1) / sMinRigsPerThread);
+        const std::size_t chunkSize = (mRigs.size() + numChunks - 1) / numChunks;
+
+        // The calling thread skins the first chunk meanwhile
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (std::size_t begin = chunkSize; begin < mRigs.size(); begin += chunkSize)
+        {
+            const std::size_t end = std::min(begin + chunkSize, mRigs.size());
+            items.emplace_back(new SkinWorkItem(mRigs.begin() + begin, mRigs.begin() + end, mTraversalNumber));
+            mWorkQueue->addWorkItem(items.back());
+        }
+
+        skinRigs(mRigs.begin(), mRigs.begin() + std::min(chunkSize, mRigs.size()), mTraversalNumber);
+
+        for (const auto& item : items)
+            item->waitTillDone();
+
+        mRigs.clear();
+    }
+
+    void SkinningBatch::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Skinning Batch", mNumSkinned);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNINGBATCH_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNINGBATCH_H
+
+#include <osg/ref_ptr>
+#include <osg/Referenced>
+
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace SceneUtil
+{
+    class RigGeometry;
+    class WorkQueue;
+
+    /// @brief Skins the RigGeometries that were rendered in the previous frame on several threads, before the cull traversal.
+    /// @par Set as user data of the update visitor, so that the rigs whose bones moved can add themselves during the update
+    /// traversal. skin() is then called between the update and the rendering traversals, and the cull traversal renders what
+    /// was skinned. Any other rig, e.g. one coming into view, is skinned by the cull traversal as usual.
+    class SkinningBatch : public osg::Referenced
+    {
+    public:
+        /// @param numThreads Number of worker threads, in addition to the thread calling skin()
+        explicit SkinningBatch(int numThreads);
+        ~SkinningBatch();
+
+        /// Add a rig to skin for the frame \a traversalNumber. Call from the update traversal.
+        void add(RigGeometry* rig, unsigned int traversalNumber);
+
+        /// Skin all added rigs, waiting until they are done, and empty the batch. Call from the main thread.
+        void skin();
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+        int mNumThreads;
+        unsigned int mTraversalNumber;
+        std::vector<osg::ref_ptr<RigGeometry>> mRigs;
+        std::size_t mNumSkinned;
+    };
+}
+
+#endif
@@ -6,11 +6,14 @@
 
 #include <osgUtil/IncrementalCompileOperation>
 
+#include <OpenThreads/ScopedLock>
+
 #include <components/resource/objectcache.hpp>
 #include <components/resource/scenemanager.hpp>
 
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/sceneutil/lightmanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 
 #include "terraindrawable.hpp"
 #include "material.hpp"
@@ -21,6 +24,52 @@
 namespace Terrain
 {
 
+/// Creates a chunk requested with ChunkManager::requestChunk() in the background
+class ChunkWorkItem : public SceneUtil::WorkItem
+{
+public:
+    ChunkWorkItem(ChunkManager* chunkManager, float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags)
+        : mChunkManager(chunkManager)
+        , mSize(size)
+        , mCenter(center)
+        , mLod(lod)
+        , mLodFlags(lodFlags)
+        , mAborted(false)
+    {
+    }
+
+    virtual void doWork()
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWorkMutex);
+        if (mAborted)
+            return;
+        mNode = mChunkManager->getChunk(mSize, mCenter, mLod, mLodFlags);
+    }
+
+    /// Once this returns, the item no longer uses the ChunkManager.
+    virtual void abort()
+    {
+        OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mWorkMutex);
+        mAborted = true;
+    }
+
+    osg::ref_ptr<osg::Node> getNode() const
+    {
+        return mNode;
+    }
+
+private:
+    ChunkManager* mChunkManager;
+    float mSize;
+    osg::Vec2f mCenter;
+    unsigned char mLod;
+    unsigned int mLodFlags;
+
+    osg::ref_ptr<osg::Node> mNode;
+    OpenThreads::Mutex mWorkMutex;
+    bool mAborted;
+};
+
 ChunkManager::ChunkManager(Storage *storage, Resource::SceneManager *sceneMgr, TextureManager* textureManager, CompositeMapRenderer* renderer)
     : GenericResourceManager<ChunkId>(nullptr)
     , mStorage(storage)
@@ -34,6 +83,18 @@ ChunkManager::ChunkManager(Storage *storage, Resource::SceneManager *sceneMgr, T
 
 }
 
+ChunkManager::~ChunkManager()
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mPendingMutex);
+    for (PendingMap::iterator it = mPending.begin(); it != mPending.end(); ++it)
+        it->second->abort();
+}
+
+void ChunkManager::setWorkQueue(SceneUtil::WorkQueue* workQueue)
+{
+    mWorkQueue = workQueue;
+}
+
 osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f &center, unsigned char lod, unsigned int lodFlags)
 {
     ChunkId id = std::make_tuple(center, lod, lodFlags);
@@ -48,9 +109,76 @@ osg::ref_ptr<osg::Node> ChunkManager::getChunk(float size, const osg::Vec2f &cen
     }
 }
 
+osg::ref_ptr<osg::Node> ChunkManager::requestChunk(float size, const osg::Vec2f &center, unsigned char lod, unsigned int lodFlags)
+{
+    if (!mWorkQueue)
+        return getChunk(size, center, lod, lodFlags);
+
+    ChunkId id = std::make_tuple(center, lod, lodFlags);
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mPendingMutex);
+
+    osg::ref_ptr<osg::Node> node;
+    PendingMap::iterator found = mPending.find(id);
+    if (found != mPending.end())
+    {
+        if (!found->second->isDone())
+            return nullptr;
+        node = found->second->getNode();
+        mPending.erase(found);
+    }
+
+    if (!node)
+    {
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(id);
+        if (obj)
+            node = obj->asNode();
+    }
+
+    if (!node)
+    {
+        osg::ref_ptr<ChunkWorkItem> item (new ChunkWorkItem(this, size, center, lod, lodFlags));
+        mPending.emplace(id, item);
+        // Needed for the current view, so it goes ahead of cell preloading
+        mWorkQueue->addWorkItem(item, true);
+        return nullptr;
+    }
+
+    if (!isReady(node))
+        return nullptr;
+    return node;
+}
+
+bool ChunkManager::isReady(osg::Node* chunk) const
+{
+    // The composite map is rendered within the per-frame budget before the chunk is shown,
+    // rather than all at once when the chunk is first drawn
+    osg::Group* group = chunk->asGroup();
+    TerrainDrawable* drawable = group && group->getNumChildren() ? dynamic_cast<TerrainDrawable*>(group->getChild(0)) : nullptr;
+    return !drawable || !drawable->getCompositeMap() || mCompositeMapRenderer->isCompiled(drawable->getCompositeMap());
+}
+
+void ChunkManager::updateCache(double referenceTime)
+{
+    GenericResourceManager<ChunkId>::updateCache(referenceTime);
+
+    // Forget chunks that were created in the background but not requested again, so that they can expire
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mPendingMutex);
+    for (PendingMap::iterator it = mPending.begin(); it != mPending.end(); )
+    {
+        if (it->second->isDone())
+            mPending.erase(it++);
+        else
+            ++it;
+    }
+}
+
 void ChunkManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
 {
     stats->setAttribute(frameNumber, "Terrain Chunk", mCache->getCacheSize());
+
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mPendingMutex);
+    stats->setAttribute(frameNumber, "Terrain Chunk Pending", mPending.size());
 }
 
 void ChunkManager::clearCache()
@@ -1,8 +1,11 @@
 #ifndef OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 #define OPENMW_COMPONENTS_TERRAIN_CHUNKMANAGER_H
 
+#include <map>
 #include <tuple>
 
+#include <OpenThreads/Mutex>
+
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
@@ -18,6 +21,11 @@ namespace Resource
     class SceneManager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Terrain
 {
 
@@ -25,6 +33,7 @@ namespace Terrain
     class CompositeMapRenderer;
     class Storage;
     class CompositeMap;
+    class ChunkWorkItem;
 
     typedef std::tuple<osg::Vec2f, unsigned char, unsigned int> ChunkId; // Center, Lod, Lod Flags
 
@@ -33,13 +42,27 @@ namespace Terrain
     {
     public:
         ChunkManager(Storage* storage, Resource::SceneManager* sceneMgr, TextureManager* textureManager, CompositeMapRenderer* renderer);
+        ~ChunkManager();
 
+        /// Get a chunk, creating it right away if it is not cached.
+        /// @note Thread safe.
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags);
 
+        /// Get a chunk if it is ready to be drawn, otherwise start creating it in the background.
+        /// A chunk is ready once it has been created and its composite map, if any, has been rendered.
+        /// @note Without a work queue, this creates the chunk right away like getChunk().
+        /// @return The chunk, or nullptr if it is not ready yet.
+        osg::ref_ptr<osg::Node> requestChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags);
+
+        /// Set a WorkQueue to create chunks requested with requestChunk() in the background.
+        void setWorkQueue(SceneUtil::WorkQueue* workQueue);
+
         void setCompositeMapSize(unsigned int size) { mCompositeMapSize = size; }
         void setCompositeMapLevel(float level) { mCompositeMapLevel = level; }
         void setMaxCompositeGeometrySize(float maxCompGeometrySize) { mMaxCompGeometrySize = maxCompGeometrySize; }
 
+        void updateCache(double referenceTime) override;
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
         void clearCache() override;
@@ -55,6 +78,8 @@ namespace Terrain
 
         std::vector<osg::ref_ptr<osg::StateSet> > createPasses(float chunkSize, const osg::Vec2f& chunkCenter, bool forCompositeMap);
 
+        bool isReady(osg::Node* chunk) const;
+
         Terrain::Storage* mStorage;
         Resource::SceneManager* mSceneManager;
         TextureManager* mTextureManager;
@@ -64,6 +89,12 @@ namespace Terrain
         unsigned int mCompositeMapSize;
         float mCompositeMapLevel;
         float mMaxCompGeometrySize;
+
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+
+        typedef std::map<ChunkId, osg::ref_ptr<ChunkWorkItem> > PendingMap;
+        PendingMap mPending;
+        mutable OpenThreads::Mutex mPendingMutex;
     };
 
 }
@@ -10,6 +10,7 @@
 #include <components/sceneutil/workqueue.hpp>
 
 #include <algorithm>
+#include <limits>
 
 namespace Terrain
 {
@@ -17,6 +18,8 @@ namespace Terrain
 CompositeMapRenderer::CompositeMapRenderer()
     : mTargetFrameRate(120)
     , mMinimumTimeAvailable(0.0025)
+    , mTimeBudget(std::numeric_limits<double>::max())
+    , mCompiling(nullptr)
 {
     setSupportsDisplayList(false);
     setCullingActive(false);
@@ -44,8 +47,8 @@ void CompositeMapRenderer::drawImplementation(osg::RenderInfo &renderInfo) const
     mTimer.setStartTick();
     double targetFrameTime = 1.0/static_cast<double>(mTargetFrameRate);
     double conservativeTimeRatio(0.75);
-    double availableTime = std::max((targetFrameTime - dt)*conservativeTimeRatio,
-                                    mMinimumTimeAvailable);
+    double availableTime = std::min(std::max((targetFrameTime - dt)*conservativeTimeRatio,
+                                             mMinimumTimeAvailable), mTimeBudget);
 
     if (mWorkQueue)
         mUnrefQueue->flush(mWorkQueue.get());
@@ -59,10 +62,13 @@ void CompositeMapRenderer::drawImplementation(osg::RenderInfo &renderInfo) const
     {
         osg::ref_ptr<CompositeMap> node = *mImmediateCompileSet.begin();
         mImmediateCompileSet.erase(node);
+        mCompiling = node;
 
         mMutex.unlock();
         compile(*node, renderInfo, nullptr);
         mMutex.lock();
+
+        mCompiling = nullptr;
     }
 
     double timeLeft = availableTime;
@@ -71,11 +77,14 @@ void CompositeMapRenderer::drawImplementation(osg::RenderInfo &renderInfo) const
     {
         osg::ref_ptr<CompositeMap> node = *mCompileSet.begin();
         mCompileSet.erase(node);
+        mCompiling = node;
 
         mMutex.unlock();
         compile(*node, renderInfo, &timeLeft);
         mMutex.lock();
 
+        mCompiling = nullptr;
+
         if (node->mCompiled < node->mDrawables.size())
         {
             // We did not compile the map fully.
@@ -175,6 +184,11 @@ void CompositeMapRenderer::setTargetFrameRate(float framerate)
     mTargetFrameRate = framerate;
 }
 
+void CompositeMapRenderer::setTimeBudget(double time)
+{
+    mTimeBudget = time;
+}
+
 void CompositeMapRenderer::addCompositeMap(CompositeMap* compositeMap, bool immediate)
 {
     OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
@@ -197,6 +211,14 @@ void CompositeMapRenderer::setImmediate(CompositeMap* compositeMap)
     }
 }
 
+bool CompositeMapRenderer::isCompiled(CompositeMap* compositeMap) const
+{
+    OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
+    return mCompiling != compositeMap
+            && mCompileSet.find(compositeMap) == mCompileSet.end()
+            && mImmediateCompileSet.find(compositeMap) == mImmediateCompileSet.end();
+}
+
 unsigned int CompositeMapRenderer::getCompileSetSize() const
 {
     OpenThreads::ScopedLock<OpenThreads::Mutex> lock(mMutex);
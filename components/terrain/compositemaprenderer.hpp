@@ -55,17 +55,25 @@ namespace Terrain
         /// If current frame rate is higher than this, the extra time will be set aside to do more compiling
         void setTargetFrameRate(float framerate);
 
+        /// Set the maximum time in seconds spent compiling (non-immediate) composite maps each frame,
+        /// even if the frame rate is higher than the target frame rate
+        void setTimeBudget(double time);
+
         /// Add a composite map to be rendered
         void addCompositeMap(CompositeMap* map, bool immediate=false);
 
         /// Mark this composite map to be required for the current frame
         void setImmediate(CompositeMap* map);
 
+        /// Has this composite map been fully rendered, i.e. is it no longer queued or being compiled?
+        bool isCompiled(CompositeMap* map) const;
+
         unsigned int getCompileSetSize() const;
 
     private:
         float mTargetFrameRate;
         double mMinimumTimeAvailable;
+        double mTimeBudget;
         mutable osg::Timer mTimer;
 
         osg::ref_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
@@ -75,6 +83,7 @@ namespace Terrain
 
         mutable CompileSet mCompileSet;
         mutable CompileSet mImmediateCompileSet;
+        mutable CompositeMap* mCompiling;
 
         mutable OpenThreads::Mutex mMutex;
 
@@ -225,6 +225,7 @@ QuadTreeWorld::QuadTreeWorld(osg::Group *parent, osg::Group *compileRoot, Resour
     , mLodFactor(lodFactor)
     , mVertexLodMod(vertexLodMod)
     , mViewDistance(std::numeric_limits<float>::max())
+    , mBackgroundChunkCreation(false)
 {
     mChunkManager->setCompositeMapSize(compMapResolution);
     mChunkManager->setCompositeMapLevel(compMapLevel);
@@ -287,7 +288,8 @@ unsigned int getLodFlags(QuadTreeNode* node, int ourLod, int vertexLodMod, ViewD
     return lodFlags;
 }
 
-void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, int vertexLodMod, ChunkManager* chunkManager)
+/// @param async Only use a chunk if it is ready to be drawn, and otherwise leave mRenderingNode empty while it is created in the background
+void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, int vertexLodMod, ChunkManager* chunkManager, bool async)
 {
     if (!vd->hasChanged() && entry.mRenderingNode)
         return;
@@ -306,7 +308,86 @@ void loadRenderingNode(ViewData::Entry& entry, ViewData* vd, int vertexLodMod, C
     }
 
     if (!entry.mRenderingNode)
-        entry.mRenderingNode = chunkManager->getChunk(entry.mNode->getSize(), entry.mNode->getCenter(), ourLod, entry.mLodFlags);
+    {
+        if (async)
+            entry.mRenderingNode = chunkManager->requestChunk(entry.mNode->getSize(), entry.mNode->getCenter(), ourLod, entry.mLodFlags);
+        else
+            entry.mRenderingNode = chunkManager->getChunk(entry.mNode->getSize(), entry.mNode->getCenter(), ourLod, entry.mLodFlags);
+    }
+}
+
+bool isAncestorOrSelf(QuadTreeNode* ancestor, QuadTreeNode* node)
+{
+    for (; node; node = node->getParent())
+        if (node == ancestor)
+            return true;
+    return false;
+}
+
+/// Draw the chunks that are ready, and in place of the others what was drawn for the same area in the last frame
+void acceptWithPlaceholders(ViewData* vd, osg::NodeVisitor& nv, int vertexLodMod, ChunkManager* chunkManager)
+{
+    const ViewData::DrawnMap& lastDrawn = vd->getLastDrawn();
+    ViewData::DrawnMap drawn;
+    std::vector<ViewData::Entry*> ready;
+
+    for (unsigned int i=0; i<vd->getNumEntries(); ++i)
+    {
+        ViewData::Entry& entry = vd->getEntry(i);
+
+        loadRenderingNode(entry, vd, vertexLodMod, chunkManager, true);
+        if (entry.mRenderingNode)
+        {
+            ready.push_back(&entry);
+            continue;
+        }
+
+        // Prefer the same or a coarser chunk, which covers the whole area by itself
+        bool found = false;
+        for (QuadTreeNode* node = entry.mNode; node && !found; node = node->getParent())
+        {
+            ViewData::DrawnMap::const_iterator it = lastDrawn.find(node);
+            if (it != lastDrawn.end())
+            {
+                drawn.insert(*it);
+                found = true;
+            }
+        }
+
+        if (!found)
+        {
+            for (ViewData::DrawnMap::const_iterator it = lastDrawn.begin(); it != lastDrawn.end(); ++it)
+            {
+                if (isAncestorOrSelf(entry.mNode, it->first))
+                {
+                    drawn.insert(*it);
+                    found = true;
+                }
+            }
+        }
+
+        if (!found)
+        {
+            // Nothing to show in the meantime, e.g. after teleporting, so there is no way around waiting for the chunk
+            loadRenderingNode(entry, vd, vertexLodMod, chunkManager, false);
+            ready.push_back(&entry);
+        }
+    }
+
+    for (ViewData::Entry* entry : ready)
+    {
+        // Chunks within a coarser placeholder would overlap it, so they have to wait until all of their neighbours are ready
+        bool covered = false;
+        for (QuadTreeNode* node = entry->mNode->getParent(); node && !covered; node = node->getParent())
+            covered = drawn.find(node) != drawn.end();
+        if (!covered)
+            drawn[entry->mNode] = entry->mRenderingNode;
+    }
+
+    for (ViewData::DrawnMap::const_iterator it = drawn.begin(); it != drawn.end(); ++it)
+        it->second->accept(nv);
+
+    vd->setLastDrawn(drawn);
 }
 
 void QuadTreeWorld::accept(osg::NodeVisitor &nv)
@@ -377,13 +458,18 @@ void QuadTreeWorld::accept(osg::NodeVisitor &nv)
         }
     }
 
-    for (unsigned int i=0; i<vd->getNumEntries(); ++i)
+    if (isCullVisitor && mBackgroundChunkCreation)
+        acceptWithPlaceholders(vd, nv, mVertexLodMod, mChunkManager.get());
+    else
     {
-        ViewData::Entry& entry = vd->getEntry(i);
+        for (unsigned int i=0; i<vd->getNumEntries(); ++i)
+        {
+            ViewData::Entry& entry = vd->getEntry(i);
 
-        loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get());
+            loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get(), false);
 
-        entry.mRenderingNode->accept(nv);
+            entry.mRenderingNode->accept(nv);
+        }
     }
 
     if (!isCullVisitor)
@@ -438,7 +524,7 @@ void QuadTreeWorld::cacheCell(View *view, int x, int y)
     for (unsigned int i=0; i<vd->getNumEntries(); ++i)
     {
         ViewData::Entry& entry = vd->getEntry(i);
-        loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get());
+        loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get(), false);
     }
 }
 
@@ -458,7 +544,7 @@ void QuadTreeWorld::preload(View *view, const osg::Vec3f &viewPoint, std::atomic
     for (unsigned int i=0; i<vd->getNumEntries() && !abort; ++i)
     {
         ViewData::Entry& entry = vd->getEntry(i);
-        loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get());
+        loadRenderingNode(entry, vd, mVertexLodMod, mChunkManager.get(), false);
     }
     vd->markUnchanged();
 }
@@ -31,6 +31,10 @@ namespace Terrain
 
         virtual void setViewDistance(float distance) { mViewDistance = distance; }
 
+        /// Create chunks for the view in the background, drawing what was drawn for the same area in the meantime.
+        /// @note Requires a work queue to be set, see World::setWorkQueue().
+        void setBackgroundChunkCreation(bool enabled) { mBackgroundChunkCreation = enabled; }
+
         void cacheCell(View *view, int x, int y);
         /// @note Not thread safe.
         virtual void loadCell(int x, int y);
@@ -56,6 +60,7 @@ namespace Terrain
         float mLodFactor;
         int mVertexLodMod;
         float mViewDistance;
+        bool mBackgroundChunkCreation;
     };
 
 }
@@ -46,6 +46,8 @@ namespace Terrain
         virtual void compileGLObjects(osg::RenderInfo& renderInfo) const;
 
         void setCompositeMap(CompositeMap* map) { mCompositeMap = map; }
+        /// The composite map that still has to be finished before this drawable is first drawn, if any
+        CompositeMap* getCompositeMap() const { return mCompositeMap; }
         void setCompositeMapRenderer(CompositeMapRenderer* renderer) { mCompositeMapRenderer = renderer; }
 
     private:
@@ -24,6 +24,7 @@ void ViewData::copyFrom(const ViewData& other)
     mChanged = other.mChanged;
     mHasViewPoint = other.mHasViewPoint;
     mViewPoint = other.mViewPoint;
+    // mLastDrawn is kept, because it is what this view actually drew
 }
 
 void ViewData::add(QuadTreeNode *node)
@@ -88,6 +89,7 @@ void ViewData::clear()
     mLastUsageTimeStamp = 0;
     mChanged = false;
     mHasViewPoint = false;
+    mLastDrawn.clear();
 }
 
 bool ViewData::contains(QuadTreeNode *node)
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <deque>
+#include <map>
 
 #include <osg/Node>
 
@@ -52,6 +53,11 @@ namespace Terrain
         bool hasChanged() const;
         void markUnchanged() { mChanged = false; }
 
+        /// Chunks that were drawn for each node in the last frame, to be drawn in place of chunks that are not ready yet
+        typedef std::map<QuadTreeNode*, osg::ref_ptr<osg::Node> > DrawnMap;
+        const DrawnMap& getLastDrawn() const { return mLastDrawn; }
+        void setLastDrawn(DrawnMap& drawn) { mLastDrawn.swap(drawn); }
+
         bool hasViewPoint() const;
 
         void setViewPoint(const osg::Vec3f& viewPoint);
@@ -64,6 +70,7 @@ namespace Terrain
         bool mChanged;
         osg::Vec3f mViewPoint;
         bool mHasViewPoint;
+        DrawnMap mLastDrawn;
     };
 
     class ViewDataMap : public osg::Referenced
@@ -70,6 +70,7 @@ World::~World()
 void World::setWorkQueue(SceneUtil::WorkQueue* workQueue)
 {
     mCompositeMapRenderer->setWorkQueue(workQueue);
+    mChunkManager->setWorkQueue(workQueue);
 }
 
 void World::setBordersVisible(bool visible)
@@ -106,6 +107,11 @@ void World::setTargetFrameRate(float rate)
     mCompositeMapRenderer->setTargetFrameRate(rate);
 }
 
+void World::setCompositeMapTimeBudget(double time)
+{
+    mCompositeMapRenderer->setTimeBudget(time);
+}
+
 float World::getHeightAt(const osg::Vec3f &worldPos)
 {
     return mStorage->getHeightAt(worldPos);
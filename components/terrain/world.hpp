@@ -66,12 +66,15 @@ namespace Terrain
         World(osg::Group* parent, osg::Group* compileRoot, Resource::ResourceSystem* resourceSystem, Storage* storage);
         virtual ~World();
 
-        /// Set a WorkQueue to delete objects in the background thread.
+        /// Set a WorkQueue to delete objects and create chunks in the background thread.
         void setWorkQueue(SceneUtil::WorkQueue* workQueue);
 
         /// See CompositeMapRenderer::setTargetFrameRate
         void setTargetFrameRate(float rate);
 
+        /// See CompositeMapRenderer::setTimeBudget
+        void setCompositeMapTimeBudget(double time);
+
         /// Apply the scene manager's texture filtering settings to all cached textures.
         /// @note Thread safe.
         void updateTextureFiltering();
@@ -45,7 +45,8 @@
 using namespace ToUTF8;
 
 Utf8Encoder::Utf8Encoder(const FromType sourceEncoding):
-    mOutput(50*1024)
+    mOutput(50*1024),
+    mEncoding(sourceEncoding)
 {
     switch (sourceEncoding)
     {
@@ -14,6 +14,9 @@ namespace VFS
         virtual ~File() {}
 
         virtual Files::IStreamPtr open() = 0;
+
+        /// Do the expensive part of opening the file ahead of time, if there is any.
+        virtual void prefetch() {}
     };
 
     class Archive
@@ -23,6 +26,9 @@ namespace VFS
 
         /// List all resources contained in this archive, and run the resource names through the given normalize function.
         virtual void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) = 0;
+
+        /// Does File::prefetch() do anything for the files of this archive?
+        virtual bool canPrefetch() const { return false; }
     };
 
 }
@@ -10,7 +10,7 @@ BsaArchive::BsaArchive(const std::string &filename)
     Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(filename);
 
     if (bsaVersion == Bsa::BSAVER_COMPRESSED) {
-        mFile = std::make_unique<Bsa::CompressedBSAFile>(Bsa::CompressedBSAFile());
+        mFile = std::make_unique<Bsa::CompressedBSAFile>();
     }
     else {
         mFile = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
@@ -39,6 +39,12 @@ void BsaArchive::listResources(std::map<std::string, File *> &out, char (*normal
     }
 }
 
+bool BsaArchive::canPrefetch() const
+{
+    // Only compressed archives have files to decompress ahead of time
+    return dynamic_cast<const Bsa::CompressedBSAFile*>(mFile.get()) != nullptr;
+}
+
 // ------------------------------------------------------------------------------
 
 BsaArchiveFile::BsaArchiveFile(const Bsa::BSAFile::FileStruct *info, Bsa::BSAFile* bsa)
@@ -53,4 +59,9 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
+void BsaArchiveFile::prefetch()
+{
+    mFile->prefetch(mInfo);
+}
+
 }
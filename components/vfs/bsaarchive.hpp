@@ -13,6 +13,7 @@ namespace VFS
         BsaArchiveFile(const Bsa::BSAFile::FileStruct* info, Bsa::BSAFile* bsa);
 
         virtual Files::IStreamPtr open();
+        virtual void prefetch();
 
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::BSAFile* mFile;
@@ -24,6 +25,7 @@ namespace VFS
         BsaArchive(const std::string& filename);
         virtual ~BsaArchive();
         virtual void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char));
+        virtual bool canPrefetch() const;
 
     private:
         std::unique_ptr<Bsa::BSAFile> mFile;
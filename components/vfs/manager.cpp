@@ -30,8 +30,35 @@ namespace
 namespace VFS
 {
 
+    size_t Manager::NameHash::operator()(const std::string& name) const
+    {
+        // FNV-1a
+        size_t hash = 2166136261u;
+        for (char ch : name)
+        {
+            hash ^= static_cast<unsigned char>(mStrict ? strict_normalize_char(ch) : nonstrict_normalize_char(ch));
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    bool Manager::NameEqual::operator()(const std::string& left, const std::string& right) const
+    {
+        if (left.size() != right.size())
+            return false;
+
+        char (*normalize_char)(char) = mStrict ? &strict_normalize_char : &nonstrict_normalize_char;
+        for (size_t i = 0; i < left.size(); ++i)
+        {
+            if (normalize_char(left[i]) != normalize_char(right[i]))
+                return false;
+        }
+        return true;
+    }
+
     Manager::Manager(bool strict)
         : mStrict(strict)
+        , mLookup(0, NameHash{strict}, NameEqual{strict})
     {
 
     }
@@ -44,6 +71,7 @@ namespace VFS
     void Manager::reset()
     {
         mIndex.clear();
+        mLookup.clear();
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
@@ -60,30 +88,52 @@ namespace VFS
 
         for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        mLookup.clear();
+        mLookup.reserve(mIndex.size());
+        mLookup.insert(mIndex.begin(), mIndex.end());
     }
 
     Files::IStreamPtr Manager::get(const std::string &name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
-
-        return getNormalized(normalized);
+        std::unordered_map<std::string, File*, NameHash, NameEqual>::const_iterator found = mLookup.find(name);
+        if (found == mLookup.end())
+        {
+            std::string normalized = name;
+            normalize_path(normalized, mStrict);
+            throw std::runtime_error("Resource '" + normalized + "' not found");
+        }
+        return found->second->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
-            throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return get(normalizedName);
     }
 
-    bool Manager::exists(const std::string &name) const
+    void Manager::prefetch(const std::vector<std::string>& names) const
+    {
+        for (const std::string& name : names)
+        {
+            std::unordered_map<std::string, File*, NameHash, NameEqual>::const_iterator found = mLookup.find(name);
+            if (found != mLookup.end())
+                found->second->prefetch();
+        }
+    }
+
+    bool Manager::canPrefetch() const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        for (const Archive* archive : mArchives)
+        {
+            if (archive->canPrefetch())
+                return true;
+        }
+        return false;
+    }
 
-        return mIndex.find(normalized) != mIndex.end();
+    bool Manager::exists(const std::string &name) const
+    {
+        return mLookup.find(name) != mLookup.end();
     }
 
     const std::map<std::string, File*>& Manager::getIndex() const
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace VFS
 {
@@ -58,12 +59,38 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
 
+        /// Prepare the given files for being opened soon, e.g. by decompressing them. Files that don't exist are ignored.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(const std::vector<std::string>& names) const;
+
+        /// Is there any registered archive whose files prefetch() prepares?
+        /// @note May be called from any thread once the index has been built.
+        bool canPrefetch() const;
+
     private:
+        /// Hashes and compares names as if they had been normalized, so that lookups don't need to
+        /// normalize a copy of the name first.
+        struct NameHash
+        {
+            bool mStrict;
+            size_t operator()(const std::string& name) const;
+        };
+
+        struct NameEqual
+        {
+            bool mStrict;
+            bool operator()(const std::string& left, const std::string& right) const;
+        };
+
         bool mStrict;
 
         std::vector<Archive*> mArchives;
 
+        /// Sorted, for listing files by prefix
         std::map<std::string, File*> mIndex;
+
+        /// The same files as mIndex, for looking them up by name
+        std::unordered_map<std::string, File*, NameHash, NameEqual> mLookup;
     };
 
 }